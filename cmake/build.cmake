@@ -6,7 +6,7 @@ cmake_minimum_required(VERSION 3.10)
 # include order of related header files. See: /usr/include/EGL/eglplatform.h
 if(${BACKEND_TYPE} STREQUAL "DRM-GBM")
   add_definitions(-D__GBM__)
-elseif(${BACKEND_TYPE} STREQUAL "DRM-EGLSTREAM")
+elseif(${BACKEND_TYPE} MATCHES "^(DRM-EGLSTREAM|HEADLESS)$")
   add_definitions(-DEGL_NO_X11)
 elseif(${BACKEND_TYPE} STREQUAL "X11")
   add_definitions(-DUSE_X11)
@@ -20,7 +20,9 @@ if(${BACKEND_TYPE} STREQUAL "DRM-GBM")
   add_definitions(-DDISPLAY_BACKEND_TYPE_DRM_GBM)
   add_definitions(-DFLUTTER_TARGET_BACKEND_GBM)
   set(DISPLAY_BACKEND_SRC
+    "src/flutter/shell/platform/linux_embedded/window/drm_connector_utils.cc"
     "src/flutter/shell/platform/linux_embedded/window/native_window_drm.cc"
+    "src/flutter/shell/platform/linux_embedded/window/native_window_drm_dumb.cc"
     "src/flutter/shell/platform/linux_embedded/window/native_window_drm_gbm.cc")
 elseif(${BACKEND_TYPE} STREQUAL "DRM-EGLSTREAM")
   add_definitions(-DDISPLAY_BACKEND_TYPE_DRM_EGLSTREAM)
@@ -28,14 +30,26 @@ elseif(${BACKEND_TYPE} STREQUAL "DRM-EGLSTREAM")
   set(DISPLAY_BACKEND_SRC
     "src/flutter/shell/platform/linux_embedded/surface/context_egl_stream.cc"
     "src/flutter/shell/platform/linux_embedded/surface/environment_egl_stream.cc"
+    "src/flutter/shell/platform/linux_embedded/window/drm_connector_utils.cc"
     "src/flutter/shell/platform/linux_embedded/window/native_window_drm.cc"
+    "src/flutter/shell/platform/linux_embedded/window/native_window_drm_dumb.cc"
     "src/flutter/shell/platform/linux_embedded/window/native_window_drm_eglstream.cc")
 elseif(${BACKEND_TYPE} STREQUAL "X11")
   add_definitions(-DDISPLAY_BACKEND_TYPE_X11)
   add_definitions(-DFLUTTER_TARGET_BACKEND_X11)
   set(DISPLAY_BACKEND_SRC
     "src/flutter/shell/platform/linux_embedded/window/elinux_window_x11.cc"
-    "src/flutter/shell/platform/linux_embedded/window/native_window_x11.cc")
+    "src/flutter/shell/platform/linux_embedded/window/native_window_x11.cc"
+    "src/flutter/shell/platform/linux_embedded/window/native_window_x11_shm.cc"
+    "src/flutter/shell/platform/linux_embedded/window/x11_display.cc")
+elseif(${BACKEND_TYPE} STREQUAL "HEADLESS")
+  add_definitions(-DDISPLAY_BACKEND_TYPE_HEADLESS)
+  add_definitions(-DFLUTTER_TARGET_BACKEND_HEADLESS)
+  set(DISPLAY_BACKEND_SRC
+    "src/flutter/shell/platform/linux_embedded/surface/context_egl_headless.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/environment_egl_headless.cc"
+    "src/flutter/shell/platform/linux_embedded/window/elinux_window_headless.cc"
+    "src/flutter/shell/platform/linux_embedded/window/native_window_headless.cc")
 else()
   include(cmake/generate_wayland_protocols.cmake)
   pkg_get_variable(WAYLAND_PROTOCOLS_DATADIR wayland-protocols pkgdatadir)
@@ -68,6 +82,11 @@ else()
     CODE_FILE "${_wayland_protocols_src_dir}/xdg-decoration-unstable-v1-protocol.c"
     HEADER_FILE "${_wayland_protocols_src_dir}/xdg-decoration-unstable-v1-protocol.h")
 
+  generate_wayland_client_protocol(
+    PROTOCOL_FILE "${_wayland_protocols_xml_dir}/stable/viewporter/viewporter.xml"
+    CODE_FILE "${_wayland_protocols_src_dir}/viewporter-protocol.c"
+    HEADER_FILE "${_wayland_protocols_src_dir}/viewporter-client-protocol.h")
+
   add_definitions(-DFLUTTER_TARGET_BACKEND_WAYLAND)
   add_definitions(-DDISPLAY_BACKEND_TYPE_WAYLAND)
   set(DISPLAY_BACKEND_SRC
@@ -76,15 +95,72 @@ else()
     "${_wayland_protocols_src_dir}/text-input-unstable-v3-protocol.c"
     "${_wayland_protocols_src_dir}/presentation-time-protocol.c"
     "${_wayland_protocols_src_dir}/xdg-decoration-unstable-v1-protocol.c"
+    "${_wayland_protocols_src_dir}/viewporter-protocol.c"
     "src/flutter/shell/platform/linux_embedded/window/elinux_window_wayland.cc"
     "src/flutter/shell/platform/linux_embedded/window/native_window_wayland.cc"
     "src/flutter/shell/platform/linux_embedded/window/native_window_wayland_decoration.cc"
+    "src/flutter/shell/platform/linux_embedded/window/native_window_wayland_shm.cc"
     "src/flutter/shell/platform/linux_embedded/window/renderer/elinux_shader.cc"
     "src/flutter/shell/platform/linux_embedded/window/renderer/elinux_shader_context.cc"
     "src/flutter/shell/platform/linux_embedded/window/renderer/elinux_shader_program.cc"
     "src/flutter/shell/platform/linux_embedded/window/renderer/window_decoration_button.cc"
     "src/flutter/shell/platform/linux_embedded/window/renderer/window_decoration_titlebar.cc"
     "src/flutter/shell/platform/linux_embedded/window/renderer/window_decorations_wayland.cc")
+
+  # Allocate the surface buffers with GBM instead of the EGL Wayland platform.
+  if(USE_WAYLAND_DMABUF_SWAPCHAIN)
+    generate_wayland_client_protocol(
+      PROTOCOL_FILE "${_wayland_protocols_xml_dir}/unstable/linux-dmabuf/linux-dmabuf-unstable-v1.xml"
+      CODE_FILE "${_wayland_protocols_src_dir}/linux-dmabuf-unstable-v1-protocol.c"
+      HEADER_FILE "${_wayland_protocols_src_dir}/linux-dmabuf-unstable-v1-client-protocol.h")
+
+    add_definitions(-DUSE_WAYLAND_DMABUF_SWAPCHAIN)
+    list(APPEND DISPLAY_BACKEND_SRC
+      "${_wayland_protocols_src_dir}/linux-dmabuf-unstable-v1-protocol.c"
+      "src/flutter/shell/platform/linux_embedded/window/native_window_wayland_gbm.cc")
+  endif()
+
+  # Async presentation with tearing-control-v1 (wayland-protocols 1.30).
+  if(WAYLAND_PROTOCOLS_VERSION VERSION_GREATER_EQUAL 1.30)
+    generate_wayland_client_protocol(
+      PROTOCOL_FILE "${_wayland_protocols_xml_dir}/staging/tearing-control/tearing-control-v1.xml"
+      CODE_FILE "${_wayland_protocols_src_dir}/tearing-control-v1-protocol.c"
+      HEADER_FILE "${_wayland_protocols_src_dir}/tearing-control-v1-client-protocol.h")
+
+    add_definitions(-DUSE_WAYLAND_TEARING_CONTROL)
+    list(APPEND DISPLAY_BACKEND_SRC
+      "${_wayland_protocols_src_dir}/tearing-control-v1-protocol.c")
+  endif()
+
+  # Fractional scale factors with fractional-scale-v1 (wayland-protocols 1.31).
+  if(WAYLAND_PROTOCOLS_VERSION VERSION_GREATER_EQUAL 1.31)
+    generate_wayland_client_protocol(
+      PROTOCOL_FILE "${_wayland_protocols_xml_dir}/staging/fractional-scale/fractional-scale-v1.xml"
+      CODE_FILE "${_wayland_protocols_src_dir}/fractional-scale-v1-protocol.c"
+      HEADER_FILE "${_wayland_protocols_src_dir}/fractional-scale-v1-client-protocol.h")
+
+    add_definitions(-DUSE_WAYLAND_FRACTIONAL_SCALE)
+    list(APPEND DISPLAY_BACKEND_SRC
+      "${_wayland_protocols_src_dir}/fractional-scale-v1-protocol.c")
+  endif()
+
+  # Frame pacing with fifo-v1 and commit-timing-v1 (wayland-protocols 1.38).
+  if(WAYLAND_PROTOCOLS_VERSION VERSION_GREATER_EQUAL 1.38)
+    generate_wayland_client_protocol(
+      PROTOCOL_FILE "${_wayland_protocols_xml_dir}/staging/fifo/fifo-v1.xml"
+      CODE_FILE "${_wayland_protocols_src_dir}/fifo-v1-protocol.c"
+      HEADER_FILE "${_wayland_protocols_src_dir}/fifo-v1-client-protocol.h")
+
+    generate_wayland_client_protocol(
+      PROTOCOL_FILE "${_wayland_protocols_xml_dir}/staging/commit-timing/commit-timing-v1.xml"
+      CODE_FILE "${_wayland_protocols_src_dir}/commit-timing-v1-protocol.c"
+      HEADER_FILE "${_wayland_protocols_src_dir}/commit-timing-v1-client-protocol.h")
+
+    add_definitions(-DUSE_WAYLAND_FRAME_PACING_PROTOCOLS)
+    list(APPEND DISPLAY_BACKEND_SRC
+      "${_wayland_protocols_src_dir}/fifo-v1-protocol.c"
+      "${_wayland_protocols_src_dir}/commit-timing-v1-protocol.c")
+  endif()
 endif()
 
 # Use flutter dirty region management
@@ -97,6 +173,11 @@ if(USE_GLES3)
   add_definitions(-DUSE_GLES3)
 endif()
 
+# Keyboard layouts with xkbcommon, which is optional for the headless backend.
+if("${XKBCOMMON_FOUND}" STREQUAL "1")
+  add_definitions(-DUSE_XKBCOMMON)
+endif()
+
 # Flutter embedder runtime mode.
 if(FLUTTER_RELEASE)
   add_definitions(
@@ -118,6 +199,28 @@ if(ENABLE_VSYNC)
   )
 endif()
 
+# Vulkan renderer. The window surfaces depend on the display backend.
+if(ENABLE_VULKAN)
+  add_definitions(-DENABLE_VULKAN)
+  list(APPEND DISPLAY_BACKEND_SRC
+    "src/flutter/shell/platform/linux_embedded/surface/context_vulkan.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/surface_vulkan.cc")
+  if(${BACKEND_TYPE} MATCHES "^DRM-(GBM|EGLSTREAM)$")
+    list(APPEND DISPLAY_BACKEND_SRC
+      "src/flutter/shell/platform/linux_embedded/window/native_window_drm_vulkan.cc")
+  elseif(${BACKEND_TYPE} STREQUAL "X11")
+    # Declares the VK_KHR_xcb_surface APIs in vulkan.h.
+    add_definitions(-DVK_USE_PLATFORM_XCB_KHR)
+    list(APPEND DISPLAY_BACKEND_SRC
+      "src/flutter/shell/platform/linux_embedded/window/native_window_x11_vulkan.cc")
+  elseif(${BACKEND_TYPE} STREQUAL "WAYLAND")
+    # Declares the VK_KHR_wayland_surface APIs in vulkan.h.
+    add_definitions(-DVK_USE_PLATFORM_WAYLAND_KHR)
+    list(APPEND DISPLAY_BACKEND_SRC
+      "src/flutter/shell/platform/linux_embedded/window/native_window_wayland_vulkan.cc")
+  endif()
+endif()
+
 # Enable alpha component of the egl color buffer.
 if(ENABLE_EGL_ALPHA_COMPONENT_OF_COLOR_BUFFER)
   add_definitions(
@@ -139,10 +242,15 @@ set(CPP_WRAPPER_SOURCES_APP
 )
 
 set(ELINUX_COMMON_SRC
+  "src/flutter/shell/platform/linux_embedded/compositor_opengl.cc"
+  "src/flutter/shell/platform/linux_embedded/compositor_software.cc"
   "src/flutter/shell/platform/linux_embedded/flutter_elinux.cc"
   "src/flutter/shell/platform/linux_embedded/flutter_elinux_engine.cc"
   "src/flutter/shell/platform/linux_embedded/flutter_elinux_view.cc"
   "src/flutter/shell/platform/linux_embedded/flutter_project_bundle.cc"
+  "src/flutter/shell/platform/linux_embedded/file_utils.cc"
+  "src/flutter/shell/platform/linux_embedded/persistent_cache_manager.cc"
+  "src/flutter/shell/platform/linux_embedded/startup_prefetcher.cc"
   "src/flutter/shell/platform/linux_embedded/task_runner.cc"
   "src/flutter/shell/platform/linux_embedded/system_utils.cc"
   "src/flutter/shell/platform/linux_embedded/logger.cc"
@@ -160,11 +268,15 @@ set(ELINUX_COMMON_SRC
   "src/flutter/shell/platform/linux_embedded/plugins/settings_plugin.cc"
   "src/flutter/shell/platform/linux_embedded/plugins/text_input_plugin.cc"
   "src/flutter/shell/platform/linux_embedded/surface/context_egl.cc"
+  "src/flutter/shell/platform/linux_embedded/surface/damage_history.cc"
+  "src/flutter/shell/platform/linux_embedded/surface/egl_share_group.cc"
   "src/flutter/shell/platform/linux_embedded/surface/egl_utils.cc"
   "src/flutter/shell/platform/linux_embedded/surface/elinux_egl_surface.cc"
   "src/flutter/shell/platform/linux_embedded/surface/surface_base.cc"
   "src/flutter/shell/platform/linux_embedded/surface/surface_gl.cc"
   "src/flutter/shell/platform/linux_embedded/surface/surface_decoration.cc"
+  "src/flutter/shell/platform/linux_embedded/surface/surface_software.cc"
+  "src/flutter/shell/platform/common/utf_conversion.cc"
   "${DISPLAY_BACKEND_SRC}"
   ## The following file were copied from:
   ## https://github.com/flutter/engine/blob/master/shell/platform/glfw/
@@ -233,6 +345,7 @@ target_include_directories(${TARGET}
     ${LIBSYSTEMD_INCLUDE_DIRS}
     ${X11_INCLUDE_DIRS}
     ${LIBWESTON_INCLUDE_DIRS}
+    ${VULKAN_INCLUDE_DIRS}
     ## User libraries
     ${USER_APP_INCLUDE_DIRS}
 )
@@ -252,17 +365,14 @@ target_link_libraries(${TARGET}
     ${LIBUV_LIBRARIES}
     ${X11_LIBRARIES}
     ${LIBWESTON_LIBRARIES}
+    ${VULKAN_LIBRARIES}
     ${FLUTTER_EMBEDDER_LIB}
+    Threads::Threads
     ## User libraries
     ${USER_APP_LIBRARIES}
 )
 
 if(${BACKEND_TYPE} MATCHES "^DRM-(GBM|EGLSTREAM)$")
-  target_link_libraries(${TARGET}
-    PRIVATE
-      Threads::Threads
-  )
-
   # Indicate whether libsystemd must replace libuv
   if("${LIBSYSTEMD_FOUND}" STREQUAL "1")
     add_definitions(-DUSE_LIBSYSTEMD)
@@ -4,9 +4,16 @@ find_package(PkgConfig)
 
 # common libraries.
 pkg_check_modules(EGL REQUIRED egl)
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_package(Threads REQUIRED)
 
-# requires for supporting keyboard inputs.
-pkg_check_modules(XKBCOMMON REQUIRED xkbcommon)
+# requires for supporting keyboard inputs. The headless backend, which only
+# gets injected key events, can do without it.
+if(${BACKEND_TYPE} STREQUAL "HEADLESS")
+  pkg_check_modules(XKBCOMMON xkbcommon)
+else()
+  pkg_check_modules(XKBCOMMON REQUIRED xkbcommon)
+endif()
 
 # depends on backend type.
 if(${BACKEND_TYPE} MATCHES "^DRM-(GBM|EGLSTREAM)$")
@@ -19,8 +26,6 @@ if(${BACKEND_TYPE} MATCHES "^DRM-(GBM|EGLSTREAM)$")
   if(${BACKEND_TYPE} STREQUAL "DRM-GBM")
     pkg_check_modules(GBM REQUIRED gbm)
   endif()
-  set(THREADS_PREFER_PTHREAD_FLAG ON)
-  find_package(Threads REQUIRED)
   # Check if either systemd or libuv exist
   if((NOT "${LIBSYSTEMD_FOUND}" STREQUAL "1") AND (NOT "${LIBUV_FOUND}" STREQUAL "1"))
     message(FATAL_ERROR
@@ -30,13 +35,28 @@ if(${BACKEND_TYPE} MATCHES "^DRM-(GBM|EGLSTREAM)$")
     message("!! NOTICE: libsystemd found, libuv won't be used.")
   endif()
 elseif(${BACKEND_TYPE} STREQUAL "X11")
-  pkg_check_modules(X11 REQUIRED x11)
+  pkg_check_modules(X11 REQUIRED x11 x11-xcb xcb xcb-present xcb-shm)
+elseif(${BACKEND_TYPE} STREQUAL "HEADLESS")
+  # Headless backend needs no display libraries.
 else()
   # Wayland backend
   pkg_check_modules(WAYLAND_PROTOCOLS REQUIRED wayland-protocols)
   pkg_check_modules(WAYLAND_CLIENT REQUIRED wayland-client>=1.16.0)
   pkg_check_modules(WAYLAND_CURSOR REQUIRED wayland-cursor>=1.16.0)
   pkg_check_modules(WAYLAND_EGL REQUIRED wayland-egl>=1.16.0)
+  if(USE_WAYLAND_DMABUF_SWAPCHAIN)
+    # The swapchain needs the dmabuf feedback of linux-dmabuf version 4.
+    if(WAYLAND_PROTOCOLS_VERSION VERSION_LESS 1.24)
+      message(FATAL_ERROR "USE_WAYLAND_DMABUF_SWAPCHAIN requires wayland-protocols>=1.24")
+    endif()
+    pkg_check_modules(DRM REQUIRED libdrm>=2.4.108)
+    pkg_check_modules(GBM REQUIRED gbm>=21.3)
+  endif()
+endif()
+
+# Vulkan renderer.
+if(ENABLE_VULKAN)
+  pkg_check_modules(VULKAN REQUIRED vulkan)
 endif()
 
 # requires for supporting external texture plugin.
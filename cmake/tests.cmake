@@ -0,0 +1,76 @@
+cmake_minimum_required(VERSION 3.10)
+
+# The unit tests cover the logic which needs neither the Flutter engine nor a
+# display, so they run on any CI machine with ctest.
+find_package(GTest REQUIRED)
+include(GoogleTest)
+
+set(ELINUX_UNITTESTS_SRC
+  "src/flutter/shell/platform/common/utf_conversion_unittests.cc"
+  "src/flutter/shell/platform/linux_embedded/file_utils_unittests.cc"
+  "src/flutter/shell/platform/linux_embedded/persistent_cache_manager_unittests.cc"
+  "src/flutter/shell/platform/linux_embedded/startup_prefetcher_unittests.cc"
+  "src/flutter/shell/platform/linux_embedded/surface/damage_history_unittests.cc"
+  "src/flutter/shell/platform/linux_embedded/window/drm_connector_utils_unittests.cc"
+)
+
+# The sources under test.
+set(ELINUX_UNITTESTS_DEPS_SRC
+  "src/flutter/shell/platform/common/utf_conversion.cc"
+  "src/flutter/shell/platform/linux_embedded/file_utils.cc"
+  "src/flutter/shell/platform/linux_embedded/logger.cc"
+  "src/flutter/shell/platform/linux_embedded/persistent_cache_manager.cc"
+  "src/flutter/shell/platform/linux_embedded/startup_prefetcher.cc"
+  "src/flutter/shell/platform/linux_embedded/surface/damage_history.cc"
+  "src/flutter/shell/platform/linux_embedded/window/drm_connector_utils.cc"
+)
+
+# The headless backend renders without a display, so its window is tested with
+# the EGL of the CI machine, e.g. Mesa with llvmpipe.
+if(${BACKEND_TYPE} STREQUAL "HEADLESS")
+  list(APPEND ELINUX_UNITTESTS_SRC
+    "src/flutter/shell/platform/linux_embedded/window/elinux_window_headless_unittests.cc"
+  )
+  list(APPEND ELINUX_UNITTESTS_DEPS_SRC
+    ${DISPLAY_BACKEND_SRC}
+    "src/flutter/shell/platform/linux_embedded/surface/context_egl.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/egl_share_group.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/egl_utils.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/elinux_egl_surface.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/surface_base.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/surface_gl.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/surface_decoration.cc"
+    "src/flutter/shell/platform/linux_embedded/surface/surface_software.cc"
+  )
+  list(APPEND ELINUX_UNITTESTS_LIBS
+    ${EGL_LIBRARIES}
+    ${GLES_LIBRARIES}
+    ${VULKAN_LIBRARIES}
+  )
+endif()
+
+add_executable(flutter_elinux_unittests
+  ${ELINUX_UNITTESTS_SRC}
+  ${ELINUX_UNITTESTS_DEPS_SRC}
+)
+
+target_include_directories(flutter_elinux_unittests
+  PRIVATE
+    "src"
+    "src/flutter/shell/platform/common/public"
+    "src/flutter/shell/platform/linux_embedded/public"
+    ${RAPIDJSON_INCLUDE_DIRS}
+    ${EGL_INCLUDE_DIRS}
+    ${GLES_INCLUDE_DIRS}
+    ${VULKAN_INCLUDE_DIRS}
+)
+
+target_link_libraries(flutter_elinux_unittests
+  PRIVATE
+    GTest::GTest
+    GTest::Main
+    Threads::Threads
+    ${ELINUX_UNITTESTS_LIBS}
+)
+
+gtest_discover_tests(flutter_elinux_unittests)
@@ -4,6 +4,8 @@
 
 #include "flutter_window.h"
 
+#include <poll.h>
+
 #include <chrono>
 #include <cmath>
 #include <iostream>
@@ -49,8 +51,18 @@ void FlutterWindow::Run() {
           std::max(std::chrono::nanoseconds(0),
                    next_flutter_event_time -
                        std::chrono::steady_clock::time_point::clock::now());
-      std::this_thread::sleep_for(
-          std::chrono::duration_cast<std::chrono::milliseconds>(wait_duration));
+      auto wait_duration_ms =
+          std::chrono::duration_cast<std::chrono::milliseconds>(wait_duration);
+      // Wake up as soon as the window has events, e.g. the vsync on X11.
+      // Events already read from the fd don't make it readable again.
+      pollfd fd = {flutter_view_controller_->view()->GetEventFd(), POLLIN, 0};
+      if (fd.fd != -1) {
+        if (!flutter_view_controller_->view()->HasPendingEvents()) {
+          poll(&fd, 1, wait_duration_ms.count());
+        }
+      } else {
+        std::this_thread::sleep_for(wait_duration_ms);
+      }
     }
 
     // Processes any pending events in the Flutter engine, and returns the
@@ -40,6 +40,13 @@ int main(int argc, char** argv) {
   view_properties.force_scale_factor = options.IsForceScaleFactor();
   view_properties.scale_factor = options.ScaleFactor();
   view_properties.enable_vsync = options.EnableVsync();
+  view_properties.opaque = options.IsOpaque();
+  view_properties.enable_low_latency = options.EnableLowLatency();
+  view_properties.color_format = options.ColorFormat();
+  view_properties.depth_size = options.DepthSize();
+  view_properties.stencil_size = options.StencilSize();
+  view_properties.sample_count = options.SampleCount();
+  view_properties.renderer_type = options.RendererType();
 
   // The Flutter instance hosted by this window.
   FlutterWindow window(view_properties, project);
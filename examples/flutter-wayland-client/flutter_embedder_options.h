@@ -32,6 +32,20 @@ class FlutterEmbedderOptions {
     options_.AddWithoutValue(
         "async-vblank", "v",
         "Don't sync to compositor redraw/vblank (eglSwapInterval 0)", false);
+    options_.AddString("color-format", "c",
+                       "Color buffer format [default|rgb565|xrgb8888|argb8888|"
+                       "xrgb2101010|argb2101010]",
+                       "default", false);
+    options_.AddInt("depth-size", "z", "Minimum bits of the depth buffer", 0,
+                    false);
+    options_.AddInt("stencil-size", "e", "Minimum bits of the stencil buffer",
+                    0, false);
+    options_.AddInt("msaa-samples", "m",
+                    "Samples per pixel for MSAA [0(default)|1(off)|2|4|...]", 0,
+                    false);
+    options_.AddString("renderer", "g",
+                       "Renderer [opengl(default)|software|vulkan]", "opengl",
+                       false);
 
 #if defined(FLUTTER_TARGET_BACKEND_GBM) || \
     defined(FLUTTER_TARGET_BACKEND_EGLSTREAM)
@@ -42,6 +56,11 @@ class FlutterEmbedderOptions {
                              false);
     options_.AddInt("width", "w", "Window width", 1280, false);
     options_.AddInt("height", "h", "Window height", 720, false);
+#elif defined(FLUTTER_TARGET_BACKEND_HEADLESS)
+    options_.AddWithoutValue("fullscreen", "f", "Always full-screen display",
+                             false);
+    options_.AddInt("width", "w", "Window width", 1280, false);
+    options_.AddInt("height", "h", "Window height", 720, false);
 #else  // FLUTTER_TARGET_BACKEND_WAYLAND
     options_.AddString("title", "t", "Window title", "Flutter", false);
     options_.AddString("app-id", "a", "XDG App ID", "dev.flutter.elinux",
@@ -50,6 +69,13 @@ class FlutterEmbedderOptions {
                              "Enable on-screen keyboard", false);
     options_.AddWithoutValue("window-decoration", "d",
                              "Enable window decorations", false);
+    options_.AddWithoutValue(
+        "opaque", "o",
+        "Declare the window opaque (no alpha in the color buffer)", false);
+    options_.AddWithoutValue(
+        "low-latency", "l",
+        "Present frames without waiting for v-blank in full-screen (tearing)",
+        false);
     options_.AddWithoutValue("fullscreen", "f", "Always full-screen display",
                              false);
     options_.AddInt("width", "w", "Window width", 1280, false);
@@ -101,6 +127,50 @@ class FlutterEmbedderOptions {
 
     enable_vsync_ = !options_.Exist("async-vblank");
 
+    const auto color_format = options_.GetValue<std::string>("color-format");
+    if (color_format == "rgb565") {
+      color_format_ =
+          flutter::FlutterViewController::ColorFormat::kColorFormatRGB565;
+    } else if (color_format == "xrgb8888") {
+      color_format_ =
+          flutter::FlutterViewController::ColorFormat::kColorFormatXRGB8888;
+    } else if (color_format == "argb8888") {
+      color_format_ =
+          flutter::FlutterViewController::ColorFormat::kColorFormatARGB8888;
+    } else if (color_format == "xrgb2101010") {
+      color_format_ =
+          flutter::FlutterViewController::ColorFormat::kColorFormatXRGB2101010;
+    } else if (color_format == "argb2101010") {
+      color_format_ =
+          flutter::FlutterViewController::ColorFormat::kColorFormatARGB2101010;
+    } else if (color_format == "default") {
+      color_format_ =
+          flutter::FlutterViewController::ColorFormat::kColorFormatDefault;
+    } else {
+      std::cerr << "Unknown color format: " << color_format << std::endl;
+      std::cout << options_.ShowHelp();
+      return false;
+    }
+    depth_size_ = options_.GetValue<int>("depth-size");
+    stencil_size_ = options_.GetValue<int>("stencil-size");
+    sample_count_ = options_.GetValue<int>("msaa-samples");
+
+    const auto renderer = options_.GetValue<std::string>("renderer");
+    if (renderer == "software") {
+      renderer_type_ =
+          flutter::FlutterViewController::RendererType::kRendererSoftware;
+    } else if (renderer == "vulkan") {
+      renderer_type_ =
+          flutter::FlutterViewController::RendererType::kRendererVulkan;
+    } else if (renderer == "opengl") {
+      renderer_type_ =
+          flutter::FlutterViewController::RendererType::kRendererOpenGL;
+    } else {
+      std::cerr << "Unknown renderer: " << renderer << std::endl;
+      std::cout << options_.ShowHelp();
+      return false;
+    }
+
 #if defined(FLUTTER_TARGET_BACKEND_GBM) || \
     defined(FLUTTER_TARGET_BACKEND_EGLSTREAM)
     use_onscreen_keyboard_ = false;
@@ -116,11 +186,22 @@ class FlutterEmbedderOptions {
             : flutter::FlutterViewController::ViewMode::kNormal;
     window_width_ = options_.GetValue<int>("width");
     window_height_ = options_.GetValue<int>("height");
+#elif defined(FLUTTER_TARGET_BACKEND_HEADLESS)
+    use_onscreen_keyboard_ = false;
+    use_window_decoration_ = false;
+    window_view_mode_ =
+        options_.Exist("fullscreen")
+            ? flutter::FlutterViewController::ViewMode::kFullscreen
+            : flutter::FlutterViewController::ViewMode::kNormal;
+    window_width_ = options_.GetValue<int>("width");
+    window_height_ = options_.GetValue<int>("height");
 #else  // FLUTTER_TARGET_BACKEND_WAYLAND
     window_title_ = options_.GetValue<std::string>("title");
     window_app_id_ = options_.GetValue<std::string>("app-id");
     use_onscreen_keyboard_ = options_.Exist("onscreen-keyboard");
     use_window_decoration_ = options_.Exist("window-decoration");
+    opaque_ = options_.Exist("opaque");
+    enable_low_latency_ = options_.Exist("low-latency");
     window_view_mode_ =
         options_.Exist("fullscreen")
             ? flutter::FlutterViewController::ViewMode::kFullscreen
@@ -177,6 +258,27 @@ class FlutterEmbedderOptions {
   bool EnableVsync() const {
     return enable_vsync_;
   }
+  bool IsOpaque() const {
+    return opaque_;
+  }
+  bool EnableLowLatency() const {
+    return enable_low_latency_;
+  }
+  flutter::FlutterViewController::ColorFormat ColorFormat() const {
+    return color_format_;
+  }
+  int DepthSize() const {
+    return depth_size_;
+  }
+  int StencilSize() const {
+    return stencil_size_;
+  }
+  int SampleCount() const {
+    return sample_count_;
+  }
+  flutter::FlutterViewController::RendererType RendererType() const {
+    return renderer_type_;
+  }
 
  private:
   commandline::CommandOptions options_;
@@ -198,6 +300,15 @@ class FlutterEmbedderOptions {
   double text_scale_factor_;
   bool enable_high_contrast_;
   bool enable_vsync_;
+  bool opaque_ = false;
+  bool enable_low_latency_ = false;
+  flutter::FlutterViewController::ColorFormat color_format_ =
+      flutter::FlutterViewController::ColorFormat::kColorFormatDefault;
+  int depth_size_ = 0;
+  int stencil_size_ = 0;
+  int sample_count_ = 0;
+  flutter::FlutterViewController::RendererType renderer_type_ =
+      flutter::FlutterViewController::RendererType::kRendererOpenGL;
 };
 
 #endif  // FLUTTER_EMBEDDER_OPTIONS_
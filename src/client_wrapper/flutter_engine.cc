@@ -29,6 +29,26 @@ FlutterEngine::FlutterEngine(const DartProject& project) {
       static_cast<int>(entrypoint_argv.size());
   c_engine_properties.dart_entrypoint_argv =
       entrypoint_argv.size() > 0 ? entrypoint_argv.data() : nullptr;
+  c_engine_properties.enable_multi_view = project.multi_view_enabled();
+  c_engine_properties.enable_startup_prefetch =
+      project.startup_prefetch_enabled();
+  c_engine_properties.prefetch_assets_list_path =
+      project.prefetch_assets_list_path().empty()
+          ? nullptr
+          : project.prefetch_assets_list_path().c_str();
+  c_engine_properties.enable_aot_huge_pages = project.aot_huge_pages_enabled();
+  c_engine_properties.persistent_cache_path =
+      project.persistent_cache_path().empty()
+          ? nullptr
+          : project.persistent_cache_path().c_str();
+  c_engine_properties.persistent_cache_seed_path =
+      project.persistent_cache_seed_path().empty()
+          ? nullptr
+          : project.persistent_cache_seed_path().c_str();
+  c_engine_properties.persistent_cache_max_size =
+      project.persistent_cache_max_size();
+  c_engine_properties.is_persistent_cache_read_only =
+      project.persistent_cache_read_only();
 
   engine_ = FlutterDesktopEngineCreate(&c_engine_properties);
 
@@ -72,6 +92,25 @@ void FlutterEngine::ReloadSystemFonts() {
   FlutterDesktopEngineReloadSystemFonts(engine_);
 }
 
+std::chrono::nanoseconds FlutterEngine::GetStartupPhaseTime(
+    FlutterDesktopStartupPhase phase) {
+  return std::chrono::nanoseconds(
+      FlutterDesktopEngineGetStartupPhaseTime(engine_, phase));
+}
+
+void FlutterEngine::SetFirstFrameCallback(std::function<void()> callback) {
+  first_frame_callback_ = std::move(callback);
+  FlutterDesktopEngineSetFirstFrameCallback(
+      engine_,
+      [](void* user_data) {
+        auto* self = static_cast<FlutterEngine*>(user_data);
+        if (self->first_frame_callback_) {
+          self->first_frame_callback_();
+        }
+      },
+      this);
+}
+
 FlutterDesktopPluginRegistrarRef FlutterEngine::GetRegistrarForPlugin(
     const std::string& plugin_name) {
   if (!engine_) {
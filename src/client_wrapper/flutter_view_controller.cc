@@ -9,43 +9,63 @@
 
 namespace flutter {
 
-FlutterViewController::FlutterViewController(
-    const ViewProperties& view_properties,
-    const DartProject& project) {
-  engine_ = std::make_unique<FlutterEngine>(project);
+namespace {
+
+using ViewProperties = FlutterViewController::ViewProperties;
+using ViewMode = FlutterViewController::ViewMode;
+using ViewRotation = FlutterViewController::ViewRotation;
 
-  FlutterDesktopViewProperties c_view_properties = {};
-  c_view_properties.width = view_properties.width;
-  c_view_properties.height = view_properties.height;
-  c_view_properties.view_rotation =
-      (view_properties.view_rotation == ViewRotation::kRotation_90)
+// Converts |properties| to the properties of the C API.
+FlutterDesktopViewProperties ConvertViewProperties(
+    const ViewProperties& properties) {
+  FlutterDesktopViewProperties c_properties = {};
+  c_properties.width = properties.width;
+  c_properties.height = properties.height;
+  c_properties.view_rotation =
+      (properties.view_rotation == ViewRotation::kRotation_90)
           ? FlutterDesktopViewRotation::kRotation_90
-      : (view_properties.view_rotation == ViewRotation::kRotation_180)
+      : (properties.view_rotation == ViewRotation::kRotation_180)
           ? FlutterDesktopViewRotation::kRotation_180
-      : (view_properties.view_rotation == ViewRotation::kRotation_270)
+      : (properties.view_rotation == ViewRotation::kRotation_270)
           ? FlutterDesktopViewRotation::kRotation_270
           : FlutterDesktopViewRotation::kRotation_0;
-  c_view_properties.view_mode =
-      (view_properties.view_mode == ViewMode::kFullscreen)
-          ? FlutterDesktopViewMode::kFullscreen
-          : FlutterDesktopViewMode::kNormalscreen;
-  c_view_properties.title = view_properties.title.has_value()
-                                ? (*view_properties.title).c_str()
-                                : nullptr;
-  c_view_properties.app_id = view_properties.app_id.has_value()
-                                 ? (*view_properties.app_id).c_str()
-                                 : nullptr;
-  c_view_properties.use_mouse_cursor = view_properties.use_mouse_cursor;
-  c_view_properties.use_onscreen_keyboard =
-      view_properties.use_onscreen_keyboard;
-  c_view_properties.use_window_decoration =
-      view_properties.use_window_decoration;
-  c_view_properties.text_scale_factor = view_properties.text_scale_factor;
-  c_view_properties.enable_high_contrast = view_properties.enable_high_contrast;
-  c_view_properties.force_scale_factor = view_properties.force_scale_factor;
-  c_view_properties.scale_factor = view_properties.scale_factor;
-  c_view_properties.enable_vsync = view_properties.enable_vsync;
+  c_properties.view_mode = (properties.view_mode == ViewMode::kFullscreen)
+                               ? FlutterDesktopViewMode::kFullscreen
+                               : FlutterDesktopViewMode::kNormalscreen;
+  c_properties.title =
+      properties.title.has_value() ? (*properties.title).c_str() : nullptr;
+  c_properties.app_id =
+      properties.app_id.has_value() ? (*properties.app_id).c_str() : nullptr;
+  c_properties.use_mouse_cursor = properties.use_mouse_cursor;
+  c_properties.use_onscreen_keyboard = properties.use_onscreen_keyboard;
+  c_properties.use_window_decoration = properties.use_window_decoration;
+  c_properties.text_scale_factor = properties.text_scale_factor;
+  c_properties.enable_high_contrast = properties.enable_high_contrast;
+  c_properties.force_scale_factor = properties.force_scale_factor;
+  c_properties.scale_factor = properties.scale_factor;
+  c_properties.enable_vsync = properties.enable_vsync;
+  c_properties.opaque = properties.opaque;
+  c_properties.enable_low_latency = properties.enable_low_latency;
+  // ColorFormat has the same values as FlutterDesktopColorFormat.
+  c_properties.color_format =
+      static_cast<FlutterDesktopColorFormat>(properties.color_format);
+  c_properties.depth_size = properties.depth_size;
+  c_properties.stencil_size = properties.stencil_size;
+  c_properties.sample_count = properties.sample_count;
+  // RendererType has the same values as FlutterDesktopRendererType.
+  c_properties.renderer_type =
+      static_cast<FlutterDesktopRendererType>(properties.renderer_type);
+  return c_properties;
+}
+
+}  // namespace
+
+FlutterViewController::FlutterViewController(
+    const ViewProperties& view_properties,
+    const DartProject& project) {
+  engine_ = std::make_unique<FlutterEngine>(project);
 
+  auto c_view_properties = ConvertViewProperties(view_properties);
   controller_ = FlutterDesktopViewControllerCreate(&c_view_properties,
                                                    engine_->RelinquishEngine());
   if (!controller_) {
@@ -57,6 +77,22 @@ FlutterViewController::FlutterViewController(
       FlutterDesktopViewControllerGetView(controller_));
 }
 
+FlutterViewController::FlutterViewController(
+    const ViewProperties& view_properties,
+    FlutterEngine* engine)
+    : shared_engine_(engine) {
+  auto c_view_properties = ConvertViewProperties(view_properties);
+  controller_ = FlutterDesktopEngineCreateViewController(engine->engine_,
+                                                         &c_view_properties);
+  if (!controller_) {
+    std::cerr << "Failed to create view controller." << std::endl;
+    return;
+  }
+
+  view_ = std::make_unique<FlutterView>(
+      FlutterDesktopViewControllerGetView(controller_));
+}
+
 FlutterViewController::~FlutterViewController() {
   if (controller_) {
     FlutterDesktopViewControllerDestroy(controller_);
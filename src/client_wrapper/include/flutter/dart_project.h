@@ -5,6 +5,7 @@
 #ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_CLIENT_WRAPPER_INCLUDE_FLUTTER_DART_PROJECT_H_
 #define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_CLIENT_WRAPPER_INCLUDE_FLUTTER_DART_PROJECT_H_
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,48 @@ class DartProject {
     return dart_entrypoint_arguments_;
   }
 
+  // Enables additional views of the engine, which are created by
+  // FlutterViewController with the engine of the first view.
+  void set_multi_view_enabled(bool enabled) { multi_view_enabled_ = enabled; }
+
+  // Enables prefetching the files read at startup into the page cache.
+  void set_startup_prefetch_enabled(bool enabled) {
+    startup_prefetch_enabled_ = enabled;
+  }
+
+  // Sets the path to the file recording the assets to prefetch at startup.
+  // See FlutterDesktopEngineProperties::prefetch_assets_list_path.
+  void set_prefetch_assets_list_path(const std::wstring& path) {
+    prefetch_assets_list_path_ = path;
+  }
+
+  // Enables backing the code of the AOT library with huge pages.
+  void set_aot_huge_pages_enabled(bool enabled) {
+    aot_huge_pages_enabled_ = enabled;
+  }
+
+  // Sets the directory the engine persists its compiled shaders in across
+  // runs. See FlutterDesktopEngineProperties::persistent_cache_path.
+  void set_persistent_cache_path(const std::wstring& path) {
+    persistent_cache_path_ = path;
+  }
+
+  // Sets the shader cache bundled with the app, which seeds the persistent
+  // cache. See FlutterDesktopEngineProperties::persistent_cache_seed_path.
+  void set_persistent_cache_seed_path(const std::wstring& path) {
+    persistent_cache_seed_path_ = path;
+  }
+
+  // Sets the size limit of the persistent cache in bytes, or 0 for no limit.
+  void set_persistent_cache_max_size(size_t max_size) {
+    persistent_cache_max_size_ = max_size;
+  }
+
+  // Prevents the engine from writing new shaders into the persistent cache.
+  void set_persistent_cache_read_only(bool read_only) {
+    persistent_cache_read_only_ = read_only;
+  }
+
  private:
   // Accessors for internals are private, so that they can be changed if more
   // flexible options for project structures are needed later without it
@@ -53,6 +96,24 @@ class DartProject {
   const std::wstring& assets_path() const { return assets_path_; }
   const std::wstring& icu_data_path() const { return icu_data_path_; }
   const std::wstring& aot_library_path() const { return aot_library_path_; }
+  bool multi_view_enabled() const { return multi_view_enabled_; }
+  bool startup_prefetch_enabled() const { return startup_prefetch_enabled_; }
+  const std::wstring& prefetch_assets_list_path() const {
+    return prefetch_assets_list_path_;
+  }
+  bool aot_huge_pages_enabled() const { return aot_huge_pages_enabled_; }
+  const std::wstring& persistent_cache_path() const {
+    return persistent_cache_path_;
+  }
+  const std::wstring& persistent_cache_seed_path() const {
+    return persistent_cache_seed_path_;
+  }
+  size_t persistent_cache_max_size() const {
+    return persistent_cache_max_size_;
+  }
+  bool persistent_cache_read_only() const {
+    return persistent_cache_read_only_;
+  }
 
   // The path to the assets directory.
   std::wstring assets_path_;
@@ -63,6 +124,22 @@ class DartProject {
   std::wstring aot_library_path_;
   // The list of arguments to pass through to the Dart entrypoint.
   std::vector<std::string> dart_entrypoint_arguments_;
+  // Whether the engine can have additional views.
+  bool multi_view_enabled_ = false;
+  // Whether the files read at startup are prefetched.
+  bool startup_prefetch_enabled_ = false;
+  // The path to the list of the assets to prefetch.
+  std::wstring prefetch_assets_list_path_;
+  // Whether the AOT code is backed with huge pages.
+  bool aot_huge_pages_enabled_ = false;
+  // The directory of the persistent shader cache.
+  std::wstring persistent_cache_path_;
+  // The bundled shader cache seeding the persistent cache.
+  std::wstring persistent_cache_seed_path_;
+  // The size limit of the persistent cache, or 0 for no limit.
+  size_t persistent_cache_max_size_ = 0;
+  // Whether the engine only reads the persistent cache.
+  bool persistent_cache_read_only_ = false;
 };
 
 }  // namespace flutter
@@ -8,6 +8,7 @@
 #include <flutter_elinux.h>
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -58,6 +59,14 @@ class FlutterEngine : public PluginRegistry {
   // Win32 application).
   void ReloadSystemFonts();
 
+  // Returns the time when the engine reached |phase| on the monotonic clock,
+  // or zero if it hasn't been reached yet.
+  std::chrono::nanoseconds GetStartupPhaseTime(
+      FlutterDesktopStartupPhase phase);
+
+  // Sets |callback| to be called once the first frame has been presented.
+  void SetFirstFrameCallback(std::function<void()> callback);
+
   // flutter::PluginRegistry:
   FlutterDesktopPluginRegistrarRef GetRegistrarForPlugin(
       const std::string& plugin_name) override;
@@ -69,7 +78,7 @@ class FlutterEngine : public PluginRegistry {
   BinaryMessenger* messenger() { return messenger_.get(); }
 
  private:
-  // For access to RelinquishEngine.
+  // For access to RelinquishEngine and engine_.
   friend class FlutterViewController;
 
   // Gives up ownership of |engine_|, but keeps a weak reference to it.
@@ -87,6 +96,9 @@ class FlutterEngine : public PluginRegistry {
   // Whether or not this wrapper owns |engine_|.
   bool owns_engine_ = true;
 
+  // The callback passed to SetFirstFrameCallback.
+  std::function<void()> first_frame_callback_;
+
   // Whether the engine has been run. This will be true if Run has been called,
   // or if RelinquishEngine has been called (since the view controller will
   // run the engine if it hasn't already been run).
@@ -24,9 +24,53 @@ class FlutterView {
   // you have to call this every time in the main loop.
   bool DispatchEvent() { return FlutterDesktopViewDispatchEvent(view_); }
 
+  // Returns a file descriptor which becomes readable when there are events to
+  // be dispatched, or -1 if not supported by the backend.
+  int GetEventFd() { return FlutterDesktopViewGetEventFd(view_); }
+
+  // Returns true if there are events to be dispatched which don't make the
+  // file descriptor of GetEventFd() readable. Check it before polling.
+  bool HasPendingEvents() { return FlutterDesktopViewHasPendingEvents(view_); }
+
   // Returns the display frame rate.
   int32_t GetFrameRate() { return FlutterDesktopViewGetFrameRate(view_); }
 
+  // Injects input events as if they came from the display backend, e.g. to
+  // drive the HEADLESS backend in automated tests. The coordinates are in
+  // physical pixels. See flutter_elinux.h for the details.
+  void InjectPointerMove(double x, double y) {
+    FlutterDesktopViewInjectPointerMove(view_, x, y);
+  }
+
+  void InjectPointerButton(double x,
+                           double y,
+                           FlutterDesktopPointerButton button,
+                           bool pressed) {
+    FlutterDesktopViewInjectPointerButton(view_, x, y, button, pressed);
+  }
+
+  void InjectPointerLeave() { FlutterDesktopViewInjectPointerLeave(view_); }
+
+  void InjectScroll(double x, double y, double delta_x, double delta_y) {
+    FlutterDesktopViewInjectScroll(view_, x, y, delta_x, delta_y);
+  }
+
+  void InjectTouchDown(uint32_t time, int32_t id, double x, double y) {
+    FlutterDesktopViewInjectTouchDown(view_, time, id, x, y);
+  }
+
+  void InjectTouchMotion(uint32_t time, int32_t id, double x, double y) {
+    FlutterDesktopViewInjectTouchMotion(view_, time, id, x, y);
+  }
+
+  void InjectTouchUp(uint32_t time, int32_t id) {
+    FlutterDesktopViewInjectTouchUp(view_, time, id);
+  }
+
+  void InjectKey(uint32_t keycode, bool pressed) {
+    FlutterDesktopViewInjectKey(view_, keycode, pressed);
+  }
+
  private:
   // Handle for interacting with the C API's view.
   FlutterDesktopViewRef view_ = nullptr;
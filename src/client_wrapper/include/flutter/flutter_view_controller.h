@@ -44,6 +44,30 @@ class FlutterViewController {
     kRotation_270 = 3,
   };
 
+  enum ColorFormat {
+    // 8-bit RGB. The alpha component depends on the build option and `opaque`.
+    kColorFormatDefault = 0,
+    // 16 bits per pixel without alpha.
+    kColorFormatRGB565 = 1,
+    // 8-bit RGB without alpha.
+    kColorFormatXRGB8888 = 2,
+    // 8-bit RGB with 8-bit alpha.
+    kColorFormatARGB8888 = 3,
+    // 10-bit RGB without alpha.
+    kColorFormatXRGB2101010 = 4,
+    // 10-bit RGB with 2-bit alpha.
+    kColorFormatARGB2101010 = 5,
+  };
+
+  enum RendererType {
+    // Renders with OpenGL ES through EGL.
+    kRendererOpenGL = 0,
+    // Renders on the CPU. For devices without a usable GPU.
+    kRendererSoftware = 1,
+    // Renders with Vulkan. Falls back to OpenGL ES if not available.
+    kRendererVulkan = 2,
+  };
+
   // Properties for configuring a Flutter view instance.
   typedef struct {
     // View width.
@@ -90,6 +114,27 @@ class FlutterViewController {
     // True:  Sync to compositor redraw/v-blank  (eglSwapInterval 1)
     // False: Do not sync to compositor redraw/v-blank (eglSwapInterval 0)
     bool enable_vsync;
+
+    // Declares that the view has no transparent pixels.
+    // This option is only active for Wayland backend.
+    bool opaque;
+
+    // Enable low-latency mode, allowing tearing.
+    // This option is only active for Wayland backend in kFullscreen mode.
+    bool enable_low_latency;
+
+    // Color buffer format.
+    ColorFormat color_format;
+
+    // Minimum bits of the depth and the stencil buffers.
+    int32_t depth_size;
+    int32_t stencil_size;
+
+    // Number of samples per pixel for MSAA. 0 uses the renderer's default.
+    int32_t sample_count;
+
+    // Renderer of the view.
+    RendererType renderer_type;
   } ViewProperties;
 
   // Creates a FlutterView that can be parented into a Windows View hierarchy
@@ -99,6 +144,13 @@ class FlutterViewController {
   explicit FlutterViewController(const ViewProperties& view_properties,
                                  const DartProject& project);
 
+  // Creates an additional view of |engine|, which is owned by the controller
+  // of the first view. The project of the engine must have multiple views
+  // enabled, and this must be destroyed before the controller of the first
+  // view. See FlutterDesktopEngineCreateViewController for the details.
+  explicit FlutterViewController(const ViewProperties& view_properties,
+                                 FlutterEngine* engine);
+
   virtual ~FlutterViewController();
 
   // Prevent copying.
@@ -106,11 +158,16 @@ class FlutterViewController {
   FlutterViewController& operator=(FlutterViewController const&) = delete;
 
   // Returns the engine running Flutter content in this view.
-  FlutterEngine* engine() { return engine_.get(); }
+  FlutterEngine* engine() { return engine_ ? engine_.get() : shared_engine_; }
 
   // Returns the view managed by this controller.
   FlutterView* view() { return view_.get(); }
 
+  // Returns the ID of the view managed by this controller.
+  FlutterDesktopViewId view_id() const {
+    return FlutterDesktopViewControllerGetViewId(controller_);
+  }
+
  private:
   // Handle for interacting with the C API's view controller, if any.
   FlutterDesktopViewControllerRef controller_ = nullptr;
@@ -118,6 +175,9 @@ class FlutterViewController {
   // The backing engine
   std::unique_ptr<FlutterEngine> engine_;
 
+  // The backing engine of an additional view, owned by another controller.
+  FlutterEngine* shared_engine_ = nullptr;
+
   // The owned FlutterView.
   std::unique_ptr<FlutterView> view_;
 };
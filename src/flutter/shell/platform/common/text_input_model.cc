@@ -5,14 +5,8 @@
 #include "flutter/shell/platform/common/text_input_model.h"
 
 #include <algorithm>
-#include <codecvt>
-#include <locale>
 
-#if defined(_MSC_VER)
-// TODO(naifu): This temporary code is to solve link error.(VS2015/2017)
-// https://social.msdn.microsoft.com/Forums/vstudio/en-US/8f40dcd8-c67f-4eba-9134-a19b9178e481/vs-2015-rc-linker-stdcodecvt-error
-std::locale::id std::codecvt<char16_t, char, _Mbstatet>::id;
-#endif  // defined(_MSC_VER)
+#include "flutter/shell/platform/common/utf_conversion.h"
 
 namespace flutter {
 
@@ -34,9 +28,7 @@ TextInputModel::TextInputModel() = default;
 TextInputModel::~TextInputModel() = default;
 
 void TextInputModel::SetText(const std::string& text) {
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf16_converter;
-  text_ = utf16_converter.from_bytes(text);
+  text_ = Utf16FromUtf8(text);
   selection_ = TextRange(0);
   composing_range_ = TextRange(0);
 }
@@ -79,9 +71,7 @@ void TextInputModel::UpdateComposingText(const std::u16string& text) {
 }
 
 void TextInputModel::UpdateComposingText(const std::string& text) {
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf16_converter;
-  UpdateComposingText(utf16_converter.from_bytes(text));
+  UpdateComposingText(Utf16FromUtf8(text));
 }
 
 void TextInputModel::CommitComposing() {
@@ -113,17 +103,9 @@ bool TextInputModel::DeleteSelected() {
 }
 
 void TextInputModel::AddCodePoint(char32_t c) {
-  if (c <= 0xFFFF) {
-    AddText(std::u16string({static_cast<char16_t>(c)}));
-  } else {
-    char32_t to_decompose = c - 0x10000;
-    AddText(std::u16string({
-        // High surrogate.
-        static_cast<char16_t>((to_decompose >> 10) + 0xd800),
-        // Low surrogate.
-        static_cast<char16_t>((to_decompose % 0x400) + 0xdc00),
-    }));
-  }
+  std::u16string text;
+  AppendCodePointToUtf16(c, text);
+  AddText(text);
 }
 
 void TextInputModel::AddText(const std::u16string& text) {
@@ -140,9 +122,7 @@ void TextInputModel::AddText(const std::u16string& text) {
 }
 
 void TextInputModel::AddText(const std::string& text) {
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf16_converter;
-  AddText(utf16_converter.from_bytes(text));
+  AddText(Utf16FromUtf8(text));
 }
 
 bool TextInputModel::Backspace() {
@@ -290,18 +270,13 @@ bool TextInputModel::MoveCursorBack() {
 }
 
 std::string TextInputModel::GetText() const {
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf8_converter;
-  return utf8_converter.to_bytes(text_);
+  return Utf8FromUtf16(text_);
 }
 
 int TextInputModel::GetCursorOffset() const {
-  // Measure the length of the current text up to the selection extent.
-  // There is probably a much more efficient way of doing this.
-  auto leading_text = text_.substr(0, selection_.extent());
-  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-      utf8_converter;
-  return utf8_converter.to_bytes(leading_text).size();
+  // Measure the UTF-8 length of the current text up to the selection extent.
+  return Utf8LengthOfUtf16(
+      std::u16string_view(text_).substr(0, selection_.extent()));
 }
 
 }  // namespace flutter
@@ -0,0 +1,335 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/utf_conversion.h"
+
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define UTF_CONVERSION_USE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define UTF_CONVERSION_USE_NEON
+#endif
+
+namespace flutter {
+
+namespace {
+
+bool IsSurrogate(char32_t c) {
+  return (c & 0xFFFFF800) == 0xD800;
+}
+
+bool IsLeadingSurrogate(char32_t c) {
+  return (c & 0xFFFFFC00) == 0xD800;
+}
+
+bool IsTrailingSurrogate(char32_t c) {
+  return (c & 0xFFFFFC00) == 0xDC00;
+}
+
+// Copies the leading run of ASCII bytes of |src| into |dst| in blocks of 16
+// bytes. Returns the number of bytes copied, which may be less than the
+// actual length of the ASCII run. The caller handles the remainder.
+size_t WidenAsciiBlocks(const uint8_t* src, size_t size, char16_t* dst) {
+  size_t i = 0;
+#if defined(UTF_CONVERSION_USE_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= size; i += 16) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(bytes) != 0) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8),
+                     _mm_unpackhi_epi8(bytes, zero));
+  }
+#elif defined(UTF_CONVERSION_USE_NEON)
+  for (; i + 16 <= size; i += 16) {
+    uint8x16_t bytes = vld1q_u8(src + i);
+    if (vmaxvq_u8(bytes) >= 0x80) {
+      break;
+    }
+    vst1q_u16(reinterpret_cast<uint16_t*>(dst + i),
+              vmovl_u8(vget_low_u8(bytes)));
+    vst1q_u16(reinterpret_cast<uint16_t*>(dst + i + 8),
+              vmovl_high_u8(bytes));
+  }
+#endif
+  return i;
+}
+
+// Copies the leading run of ASCII code units of |src| into |dst| in blocks of
+// 8 code units. Returns the number of code units copied.
+size_t NarrowAsciiBlocks(const char16_t* src, size_t size, uint8_t* dst) {
+  size_t i = 0;
+#if defined(UTF_CONVERSION_USE_SSE2)
+  const __m128i non_ascii_mask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 8 <= size; i += 8) {
+    __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i non_ascii = _mm_and_si128(units, non_ascii_mask);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, zero)) != 0xFFFF) {
+      break;
+    }
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packus_epi16(units, units));
+  }
+#elif defined(UTF_CONVERSION_USE_NEON)
+  for (; i + 8 <= size; i += 8) {
+    uint16x8_t units = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+    if (vmaxvq_u16(units) >= 0x80) {
+      break;
+    }
+    vst1_u8(dst + i, vmovn_u16(units));
+  }
+#endif
+  return i;
+}
+
+// Returns the UTF-8 length of the leading blocks of 8 code units of |src|
+// that contain no surrogates, and stores the number of code units counted in
+// |counted|.
+size_t Utf8LengthOfBlocks(const char16_t* src, size_t size, size_t* counted) {
+  size_t i = 0;
+  size_t length = 0;
+#if defined(UTF_CONVERSION_USE_SSE2)
+  // SSE2 only has signed 16-bit comparisons, so bias the values by 0x8000.
+  const __m128i bias = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+  const __m128i two_bytes = _mm_set1_epi16(static_cast<int16_t>(0x807F));
+  const __m128i three_bytes = _mm_set1_epi16(static_cast<int16_t>(0x87FF));
+  const __m128i surrogate_mask = _mm_set1_epi16(static_cast<int16_t>(0xF800));
+  const __m128i surrogate = _mm_set1_epi16(static_cast<int16_t>(0xD800));
+  for (; i + 8 <= size; i += 8) {
+    __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(
+            _mm_and_si128(units, surrogate_mask), surrogate)) != 0) {
+      break;
+    }
+    __m128i biased = _mm_xor_si128(units, bias);
+    // Each comparison sets two mask bits per matching code unit.
+    int over_one = _mm_movemask_epi8(_mm_cmpgt_epi16(biased, two_bytes));
+    int over_two = _mm_movemask_epi8(_mm_cmpgt_epi16(biased, three_bytes));
+    const int extra_bytes =
+        (__builtin_popcount(over_one) + __builtin_popcount(over_two)) / 2;
+    length += 8 + extra_bytes;
+  }
+#elif defined(UTF_CONVERSION_USE_NEON)
+  const uint16x8_t surrogate_mask = vdupq_n_u16(0xF800);
+  const uint16x8_t surrogate = vdupq_n_u16(0xD800);
+  const uint16x8_t two_bytes = vdupq_n_u16(0x80);
+  const uint16x8_t three_bytes = vdupq_n_u16(0x800);
+  for (; i + 8 <= size; i += 8) {
+    uint16x8_t units = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+    if (vmaxvq_u16(vceqq_u16(vandq_u16(units, surrogate_mask), surrogate)) !=
+        0) {
+      break;
+    }
+    uint16x8_t extra =
+        vaddq_u16(vshrq_n_u16(vcgeq_u16(units, two_bytes), 15),
+                  vshrq_n_u16(vcgeq_u16(units, three_bytes), 15));
+    length += 8 + vaddvq_u16(extra);
+  }
+#endif
+  *counted = i;
+  return length;
+}
+
+// Decodes one code point from |src|, which must not be empty. Stores the
+// number of bytes consumed in |length|. On an ill-formed sequence, returns
+// U+FFFD and consumes its maximal valid prefix (at least one byte) as
+// recommended by the Unicode Standard, Section 3.9.
+char32_t DecodeUtf8(const uint8_t* src, size_t size, size_t* length) {
+  const uint8_t lead = src[0];
+  *length = 1;
+  if (lead < 0x80) {
+    return lead;
+  }
+
+  size_t trailing;
+  char32_t code_point;
+  uint8_t lower = 0x80;
+  uint8_t upper = 0xBF;
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    trailing = 1;
+    code_point = lead & 0x1F;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    trailing = 2;
+    code_point = lead & 0x0F;
+    if (lead == 0xE0) {
+      lower = 0xA0;  // Overlong.
+    } else if (lead == 0xED) {
+      upper = 0x9F;  // Surrogates.
+    }
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    trailing = 3;
+    code_point = lead & 0x07;
+    if (lead == 0xF0) {
+      lower = 0x90;  // Overlong.
+    } else if (lead == 0xF4) {
+      upper = 0x8F;  // Above U+10FFFF.
+    }
+  } else {
+    return kUnicodeReplacementCharacter;
+  }
+
+  for (size_t i = 1; i <= trailing; i++) {
+    if (i >= size || src[i] < lower || src[i] > upper) {
+      return kUnicodeReplacementCharacter;
+    }
+    lower = 0x80;
+    upper = 0xBF;
+    code_point = (code_point << 6) | (src[i] & 0x3F);
+    *length = i + 1;
+  }
+  return code_point;
+}
+
+// Encodes |code_point| into |dst| and returns the number of bytes written.
+size_t EncodeUtf8(char32_t code_point, uint8_t* dst) {
+  if (code_point < 0x80) {
+    dst[0] = static_cast<uint8_t>(code_point);
+    return 1;
+  }
+  if (code_point < 0x800) {
+    dst[0] = static_cast<uint8_t>(0xC0 | (code_point >> 6));
+    dst[1] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+    return 2;
+  }
+  if (code_point < 0x10000) {
+    dst[0] = static_cast<uint8_t>(0xE0 | (code_point >> 12));
+    dst[1] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F));
+    dst[2] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+    return 3;
+  }
+  dst[0] = static_cast<uint8_t>(0xF0 | (code_point >> 18));
+  dst[1] = static_cast<uint8_t>(0x80 | ((code_point >> 12) & 0x3F));
+  dst[2] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3F));
+  dst[3] = static_cast<uint8_t>(0x80 | (code_point & 0x3F));
+  return 4;
+}
+
+// Reads one code point from |src|, which must not be empty, and stores the
+// number of code units consumed in |length|.
+char32_t DecodeUtf16(const char16_t* src, size_t size, size_t* length) {
+  const char32_t unit = src[0];
+  *length = 1;
+  if (!IsSurrogate(unit)) {
+    return unit;
+  }
+  if (IsLeadingSurrogate(unit) && size > 1 && IsTrailingSurrogate(src[1])) {
+    *length = 2;
+    return 0x10000 + ((unit - 0xD800) << 10) + (src[1] - 0xDC00);
+  }
+  return kUnicodeReplacementCharacter;
+}
+
+}  // namespace
+
+std::u16string Utf16FromUtf8(std::string_view utf8) {
+  const auto* src = reinterpret_cast<const uint8_t*>(utf8.data());
+  const size_t size = utf8.size();
+
+  // Every code point produces at most one UTF-16 code unit per UTF-8 byte.
+  std::u16string utf16(size, u'\0');
+  char16_t* dst = utf16.data();
+  size_t in = 0;
+  size_t out = 0;
+  while (in < size) {
+    size_t copied = WidenAsciiBlocks(src + in, size - in, dst + out);
+    in += copied;
+    out += copied;
+    if (in == size) {
+      break;
+    }
+
+    size_t length;
+    char32_t code_point = DecodeUtf8(src + in, size - in, &length);
+    in += length;
+    if (code_point < 0x10000) {
+      dst[out++] = static_cast<char16_t>(code_point);
+    } else {
+      code_point -= 0x10000;
+      dst[out++] = static_cast<char16_t>(0xD800 + (code_point >> 10));
+      dst[out++] = static_cast<char16_t>(0xDC00 + (code_point & 0x3FF));
+    }
+  }
+  utf16.resize(out);
+  return utf16;
+}
+
+std::string Utf8FromUtf16(std::u16string_view utf16) {
+  const char16_t* src = utf16.data();
+  const size_t size = utf16.size();
+
+  // A single code unit produces at most three bytes, and a surrogate pair
+  // produces four.
+  std::string utf8(size * 3, '\0');
+  auto* dst = reinterpret_cast<uint8_t*>(utf8.data());
+  size_t in = 0;
+  size_t out = 0;
+  while (in < size) {
+    size_t copied = NarrowAsciiBlocks(src + in, size - in, dst + out);
+    in += copied;
+    out += copied;
+    if (in == size) {
+      break;
+    }
+
+    size_t length;
+    char32_t code_point = DecodeUtf16(src + in, size - in, &length);
+    in += length;
+    out += EncodeUtf8(code_point, dst + out);
+  }
+  utf8.resize(out);
+  return utf8;
+}
+
+size_t Utf8LengthOfUtf16(std::u16string_view utf16) {
+  const char16_t* src = utf16.data();
+  const size_t size = utf16.size();
+
+  size_t in = 0;
+  size_t length = 0;
+  while (in < size) {
+    size_t counted;
+    length += Utf8LengthOfBlocks(src + in, size - in, &counted);
+    in += counted;
+    if (in == size) {
+      break;
+    }
+
+    size_t consumed;
+    char32_t code_point = DecodeUtf16(src + in, size - in, &consumed);
+    in += consumed;
+    length += code_point < 0x80      ? 1
+              : code_point < 0x800   ? 2
+              : code_point < 0x10000 ? 3
+                                     : 4;
+  }
+  return length;
+}
+
+char32_t FirstCodePointOfUtf8(std::string_view utf8) {
+  if (utf8.empty()) {
+    return 0;
+  }
+  size_t length;
+  return DecodeUtf8(reinterpret_cast<const uint8_t*>(utf8.data()), utf8.size(),
+                    &length);
+}
+
+void AppendCodePointToUtf16(char32_t code_point, std::u16string& utf16) {
+  if (code_point < 0x10000) {
+    utf16.push_back(static_cast<char16_t>(code_point));
+  } else {
+    code_point -= 0x10000;
+    utf16.push_back(static_cast<char16_t>(0xD800 + (code_point >> 10)));
+    utf16.push_back(static_cast<char16_t>(0xDC00 + (code_point & 0x3FF)));
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,39 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_COMMON_UTF_CONVERSION_H_
+#define FLUTTER_SHELL_PLATFORM_COMMON_UTF_CONVERSION_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace flutter {
+
+// The code point used in place of ill-formed input sequences.
+constexpr char32_t kUnicodeReplacementCharacter = 0xFFFD;
+
+// Converts a UTF-8 string to UTF-16. Ill-formed sequences (truncated,
+// overlong, surrogate or out-of-range encodings) are replaced with U+FFFD
+// instead of throwing like std::wstring_convert does.
+std::u16string Utf16FromUtf8(std::string_view utf8);
+
+// Converts a UTF-16 string to UTF-8. Unpaired surrogates are replaced with
+// U+FFFD.
+std::string Utf8FromUtf16(std::u16string_view utf16);
+
+// Returns the number of bytes Utf8FromUtf16() would produce for |utf16|
+// without allocating the converted string.
+size_t Utf8LengthOfUtf16(std::u16string_view utf16);
+
+// Decodes the first code point of |utf8|. Returns 0 if |utf8| is empty and
+// U+FFFD if it starts with an ill-formed sequence.
+char32_t FirstCodePointOfUtf8(std::string_view utf8);
+
+// Appends |code_point| to |utf16| as one code unit or a surrogate pair.
+void AppendCodePointToUtf16(char32_t code_point, std::u16string& utf16);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_COMMON_UTF_CONVERSION_H_
@@ -0,0 +1,98 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/common/utf_conversion.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+// A string of each UTF-8 length, which the ASCII blocks of the fast paths
+// must stop at wherever they appear.
+const std::string kMixedUtf8 = "a\xC3\xA9\xE3\x81\x82\xF0\x9F\x98\x80";
+const std::u16string kMixedUtf16 = u"aéあ\U0001F600";
+}  // namespace
+
+TEST(UtfConversionTest, ConvertsEmptyStrings) {
+  EXPECT_EQ(Utf16FromUtf8(""), u"");
+  EXPECT_EQ(Utf8FromUtf16(u""), "");
+  EXPECT_EQ(Utf8LengthOfUtf16(u""), 0u);
+}
+
+TEST(UtfConversionTest, ConvertsAllUtf8Lengths) {
+  EXPECT_EQ(Utf16FromUtf8(kMixedUtf8), kMixedUtf16);
+  EXPECT_EQ(Utf8FromUtf16(kMixedUtf16), kMixedUtf8);
+  EXPECT_EQ(Utf8LengthOfUtf16(kMixedUtf16), kMixedUtf8.size());
+}
+
+// Moves the non-ASCII characters across the 16-byte and 8-unit blocks of the
+// SIMD paths, so that both the blocks and the scalar tails are covered.
+TEST(UtfConversionTest, ConvertsAcrossBlockBoundaries) {
+  for (size_t prefix = 0; prefix < 40; prefix++) {
+    for (size_t suffix = 0; suffix < 20; suffix += 7) {
+      const std::string utf8 = std::string(prefix, 'x') + kMixedUtf8 +
+                               std::string(suffix, 'y');
+      const std::u16string utf16 = std::u16string(prefix, u'x') + kMixedUtf16 +
+                                   std::u16string(suffix, u'y');
+      EXPECT_EQ(Utf16FromUtf8(utf8), utf16) << "prefix " << prefix;
+      EXPECT_EQ(Utf8FromUtf16(utf16), utf8) << "prefix " << prefix;
+      EXPECT_EQ(Utf8LengthOfUtf16(utf16), utf8.size()) << "prefix " << prefix;
+    }
+  }
+}
+
+TEST(UtfConversionTest, CountsLengthOfBlocksWithoutSurrogates) {
+  // Two and three byte characters fill whole blocks of 8 code units.
+  const std::u16string utf16 = std::u16string(16, u'é') +
+                               std::u16string(16, u'あ') +
+                               std::u16string(3, u'a');
+  EXPECT_EQ(Utf8LengthOfUtf16(utf16), 16u * 2 + 16u * 3 + 3u);
+  EXPECT_EQ(Utf8LengthOfUtf16(utf16), Utf8FromUtf16(utf16).size());
+}
+
+TEST(UtfConversionTest, ReplacesIllFormedUtf8) {
+  // Truncated sequence.
+  EXPECT_EQ(Utf16FromUtf8("a\xE3\x81"), u"a�");
+  // Overlong encoding of '/'.
+  EXPECT_EQ(Utf16FromUtf8("\xC0\xAF"), u"��");
+  // Encoded surrogate.
+  EXPECT_EQ(Utf16FromUtf8("\xED\xA0\x80").front(), u'�');
+  // Beyond U+10FFFF.
+  EXPECT_EQ(Utf16FromUtf8("\xF4\x90\x80\x80").front(), u'�');
+  // A stray continuation byte in a block of ASCII.
+  const std::string utf8 = std::string(20, 'x') + "\x80" + "y";
+  EXPECT_EQ(Utf16FromUtf8(utf8), std::u16string(20, u'x') + u"�y");
+}
+
+TEST(UtfConversionTest, ReplacesUnpairedSurrogates) {
+  const std::u16string leading = {u'a', 0xD83D, u'b'};
+  EXPECT_EQ(Utf8FromUtf16(leading), "a\xEF\xBF\xBD" "b");
+  EXPECT_EQ(Utf8LengthOfUtf16(leading), 5u);
+
+  const std::u16string trailing = {0xDE00};
+  EXPECT_EQ(Utf8FromUtf16(trailing), "\xEF\xBF\xBD");
+  EXPECT_EQ(Utf8LengthOfUtf16(trailing), 3u);
+}
+
+TEST(UtfConversionTest, DecodesFirstCodePoint) {
+  EXPECT_EQ(FirstCodePointOfUtf8(""), 0u);
+  EXPECT_EQ(FirstCodePointOfUtf8("ab"), U'a');
+  EXPECT_EQ(FirstCodePointOfUtf8("\xF0\x9F\x98\x80z"), U'\U0001F600');
+  EXPECT_EQ(FirstCodePointOfUtf8("\xFF"), kUnicodeReplacementCharacter);
+}
+
+TEST(UtfConversionTest, AppendsCodePoints) {
+  std::u16string utf16;
+  AppendCodePointToUtf16(U'a', utf16);
+  AppendCodePointToUtf16(U'\U0001F600', utf16);
+  EXPECT_EQ(utf16, u"a\U0001F600");
+  EXPECT_EQ(utf16.size(), 3u);
+}
+
+}  // namespace testing
+}  // namespace flutter
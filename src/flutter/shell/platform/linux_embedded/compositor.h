@@ -0,0 +1,43 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_H_
+
+#include "flutter/shell/platform/embedder/embedder.h"
+
+namespace flutter {
+
+class FlutterELinuxView;
+
+// Composites the layers rendered by the engine onto the views. It's used when
+// the engine has multiple views, since the renderer config can only present
+// to the implicit view. The methods are called on the raster thread, except
+// RemoveView().
+class Compositor {
+ public:
+  virtual ~Compositor() = default;
+
+  // Creates a backing store for the engine to render a layer of
+  // |config.view_id| into.
+  virtual bool CreateBackingStore(const FlutterBackingStoreConfig& config,
+                                  FlutterBackingStore* result) = 0;
+
+  // Destroys a backing store created by CreateBackingStore().
+  virtual bool CollectBackingStore(const FlutterBackingStore* store) = 0;
+
+  // Presents |layers| onto |view|.
+  virtual bool Present(FlutterELinuxView* view,
+                       const FlutterLayer** layers,
+                       size_t layers_count) = 0;
+
+  // Releases what was kept for presenting onto |view|, which the engine no
+  // longer renders to. Called on the platform thread, while no view is
+  // presented.
+  virtual void RemoveView(FlutterELinuxView* view) {}
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_H_
@@ -0,0 +1,272 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/compositor_opengl.h"
+
+#ifdef USE_GLES3
+#include <GLES3/gl32.h>
+#else
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#endif
+
+#include "flutter/common/constants.h"
+#include "flutter/shell/platform/linux_embedded/flutter_elinux_engine.h"
+#include "flutter/shell/platform/linux_embedded/flutter_elinux_view.h"
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+constexpr size_t kBytesPerPixel = 4;
+
+#ifdef USE_GLES3
+constexpr uint32_t kFramebufferFormat = GL_RGBA8;
+#else
+constexpr uint32_t kFramebufferFormat = GL_RGBA8_OES;
+#endif
+
+// Draws a texture over the whole viewport. The texture coordinates follow the
+// positions, so the rows keep the bottom-up order of GL.
+constexpr char kVertexShader[] = R"(
+attribute vec2 position;
+varying vec2 tex_coord;
+void main() {
+  tex_coord = position * 0.5 + 0.5;
+  gl_Position = vec4(position, 0.0, 1.0);
+}
+)";
+
+constexpr char kFragmentShader[] = R"(
+precision mediump float;
+uniform sampler2D tex;
+varying vec2 tex_coord;
+void main() {
+  gl_FragColor = texture2D(tex, tex_coord);
+}
+)";
+
+constexpr GLuint kPositionLocation = 0;
+
+// A triangle strip covering the viewport.
+constexpr GLfloat kQuadVertices[] = {
+    -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f,
+};
+
+// Sets the parameters which make a texture of any size complete on GLES2.
+void SetTextureParameters() {
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+GLuint CompileShader(GLenum type, const char* source) {
+  auto shader = glCreateShader(type);
+  glShaderSource(shader, 1, &source, nullptr);
+  glCompileShader(shader);
+  GLint compiled = GL_FALSE;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+  if (compiled != GL_TRUE) {
+    ELINUX_LOG(ERROR) << "Failed to compile a shader of the compositor.";
+    glDeleteShader(shader);
+    return 0;
+  }
+  return shader;
+}
+
+// Returns the program drawing a texture in the current context, or 0 if it
+// can't be built.
+GLuint CreateTextureProgram() {
+  auto vertex = CompileShader(GL_VERTEX_SHADER, kVertexShader);
+  auto fragment = CompileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+  GLuint program = 0;
+  if (vertex && fragment) {
+    program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glBindAttribLocation(program, kPositionLocation, "position");
+    glLinkProgram(program);
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+      ELINUX_LOG(ERROR) << "Failed to link the program of the compositor.";
+      glDeleteProgram(program);
+      program = 0;
+    }
+  }
+  // The attached shaders are deleted with the program.
+  glDeleteShader(vertex);
+  glDeleteShader(fragment);
+  return program;
+}
+}  // namespace
+
+CompositorOpenGL::CompositorOpenGL(FlutterELinuxEngine* engine)
+    : engine_(engine) {}
+
+bool CompositorOpenGL::CreateBackingStore(
+    const FlutterBackingStoreConfig& config,
+    FlutterBackingStore* result) {
+  result->type = kFlutterBackingStoreTypeOpenGL;
+  result->open_gl.type = kFlutterOpenGLTargetTypeFramebuffer;
+  result->open_gl.framebuffer.target = kFramebufferFormat;
+  result->open_gl.framebuffer.user_data = nullptr;
+  result->open_gl.framebuffer.destruction_callback = [](void* user_data) {
+    // Collected by CollectBackingStore.
+  };
+
+  if (config.view_id == kFlutterImplicitViewId) {
+    result->user_data = nullptr;
+    result->open_gl.framebuffer.name = engine_->view()->GetOnscreenFBO();
+    return true;
+  }
+
+  auto* framebuffer = new Framebuffer();
+  framebuffer->width = config.size.width;
+  framebuffer->height = config.size.height;
+  glGenTextures(1, &framebuffer->texture);
+  glBindTexture(GL_TEXTURE_2D, framebuffer->texture);
+  SetTextureParameters();
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, framebuffer->width,
+               framebuffer->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glGenFramebuffers(1, &framebuffer->framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer->framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         framebuffer->texture, 0);
+  const auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  if (status != GL_FRAMEBUFFER_COMPLETE) {
+    ELINUX_LOG(ERROR) << "Failed to create a framebuffer: " << status;
+    glDeleteFramebuffers(1, &framebuffer->framebuffer);
+    glDeleteTextures(1, &framebuffer->texture);
+    delete framebuffer;
+    return false;
+  }
+
+  result->user_data = framebuffer;
+  result->open_gl.framebuffer.name = framebuffer->framebuffer;
+  return true;
+}
+
+bool CompositorOpenGL::CollectBackingStore(const FlutterBackingStore* store) {
+  auto* framebuffer = static_cast<Framebuffer*>(store->user_data);
+  if (!framebuffer) {
+    return true;
+  }
+  glDeleteFramebuffers(1, &framebuffer->framebuffer);
+  glDeleteTextures(1, &framebuffer->texture);
+  delete framebuffer;
+  return true;
+}
+
+bool CompositorOpenGL::Present(FlutterELinuxView* view,
+                               const FlutterLayer** layers,
+                               size_t layers_count) {
+  // The embedder has no platform views composited by the engine, so a frame
+  // is a single layer rendered by Flutter.
+  for (size_t i = 0; i < layers_count; i++) {
+    if (layers[i]->type != kFlutterLayerContentTypeBackingStore) {
+      continue;
+    }
+    auto* framebuffer =
+        static_cast<Framebuffer*>(layers[i]->backing_store->user_data);
+    return framebuffer ? PresentFramebuffer(view, *framebuffer)
+                       : view->Present();
+  }
+  return true;
+}
+
+void CompositorOpenGL::RemoveView(FlutterELinuxView* view) {
+  auto it = view_resources_.find(view);
+  if (it == view_resources_.end()) {
+    return;
+  }
+  // The context of the view is only current while a frame is presented, so
+  // the engine's context is restored afterwards, as by PresentFramebuffer().
+  if (view->MakeCurrent()) {
+    glDeleteProgram(it->second.program);
+    if (it->second.texture) {
+      glDeleteTextures(1, &it->second.texture);
+    }
+    if (engine_->view()) {
+      engine_->view()->MakeCurrent();
+    } else {
+      view->ClearCurrent();
+    }
+  }
+  view_resources_.erase(it);
+}
+
+bool CompositorOpenGL::PresentFramebuffer(FlutterELinuxView* view,
+                                          const Framebuffer& framebuffer) {
+  auto* surface = view->GetRenderSurfaceTarget();
+  auto* engine_surface = engine_->view()->GetRenderSurfaceTarget();
+  if (!surface || !engine_surface) {
+    ELINUX_LOG(ERROR) << "The view " << view->view_id()
+                      << " has no OpenGL surface.";
+    return false;
+  }
+
+  const bool shared = surface->IsSharedWith(*engine_surface);
+  if (shared) {
+    // The rendering must be complete before another context samples the
+    // texture.
+    glFinish();
+  } else {
+    // The fallback for windows on another native display or EGL config.
+    read_pixels_.resize(framebuffer.width * framebuffer.height *
+                        kBytesPerPixel);
+    GLint bound_framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer.framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, framebuffer.width, framebuffer.height, GL_RGBA,
+                 GL_UNSIGNED_BYTE, read_pixels_.data());
+    glBindFramebuffer(GL_FRAMEBUFFER, bound_framebuffer);
+  }
+
+  if (!view->MakeCurrent()) {
+    engine_->view()->MakeCurrent();
+    return false;
+  }
+  auto it = view_resources_.find(view);
+  if (it == view_resources_.end()) {
+    ViewResources resources = {CreateTextureProgram(), 0};
+    if (!shared) {
+      glGenTextures(1, &resources.texture);
+      glBindTexture(GL_TEXTURE_2D, resources.texture);
+      SetTextureParameters();
+    }
+    it = view_resources_.emplace(view, resources).first;
+  }
+  const auto& resources = it->second;
+
+  if (shared) {
+    glBindTexture(GL_TEXTURE_2D, framebuffer.texture);
+  } else {
+    glBindTexture(GL_TEXTURE_2D, resources.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, framebuffer.width,
+                 framebuffer.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 read_pixels_.data());
+  }
+  glViewport(0, 0, framebuffer.width, framebuffer.height);
+  glUseProgram(resources.program);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glVertexAttribPointer(kPositionLocation, 2, GL_FLOAT, GL_FALSE, 0,
+                        kQuadVertices);
+  glEnableVertexAttribArray(kPositionLocation);
+  glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  const bool presented = view->Present();
+
+  // The engine continues with its own context.
+  engine_->view()->MakeCurrent();
+  return presented;
+}
+
+}  // namespace flutter
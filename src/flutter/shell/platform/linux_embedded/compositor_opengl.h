@@ -0,0 +1,84 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_OPENGL_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_OPENGL_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/shell/platform/linux_embedded/compositor.h"
+
+namespace flutter {
+
+class FlutterELinuxEngine;
+
+// Composites the layers of the OpenGL ES renderer.
+//
+// The implicit view is rendered directly into the window surface, which is
+// current with the engine's context. The other views are rendered into
+// offscreen framebuffers, which are drawn onto the EGL surfaces of their
+// windows with the contexts of the windows and swapped. The contexts of the
+// windows sharing the native display and the EGL config of the implicit view
+// are in the share group of the engine's context, so they draw the textures
+// of the framebuffers directly. The framebuffers of the other windows are read
+// back and uploaded to their contexts.
+class CompositorOpenGL : public Compositor {
+ public:
+  explicit CompositorOpenGL(FlutterELinuxEngine* engine);
+  ~CompositorOpenGL() = default;
+
+  // |Compositor|
+  bool CreateBackingStore(const FlutterBackingStoreConfig& config,
+                          FlutterBackingStore* result) override;
+
+  // |Compositor|
+  bool CollectBackingStore(const FlutterBackingStore* store) override;
+
+  // |Compositor|
+  bool Present(FlutterELinuxView* view,
+               const FlutterLayer** layers,
+               size_t layers_count) override;
+
+  // |Compositor|
+  void RemoveView(FlutterELinuxView* view) override;
+
+ private:
+  // An offscreen framebuffer with a texture as the color attachment.
+  struct Framebuffer {
+    uint32_t texture;
+    uint32_t framebuffer;
+    size_t width;
+    size_t height;
+  };
+
+  // The GL objects of the context of a view's window.
+  struct ViewResources {
+    // The program drawing a texture over the whole surface.
+    uint32_t program;
+    // The texture the framebuffers are uploaded to if the context isn't shared
+    // with the engine's, or 0.
+    uint32_t texture;
+  };
+
+  // Draws |framebuffer| onto the surface of |view| and swaps it. The engine's
+  // context is current again on return.
+  bool PresentFramebuffer(FlutterELinuxView* view,
+                          const Framebuffer& framebuffer);
+
+  FlutterELinuxEngine* engine_;
+
+  // The resources of the views presented so far. They're only accessed while
+  // the engine holds the lock of its views.
+  std::unordered_map<FlutterELinuxView*, ViewResources> view_resources_;
+
+  // The pixels read back from a framebuffer for a view whose context isn't
+  // shared with the engine's.
+  std::vector<uint8_t> read_pixels_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_OPENGL_H_
@@ -0,0 +1,63 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/compositor_software.h"
+
+#include <cstdlib>
+
+#include "flutter/shell/platform/linux_embedded/flutter_elinux_view.h"
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+// The engine renders kN32_SkColorType, i.e. 4 bytes per pixel.
+constexpr size_t kBytesPerPixel = 4;
+}  // namespace
+
+bool CompositorSoftware::CreateBackingStore(
+    const FlutterBackingStoreConfig& config,
+    FlutterBackingStore* result) {
+  const size_t row_bytes = config.size.width * kBytesPerPixel;
+  const size_t height = config.size.height;
+  void* allocation = std::calloc(row_bytes, height);
+  if (!allocation) {
+    ELINUX_LOG(ERROR) << "Failed to allocate a backing store.";
+    return false;
+  }
+
+  result->type = kFlutterBackingStoreTypeSoftware;
+  result->user_data = allocation;
+  result->software.allocation = allocation;
+  result->software.row_bytes = row_bytes;
+  result->software.height = height;
+  result->software.user_data = nullptr;
+  result->software.destruction_callback = [](void* user_data) {
+    // Collected by CollectBackingStore.
+  };
+  return true;
+}
+
+bool CompositorSoftware::CollectBackingStore(const FlutterBackingStore* store) {
+  std::free(store->user_data);
+  return true;
+}
+
+bool CompositorSoftware::Present(FlutterELinuxView* view,
+                                 const FlutterLayer** layers,
+                                 size_t layers_count) {
+  // The embedder has no platform views composited by the engine, so a frame
+  // is a single layer rendered by Flutter.
+  for (size_t i = 0; i < layers_count; i++) {
+    if (layers[i]->type != kFlutterLayerContentTypeBackingStore) {
+      continue;
+    }
+    const auto& software = layers[i]->backing_store->software;
+    return view->PresentSoftwareBitmap(software.allocation, software.row_bytes,
+                                       software.height);
+  }
+  return true;
+}
+
+}  // namespace flutter
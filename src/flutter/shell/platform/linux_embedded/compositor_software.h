@@ -0,0 +1,35 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_SOFTWARE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_SOFTWARE_H_
+
+#include "flutter/shell/platform/linux_embedded/compositor.h"
+
+namespace flutter {
+
+// Composites the layers of the software renderer. The engine renders into
+// memory buffers, which are presented through the software surfaces of the
+// views.
+class CompositorSoftware : public Compositor {
+ public:
+  CompositorSoftware() = default;
+  ~CompositorSoftware() = default;
+
+  // |Compositor|
+  bool CreateBackingStore(const FlutterBackingStoreConfig& config,
+                          FlutterBackingStore* result) override;
+
+  // |Compositor|
+  bool CollectBackingStore(const FlutterBackingStore* store) override;
+
+  // |Compositor|
+  bool Present(FlutterELinuxView* view,
+               const FlutterLayer** layers,
+               size_t layers_count) override;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_COMPOSITOR_SOFTWARE_H_
@@ -0,0 +1,48 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/file_utils.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <sstream>
+
+namespace flutter {
+
+void ListFiles(const std::string& dir, std::vector<FileInfo>& files) {
+  auto* stream = opendir(dir.c_str());
+  if (!stream) {
+    return;
+  }
+  while (auto* entry = readdir(stream)) {
+    const std::string name = entry->d_name;
+    if (name == "." || name == "..") {
+      continue;
+    }
+    const auto path = dir + "/" + name;
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) {
+      continue;
+    }
+    if (S_ISDIR(st.st_mode)) {
+      ListFiles(path, files);
+    } else if (S_ISREG(st.st_mode)) {
+      files.push_back({path, static_cast<size_t>(st.st_size), st.st_mtime});
+    }
+  }
+  closedir(stream);
+}
+
+std::string GetFileStamp(const std::string& path) {
+  struct stat st;
+  if (path.empty() || stat(path.c_str(), &st) != 0) {
+    return "none";
+  }
+  std::ostringstream stamp;
+  stamp << st.st_size << "-" << st.st_mtime;
+  return stamp.str();
+}
+
+}  // namespace flutter
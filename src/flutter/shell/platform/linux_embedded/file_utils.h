@@ -0,0 +1,32 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_FILE_UTILS_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_FILE_UTILS_H_
+
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+namespace flutter {
+
+// A regular file found by ListFiles().
+struct FileInfo {
+  std::string path;
+  size_t size;
+  time_t mtime;
+};
+
+// Appends the regular files under |dir| and its subdirectories to |files|.
+// The paths start with |dir|. Symbolic links aren't followed.
+void ListFiles(const std::string& dir, std::vector<FileInfo>& files);
+
+// Returns the size and the modification time of the file at |path|, which
+// change with its build, or "none" if there's no such file.
+std::string GetFileStamp(const std::string& path);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_FILE_UTILS_H_
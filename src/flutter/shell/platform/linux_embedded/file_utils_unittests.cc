@@ -0,0 +1,73 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/file_utils.h"
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+void WriteFile(const std::string& path, const std::string& contents) {
+  std::ofstream file(path, std::ios::trunc);
+  file << contents;
+}
+}  // namespace
+
+TEST(FileUtilsTest, ListsTheFilesOfTheSubdirectories) {
+  char dir[] = "/tmp/flutter_elinux_file_utils_test_XXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  const std::string root = dir;
+  ASSERT_EQ(mkdir((root + "/fonts").c_str(), 0755), 0);
+  WriteFile(root + "/AssetManifest.bin", "manifest");
+  WriteFile(root + "/fonts/MaterialIcons-Regular.otf", "font");
+  // The links aren't followed, so the files aren't listed twice.
+  ASSERT_EQ(symlink("fonts", (root + "/link").c_str()), 0);
+
+  std::vector<FileInfo> files;
+  ListFiles(root, files);
+  std::sort(files.begin(), files.end(),
+            [](const FileInfo& a, const FileInfo& b) {
+              return a.path < b.path;
+            });
+  ASSERT_EQ(files.size(), 2u);
+  EXPECT_EQ(files[0].path, root + "/AssetManifest.bin");
+  EXPECT_EQ(files[0].size, 8u);
+  EXPECT_EQ(files[1].path, root + "/fonts/MaterialIcons-Regular.otf");
+  EXPECT_EQ(files[1].size, 4u);
+
+  const auto command = "rm -rf " + root;
+  system(command.c_str());
+}
+
+TEST(FileUtilsTest, StampChangesWithTheFile) {
+  char dir[] = "/tmp/flutter_elinux_file_utils_test_XXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  const std::string path = std::string(dir) + "/libapp.so";
+
+  EXPECT_EQ(GetFileStamp(path), "none");
+  EXPECT_EQ(GetFileStamp(""), "none");
+  WriteFile(path, "app");
+  const auto stamp = GetFileStamp(path);
+  EXPECT_NE(stamp, "none");
+  EXPECT_EQ(GetFileStamp(path), stamp);
+  WriteFile(path, "updated app");
+  EXPECT_NE(GetFileStamp(path), stamp);
+
+  const auto command = std::string("rm -rf ") + dir;
+  system(command.c_str());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -24,6 +24,8 @@
 #include "flutter/shell/platform/linux_embedded/window/native_window_drm_eglstream.h"
 #elif defined(DISPLAY_BACKEND_TYPE_X11)
 #include "flutter/shell/platform/linux_embedded/window/elinux_window_x11.h"
+#elif defined(DISPLAY_BACKEND_TYPE_HEADLESS)
+#include "flutter/shell/platform/linux_embedded/window/elinux_window_headless.h"
 #else
 #include "flutter/shell/platform/linux_embedded/window/elinux_window_wayland.h"
 #endif
@@ -64,6 +66,26 @@ static FlutterDesktopTextureRegistrarRef HandleForTextureRegistrar(
   return reinterpret_cast<FlutterDesktopTextureRegistrarRef>(registrar);
 }
 
+// Creates the window of the display backend for a view.
+static std::unique_ptr<flutter::WindowBindingHandler>
+CreateWindowBindingHandler(
+    const FlutterDesktopViewProperties& view_properties) {
+#if defined(DISPLAY_BACKEND_TYPE_DRM_GBM)
+  return std::make_unique<
+      flutter::ELinuxWindowDrm<flutter::NativeWindowDrmGbm>>(view_properties);
+#elif defined(DISPLAY_BACKEND_TYPE_DRM_EGLSTREAM)
+  return std::make_unique<
+      flutter::ELinuxWindowDrm<flutter::NativeWindowDrmEglstream>>(
+      view_properties);
+#elif defined(DISPLAY_BACKEND_TYPE_X11)
+  return std::make_unique<flutter::ELinuxWindowX11>(view_properties);
+#elif defined(DISPLAY_BACKEND_TYPE_HEADLESS)
+  return std::make_unique<flutter::ELinuxWindowHeadless>(view_properties);
+#else
+  return std::make_unique<flutter::ELinuxWindowWayland>(view_properties);
+#endif
+}
+
 uint64_t FlutterDesktopEngineProcessMessages(FlutterDesktopEngineRef engine) {
   return static_cast<flutter::TaskRunner*>(
              EngineFromHandle(engine)->task_runner())
@@ -74,20 +96,9 @@ uint64_t FlutterDesktopEngineProcessMessages(FlutterDesktopEngineRef engine) {
 FlutterDesktopViewControllerRef FlutterDesktopViewControllerCreate(
     const FlutterDesktopViewProperties* view_properties,
     FlutterDesktopEngineRef engine) {
-  std::unique_ptr<flutter::WindowBindingHandler> window_wrapper =
-
-#if defined(DISPLAY_BACKEND_TYPE_DRM_GBM)
-      std::make_unique<flutter::ELinuxWindowDrm<flutter::NativeWindowDrmGbm>>(
-          *view_properties);
-#elif defined(DISPLAY_BACKEND_TYPE_DRM_EGLSTREAM)
-      std::make_unique<
-          flutter::ELinuxWindowDrm<flutter::NativeWindowDrmEglstream>>(
-          *view_properties);
-#elif defined(DISPLAY_BACKEND_TYPE_X11)
-      std::make_unique<flutter::ELinuxWindowX11>(*view_properties);
-#else
-      std::make_unique<flutter::ELinuxWindowWayland>(*view_properties);
-#endif
+  auto window_wrapper = CreateWindowBindingHandler(*view_properties);
+  EngineFromHandle(engine)->RecordStartupPhase(
+      kStartupPhaseDisplayInitialized);
 
   auto state = std::make_unique<FlutterDesktopViewControllerState>();
   state->view =
@@ -126,14 +137,88 @@ FlutterDesktopViewRef FlutterDesktopViewControllerGetView(
   return HandleForView(controller->view.get());
 }
 
+FlutterDesktopViewId FlutterDesktopViewControllerGetViewId(
+    FlutterDesktopViewControllerRef controller) {
+  return controller->view->view_id();
+}
+
 bool FlutterDesktopViewDispatchEvent(FlutterDesktopViewRef view) {
   return ViewFromHandle(view)->DispatchEvent();
 }
 
+int FlutterDesktopViewGetEventFd(FlutterDesktopViewRef view) {
+  return ViewFromHandle(view)->GetEventFd();
+}
+
+bool FlutterDesktopViewHasPendingEvents(FlutterDesktopViewRef view) {
+  return ViewFromHandle(view)->HasPendingEvents();
+}
+
 int32_t FlutterDesktopViewGetFrameRate(FlutterDesktopViewRef view) {
   return ViewFromHandle(view)->GetFrameRate();
 }
 
+void FlutterDesktopViewInjectPointerMove(FlutterDesktopViewRef view,
+                                         double x,
+                                         double y) {
+  ViewFromHandle(view)->OnPointerMove(x, y);
+}
+
+void FlutterDesktopViewInjectPointerButton(FlutterDesktopViewRef view,
+                                           double x,
+                                           double y,
+                                           FlutterDesktopPointerButton button,
+                                           bool pressed) {
+  auto flutter_button = static_cast<FlutterPointerMouseButtons>(button);
+  if (pressed) {
+    ViewFromHandle(view)->OnPointerDown(x, y, flutter_button);
+  } else {
+    ViewFromHandle(view)->OnPointerUp(x, y, flutter_button);
+  }
+}
+
+void FlutterDesktopViewInjectPointerLeave(FlutterDesktopViewRef view) {
+  ViewFromHandle(view)->OnPointerLeave();
+}
+
+void FlutterDesktopViewInjectScroll(FlutterDesktopViewRef view,
+                                    double x,
+                                    double y,
+                                    double delta_x,
+                                    double delta_y) {
+  constexpr int32_t kScrollOffsetMultiplier = 1;
+  ViewFromHandle(view)->OnScroll(x, y, delta_x, delta_y,
+                                 kScrollOffsetMultiplier);
+}
+
+void FlutterDesktopViewInjectTouchDown(FlutterDesktopViewRef view,
+                                       uint32_t time,
+                                       int32_t id,
+                                       double x,
+                                       double y) {
+  ViewFromHandle(view)->OnTouchDown(time, id, x, y);
+}
+
+void FlutterDesktopViewInjectTouchMotion(FlutterDesktopViewRef view,
+                                         uint32_t time,
+                                         int32_t id,
+                                         double x,
+                                         double y) {
+  ViewFromHandle(view)->OnTouchMotion(time, id, x, y);
+}
+
+void FlutterDesktopViewInjectTouchUp(FlutterDesktopViewRef view,
+                                     uint32_t time,
+                                     int32_t id) {
+  ViewFromHandle(view)->OnTouchUp(time, id);
+}
+
+void FlutterDesktopViewInjectKey(FlutterDesktopViewRef view,
+                                 uint32_t keycode,
+                                 bool pressed) {
+  ViewFromHandle(view)->OnKey(keycode, pressed);
+}
+
 FlutterDesktopEngineRef FlutterDesktopEngineCreate(
     const FlutterDesktopEngineProperties* engine_properties) {
   flutter::FlutterProjectBundle project(*engine_properties);
@@ -151,6 +236,32 @@ bool FlutterDesktopEngineDestroy(FlutterDesktopEngineRef engine_ref) {
   return result;
 }
 
+FlutterDesktopViewControllerRef FlutterDesktopEngineCreateViewController(
+    FlutterDesktopEngineRef engine,
+    const FlutterDesktopViewProperties* view_properties) {
+  // The frames rendered by the engine for the additional views are presented
+  // by the compositor of the engine's renderer: through shared memory buffers
+  // for the software renderer, and through EGL surfaces of their own for
+  // OpenGL ES. The implicit view paces the frames, so the additional views
+  // don't wait for their v-blanks on the raster thread.
+  auto* engine_view = EngineFromHandle(engine)->view();
+  auto properties = *view_properties;
+  if (engine_view && engine_view->IsSoftwareRendering()) {
+    properties.renderer_type = FlutterDesktopRendererType::kRendererSoftware;
+  } else {
+    properties.renderer_type = FlutterDesktopRendererType::kRendererOpenGL;
+    properties.enable_vsync = false;
+  }
+
+  auto state = std::make_unique<FlutterDesktopViewControllerState>();
+  state->view = std::make_unique<flutter::FlutterELinuxView>(
+      CreateWindowBindingHandler(properties));
+  if (!state->view->AddToEngine(EngineFromHandle(engine))) {
+    return nullptr;
+  }
+  return state.release();
+}
+
 bool FlutterDesktopEngineRun(FlutterDesktopEngineRef engine,
                              const char* entry_point) {
   return EngineFromHandle(engine)->RunWithEntrypoint(entry_point);
@@ -160,6 +271,22 @@ void FlutterDesktopEngineReloadSystemFonts(FlutterDesktopEngineRef engine) {
   EngineFromHandle(engine)->ReloadSystemFonts();
 }
 
+uint64_t FlutterDesktopEngineGetStartupPhaseTime(
+    FlutterDesktopEngineRef engine,
+    FlutterDesktopStartupPhase phase) {
+  if (phase < 0 || phase >= kStartupPhaseCount) {
+    return 0;
+  }
+  return EngineFromHandle(engine)->GetStartupPhaseTime(phase);
+}
+
+void FlutterDesktopEngineSetFirstFrameCallback(
+    FlutterDesktopEngineRef engine,
+    FlutterDesktopOnFirstFrameCallback callback,
+    void* user_data) {
+  EngineFromHandle(engine)->SetFirstFrameCallback(callback, user_data);
+}
+
 FlutterDesktopPluginRegistrarRef FlutterDesktopEngineGetPluginRegistrar(
     FlutterDesktopEngineRef engine,
     const char* plugin_name) {
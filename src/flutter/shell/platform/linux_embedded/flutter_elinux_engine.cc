@@ -6,14 +6,23 @@
 
 #include <rapidjson/document.h>
 
+#include <time.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <future>
 #include <iostream>
 #include <sstream>
 
+#include "flutter/common/constants.h"
 #include "flutter/shell/platform/common/client_wrapper/binary_messenger_impl.h"
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/basic_message_channel.h"
 #include "flutter/shell/platform/common/json_message_codec.h"
+#include "flutter/shell/platform/linux_embedded/compositor_opengl.h"
+#include "flutter/shell/platform/linux_embedded/compositor_software.h"
 #include "flutter/shell/platform/linux_embedded/flutter_elinux_view.h"
 #include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/persistent_cache_manager.h"
 #include "flutter/shell/platform/linux_embedded/system_utils.h"
 #include "flutter/shell/platform/linux_embedded/task_runner.h"
 
@@ -109,6 +118,110 @@ FlutterRendererConfig GetRendererConfig() {
   return config;
 }
 
+// Creates and returns a FlutterRendererConfig for the software renderer, which
+// presents the frames rendered on the CPU to the view (if any).
+FlutterRendererConfig GetSoftwareRendererConfig() {
+  FlutterRendererConfig config = {};
+  config.type = kSoftware;
+  config.software.struct_size = sizeof(config.software);
+  config.software.surface_present_callback =
+      [](void* user_data, const void* allocation, size_t row_bytes,
+         size_t height) -> bool {
+    auto host = static_cast<FlutterELinuxEngine*>(user_data);
+    if (!host->view()) {
+      return false;
+    }
+    return host->view()->PresentSoftwareBitmap(allocation, row_bytes, height);
+  };
+  return config;
+}
+
+#if defined(ENABLE_VULKAN)
+// Creates and returns a FlutterRendererConfig for the Vulkan renderer, which
+// renders into the swapchain images of the view with |context|.
+FlutterRendererConfig GetVulkanRendererConfig(ContextVulkan* context) {
+  FlutterRendererConfig config = {};
+  config.type = kVulkan;
+  config.vulkan.struct_size = sizeof(config.vulkan);
+  config.vulkan.version = context->ApiVersion();
+  config.vulkan.instance = context->Instance();
+  config.vulkan.physical_device = context->PhysicalDevice();
+  config.vulkan.device = context->Device();
+  config.vulkan.queue_family_index = context->QueueFamilyIndex();
+  config.vulkan.queue = context->Queue();
+  config.vulkan.enabled_instance_extension_count =
+      context->InstanceExtensions().size();
+  config.vulkan.enabled_instance_extensions =
+      context->InstanceExtensions().data();
+  config.vulkan.enabled_device_extension_count =
+      context->DeviceExtensions().size();
+  config.vulkan.enabled_device_extensions = context->DeviceExtensions().data();
+  config.vulkan.get_instance_proc_address_callback =
+      [](void* user_data, FlutterVulkanInstanceHandle instance,
+         const char* name) -> void* {
+    return ContextVulkan::GetInstanceProcAddress(
+        static_cast<VkInstance>(instance), name);
+  };
+  config.vulkan.get_next_image_callback =
+      [](void* user_data,
+         const FlutterFrameInfo* frame_info) -> FlutterVulkanImage {
+    auto host = static_cast<FlutterELinuxEngine*>(user_data);
+    if (!host->view()) {
+      FlutterVulkanImage image = {};
+      image.struct_size = sizeof(FlutterVulkanImage);
+      return image;
+    }
+    return host->view()->AcquireVulkanImage(frame_info);
+  };
+  config.vulkan.present_image_callback =
+      [](void* user_data, const FlutterVulkanImage* image) -> bool {
+    auto host = static_cast<FlutterELinuxEngine*>(user_data);
+    if (!host->view()) {
+      return false;
+    }
+    return host->view()->PresentVulkanImage(image);
+  };
+  return config;
+}
+#endif
+
+// Returns the start time of this process in nanoseconds of CLOCK_MONOTONIC, or
+// 0 if unknown. procfs has it in clock ticks since boot, which includes the
+// time suspended unlike CLOCK_MONOTONIC.
+uint64_t GetProcessStartTime() {
+  std::ifstream file("/proc/self/stat");
+  std::string stat;
+  if (!std::getline(file, stat)) {
+    return 0;
+  }
+  // The command name in parentheses may contain spaces. The start time is
+  // the 20th field after it.
+  auto command_end = stat.rfind(')');
+  if (command_end == std::string::npos) {
+    return 0;
+  }
+  std::istringstream fields(stat.substr(command_end + 1));
+  std::string field;
+  for (int i = 0; i < 19; i++) {
+    fields >> field;
+  }
+  uint64_t start_ticks = 0;
+  if (!(fields >> start_ticks)) {
+    return 0;
+  }
+
+  constexpr uint64_t kNanosPerSecond = 1000000000;
+  timespec boottime, monotonic;
+  clock_gettime(CLOCK_BOOTTIME, &boottime);
+  clock_gettime(CLOCK_MONOTONIC, &monotonic);
+  const uint64_t suspended_time =
+      (boottime.tv_sec - monotonic.tv_sec) * kNanosPerSecond +
+      (boottime.tv_nsec - monotonic.tv_nsec);
+  const uint64_t start_time =
+      start_ticks * kNanosPerSecond / sysconf(_SC_CLK_TCK);
+  return start_time > suspended_time ? start_time - suspended_time : 0;
+}
+
 // Converts a FlutterPlatformMessage to an equivalent FlutterDesktopMessage.
 static FlutterDesktopMessage ConvertToDesktopMessage(
     const FlutterPlatformMessage& engine_message) {
@@ -129,6 +242,11 @@ FlutterELinuxEngine::FlutterELinuxEngine(const FlutterProjectBundle& project)
   embedder_api_.struct_size = sizeof(FlutterEngineProcTable);
   FlutterEngineGetProcAddresses(&embedder_api_);
 
+  for (auto& time : startup_phase_times_) {
+    time = 0;
+  }
+  startup_phase_times_[kStartupPhaseProcessStart] = GetProcessStartTime();
+
   task_runner_ = std::make_unique<TaskRunner>(
       std::this_thread::get_id(), embedder_api_.GetCurrentTime,
       [this](const auto* task) {
@@ -164,6 +282,20 @@ FlutterELinuxEngine::FlutterELinuxEngine(const FlutterProjectBundle& project)
       std::make_unique<FlutterELinuxTextureRegistrar>(this, gl_procs_);
 
   vsync_waiter_ = std::make_unique<VsyncWaiter>();
+
+  if (project_->startup_prefetch_enabled()) {
+    prefetcher_ = std::make_unique<StartupPrefetcher>(
+        project_->aot_library_path(), project_->icu_path(),
+        project_->assets_path(), project_->prefetch_assets_list_path());
+    prefetcher_->Prefetch();
+  }
+
+  // Loading the AOT library doesn't depend on the view, so it overlaps with
+  // the creation of the window and the render surface.
+  if (embedder_api_.RunsAOTCompiledDartCode()) {
+    aot_data_future_ =
+        std::async(std::launch::async, [this]() { return LoadAotData(); });
+  }
 }
 
 FlutterELinuxEngine::~FlutterELinuxEngine() {
@@ -183,7 +315,8 @@ bool FlutterELinuxEngine::RunWithEntrypoint(const char* entrypoint) {
   std::string assets_path_string = project_->assets_path();
   std::string icu_path_string = project_->icu_path();
   if (embedder_api_.RunsAOTCompiledDartCode()) {
-    aot_data_ = project_->LoadAotData(embedder_api_);
+    aot_data_ =
+        aot_data_future_.valid() ? aot_data_future_.get() : LoadAotData();
     if (!aot_data_) {
       ELINUX_LOG(ERROR) << "Unable to start engine without AOT data.";
       return false;
@@ -240,19 +373,49 @@ bool FlutterELinuxEngine::RunWithEntrypoint(const char* entrypoint) {
     auto host = static_cast<FlutterELinuxEngine*>(user_data);
     return host->HandlePlatformMessage(engine_message);
   };
-#if defined(ENABLE_VSYNC)
-// todo: add drm/x11 support.
-// https://github.com/sony/flutter-embedded-linux/issues/136
-// https://github.com/sony/flutter-embedded-linux/issues/137
-#if defined(DISPLAY_BACKEND_TYPE_WAYLAND)
+#if defined(ENABLE_VSYNC) && defined(DISPLAY_BACKEND_TYPE_WAYLAND)
   args.vsync_callback = [](void* user_data, intptr_t baton) -> void {
     auto host = static_cast<FlutterELinuxEngine*>(user_data);
     host->vsync_waiter_->NotifyWaitForVsync(baton);
   };
 #endif
+  // The window provides a vsync per request, e.g. with the Present extension
+  // on X11. Otherwise the engine falls back to its own timer.
+  if (view_ && view_->IsVsyncRequestSupported()) {
+    args.vsync_callback = [](void* user_data, intptr_t baton) -> void {
+      auto host = static_cast<FlutterELinuxEngine*>(user_data);
+      host->vsync_waiter_->NotifyWaitForVsync(baton);
+      host->view_->RequestVsync();
+    };
+  }
+#if defined(DISPLAY_BACKEND_TYPE_HEADLESS)
+  // The headless backend always provides the vsync with its timer.
+  args.vsync_callback = [](void* user_data, intptr_t baton) -> void {
+    auto host = static_cast<FlutterELinuxEngine*>(user_data);
+    host->vsync_waiter_->NotifyWaitForVsync(baton);
+  };
 #endif
   args.custom_task_runners = &custom_task_runners;
 
+  // The cache is kept in a subdirectory of the configured path, which must
+  // outlive the engine run below.
+  PersistentCacheManager cache_manager(project_->persistent_cache_path(),
+                                       project_->persistent_cache_seed_path(),
+                                       project_->persistent_cache_max_size());
+  if (!project_->persistent_cache_path().empty()) {
+    bool cache_ready = true;
+    if (!project_->is_persistent_cache_read_only()) {
+      cache_ready = cache_manager.Prepare(
+          aot_data_ ? project_->aot_library_path()
+                    : assets_path_string + "/kernel_blob.bin");
+    }
+    if (cache_ready) {
+      args.persistent_cache_path = cache_manager.cache_path().c_str();
+      args.is_persistent_cache_read_only =
+          project_->is_persistent_cache_read_only();
+    }
+  }
+
   if (aot_data_) {
     args.aot_data = aot_data_.get();
   }
@@ -269,13 +432,42 @@ bool FlutterELinuxEngine::RunWithEntrypoint(const char* entrypoint) {
     std::cout << message << std::endl;
   };
 
-  auto renderer_config = GetRendererConfig();
+  const bool software_rendering = view_ && view_->IsSoftwareRendering();
+  if (software_rendering && enable_impeller_) {
+    ELINUX_LOG(WARNING) << "Impeller doesn't support the software renderer.";
+  }
+  auto renderer_config = software_rendering ? GetSoftwareRendererConfig()
+                                            : GetRendererConfig();
+#if defined(ENABLE_VULKAN)
+  auto* vulkan_surface = view_ ? view_->GetVulkanSurfaceTarget() : nullptr;
+  if (vulkan_surface) {
+    renderer_config = GetVulkanRendererConfig(vulkan_surface->Context());
+  }
+#endif
+
+  FlutterCompositor compositor = {};
+  if (project_->multi_view_enabled()) {
+    if (renderer_config.type == kVulkan) {
+      ELINUX_LOG(WARNING)
+          << "Multiple views aren't supported by the Vulkan renderer.";
+    } else {
+      if (software_rendering) {
+        compositor_ = std::make_unique<CompositorSoftware>();
+      } else {
+        compositor_ = std::make_unique<CompositorOpenGL>(this);
+      }
+      compositor = CreateCompositorConfig();
+      args.compositor = &compositor;
+    }
+  }
   auto result = embedder_api_.Run(FLUTTER_ENGINE_VERSION, &renderer_config,
                                   &args, this, &engine_);
   if (result != kSuccess || engine_ == nullptr) {
     ELINUX_LOG(ERROR) << "Failed to start Flutter engine: error " << result;
+    compositor_ = nullptr;
     return false;
   }
+  RecordStartupPhase(kStartupPhaseEngineRunning);
 
   return true;
 }
@@ -285,8 +477,10 @@ bool FlutterELinuxEngine::Stop() {
     if (plugin_registrar_destruction_callback_) {
       plugin_registrar_destruction_callback_(plugin_registrar_.get());
     }
+    vsync_waiter_->Reset();
     FlutterEngineResult result = embedder_api_.Shutdown(engine_);
     engine_ = nullptr;
+    compositor_ = nullptr;
     return (result == kSuccess);
   }
   return false;
@@ -294,6 +488,122 @@ bool FlutterELinuxEngine::Stop() {
 
 void FlutterELinuxEngine::SetView(FlutterELinuxView* view) {
   view_ = view;
+  std::lock_guard<std::mutex> lock(views_mutex_);
+  views_[kFlutterImplicitViewId] = view;
+}
+
+bool FlutterELinuxEngine::AddView(FlutterELinuxView* view) {
+  if (!engine_ || !compositor_) {
+    ELINUX_LOG(ERROR) << "Additional views need a running engine with "
+                         "multiple views enabled.";
+    return false;
+  }
+
+  const FlutterViewId view_id = next_view_id_++;
+  view->SetViewId(view_id);
+  {
+    std::lock_guard<std::mutex> lock(views_mutex_);
+    views_[view_id] = view;
+  }
+
+  const auto metrics = view->GetWindowMetrics();
+  std::promise<bool> added;
+  auto future = added.get_future();
+  FlutterAddViewInfo info = {};
+  info.struct_size = sizeof(FlutterAddViewInfo);
+  info.view_id = view_id;
+  info.view_metrics = &metrics;
+  info.user_data = &added;
+  info.add_view_callback = [](const FlutterAddViewResult* result) {
+    static_cast<std::promise<bool>*>(result->user_data)
+        ->set_value(result->added);
+  };
+  if (embedder_api_.AddView(engine_, &info) != kSuccess || !future.get()) {
+    ELINUX_LOG(ERROR) << "Failed to add the view " << view_id;
+    std::lock_guard<std::mutex> lock(views_mutex_);
+    views_.erase(view_id);
+    return false;
+  }
+  return true;
+}
+
+void FlutterELinuxEngine::RemoveView(FlutterELinuxView* view) {
+  const FlutterViewId view_id = view->view_id();
+  {
+    std::lock_guard<std::mutex> lock(views_mutex_);
+    auto it = views_.find(view_id);
+    if (view_id == kFlutterImplicitViewId || it == views_.end() ||
+        it->second != view) {
+      return;
+    }
+  }
+
+  if (engine_) {
+    // The view must be kept until the engine stops rendering to it.
+    std::promise<void> removed;
+    auto future = removed.get_future();
+    FlutterRemoveViewInfo info = {};
+    info.struct_size = sizeof(FlutterRemoveViewInfo);
+    info.view_id = view_id;
+    info.user_data = &removed;
+    info.remove_view_callback = [](const FlutterRemoveViewResult* result) {
+      static_cast<std::promise<void>*>(result->user_data)->set_value();
+    };
+    if (embedder_api_.RemoveView(engine_, &info) == kSuccess) {
+      future.wait();
+    } else {
+      ELINUX_LOG(ERROR) << "Failed to remove the view " << view_id;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(views_mutex_);
+  if (compositor_) {
+    compositor_->RemoveView(view);
+  }
+  views_.erase(view_id);
+}
+
+UniqueAotDataPtr FlutterELinuxEngine::LoadAotData() {
+  auto aot_data = project_->LoadAotData(embedder_api_);
+  if (aot_data && project_->aot_huge_pages_enabled()) {
+    StartupPrefetcher::AdviseHugePages(project_->aot_library_path());
+  }
+  RecordStartupPhase(kStartupPhaseAotLoaded);
+  return aot_data;
+}
+
+FlutterCompositor FlutterELinuxEngine::CreateCompositorConfig() {
+  FlutterCompositor compositor = {};
+  compositor.struct_size = sizeof(FlutterCompositor);
+  compositor.user_data = this;
+  compositor.create_backing_store_callback =
+      [](const FlutterBackingStoreConfig* config,
+         FlutterBackingStore* backing_store_out, void* user_data) -> bool {
+    auto host = static_cast<FlutterELinuxEngine*>(user_data);
+    return host->compositor_->CreateBackingStore(*config, backing_store_out);
+  };
+  compositor.collect_backing_store_callback =
+      [](const FlutterBackingStore* backing_store, void* user_data) -> bool {
+    auto host = static_cast<FlutterELinuxEngine*>(user_data);
+    return host->compositor_->CollectBackingStore(backing_store);
+  };
+  compositor.present_view_callback =
+      [](const FlutterPresentViewInfo* info) -> bool {
+    auto host = static_cast<FlutterELinuxEngine*>(info->user_data);
+    return host->PresentView(info->view_id, info->layers, info->layers_count);
+  };
+  return compositor;
+}
+
+bool FlutterELinuxEngine::PresentView(FlutterViewId view_id,
+                                      const FlutterLayer** layers,
+                                      size_t layers_count) {
+  std::lock_guard<std::mutex> lock(views_mutex_);
+  auto it = views_.find(view_id);
+  if (it == views_.end()) {
+    return false;
+  }
+  return compositor_->Present(it->second, layers, layers_count);
 }
 
 // Returns the currently configured Plugin Registrar.
@@ -306,6 +616,43 @@ void FlutterELinuxEngine::SetPluginRegistrarDestructionCallback(
   plugin_registrar_destruction_callback_ = callback;
 }
 
+void FlutterELinuxEngine::RecordStartupPhase(FlutterDesktopStartupPhase phase) {
+  auto& phase_time = startup_phase_times_[phase];
+  uint64_t unreached = 0;
+  // The frame phases are checked for every frame.
+  if (phase_time.load(std::memory_order_relaxed) != unreached ||
+      !phase_time.compare_exchange_strong(unreached,
+                                          embedder_api_.GetCurrentTime())) {
+    return;
+  }
+
+  const uint64_t process_start =
+      startup_phase_times_[kStartupPhaseProcessStart];
+  if (process_start) {
+    ELINUX_LOG(DEBUG) << "Startup phase " << phase << " reached in "
+                      << (phase_time - process_start) / 1000000
+                      << " ms after the process start.";
+  }
+
+  if (phase == kStartupPhaseFirstFramePresented) {
+    if (prefetcher_) {
+      prefetcher_->RecordAssets();
+    }
+    task_runner_->PostTask([this]() {
+      if (first_frame_callback_) {
+        first_frame_callback_(first_frame_callback_user_data_);
+      }
+    });
+  }
+}
+
+void FlutterELinuxEngine::SetFirstFrameCallback(
+    FlutterDesktopOnFirstFrameCallback callback,
+    void* user_data) {
+  first_frame_callback_ = callback;
+  first_frame_callback_user_data_ = user_data;
+}
+
 void FlutterELinuxEngine::SendWindowMetricsEvent(
     const FlutterWindowMetricsEvent& event) {
   if (engine_) {
@@ -7,19 +7,26 @@
 
 #include <rapidjson/document.h>
 
+#include <array>
+#include <atomic>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/shell/platform/common/client_wrapper/binary_messenger_impl.h"
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/basic_message_channel.h"
 #include "flutter/shell/platform/common/incoming_message_dispatcher.h"
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/linux_embedded/compositor.h"
 #include "flutter/shell/platform/linux_embedded/flutter_elinux_state.h"
 #include "flutter/shell/platform/linux_embedded/flutter_elinux_texture_registrar.h"
 #include "flutter/shell/platform/linux_embedded/flutter_project_bundle.h"
 #include "flutter/shell/platform/linux_embedded/public/flutter_elinux.h"
+#include "flutter/shell/platform/linux_embedded/startup_prefetcher.h"
 #include "flutter/shell/platform/linux_embedded/task_runner.h"
 #include "flutter/shell/platform/linux_embedded/vsync_waiter.h"
 
@@ -58,9 +65,19 @@ class FlutterELinuxEngine {
   void SetView(FlutterELinuxView* view);
 
   // The view displaying this engine's content, if any. This will be null for
-  // headless engines.
+  // headless engines. With multiple views, this is the implicit view.
   FlutterELinuxView* view() { return view_; }
 
+  // Adds |view| as an additional view of the running engine, and assigns its
+  // view ID. Blocks until the engine has added the view.
+  //
+  // Returns false if the engine isn't running with multiple views enabled.
+  bool AddView(FlutterELinuxView* view);
+
+  // Removes |view| added by AddView(). Blocks until the engine stops
+  // rendering to the view.
+  void RemoveView(FlutterELinuxView* view);
+
   // Returns the currently configured Plugin Registrar.
   FlutterDesktopPluginRegistrarRef GetRegistrar();
 
@@ -132,6 +149,21 @@ class FlutterELinuxEngine {
   // Gets the status whether Impeller is enabled.
   bool IsImpellerEnabled() const { return enable_impeller_; }
 
+  // Records the current time as the time of |phase| unless it has already
+  // been reached. Can be called on any thread.
+  void RecordStartupPhase(FlutterDesktopStartupPhase phase);
+
+  // Returns the time of |phase| in nanoseconds of CLOCK_MONOTONIC, or 0 if it
+  // hasn't been reached yet.
+  uint64_t GetStartupPhaseTime(FlutterDesktopStartupPhase phase) const {
+    return startup_phase_times_[phase];
+  }
+
+  // Sets |callback| to be called on the platform thread when the first frame
+  // has been presented.
+  void SetFirstFrameCallback(FlutterDesktopOnFirstFrameCallback callback,
+                             void* user_data);
+
   // Sets system settings.
   void SetSystemSettings(float text_scaling_factor, bool enable_high_contrast);
 
@@ -153,6 +185,17 @@ class FlutterELinuxEngine {
   // system changes.
   void SendSystemLocales();
 
+  // Loads the AOT data of the project. Can be called on any thread.
+  UniqueAotDataPtr LoadAotData();
+
+  // Creates a FlutterCompositor which presents through |compositor_|.
+  FlutterCompositor CreateCompositorConfig();
+
+  // Presents |layers| to the view of |view_id|. Called on the raster thread.
+  bool PresentView(FlutterViewId view_id,
+                   const FlutterLayer** layers,
+                   size_t layers_count);
+
   // The handle to the embedder.h engine instance.
   FLUTTER_API_SYMBOL(FlutterEngine) engine_ = nullptr;
 
@@ -160,12 +203,31 @@ class FlutterELinuxEngine {
 
   std::unique_ptr<FlutterProjectBundle> project_;
 
+  // Warms up the page cache for the startup, if enabled.
+  std::unique_ptr<StartupPrefetcher> prefetcher_;
+
   // AOT data, if any.
   UniqueAotDataPtr aot_data_;
 
+  // AOT data being loaded in the background since the engine was created,
+  // while the view brings up the display and EGL. Joined by
+  // RunWithEntrypoint().
+  std::future<UniqueAotDataPtr> aot_data_future_;
+
   // The view displaying the content running in this engine, if any.
   FlutterELinuxView* view_ = nullptr;
 
+  // All the views of this engine including |view_|, keyed by their view IDs.
+  // The raster thread looks them up to present the frames.
+  std::unordered_map<FlutterViewId, FlutterELinuxView*> views_;
+  std::mutex views_mutex_;
+
+  // The view ID for the next view added by AddView(). The implicit view is 0.
+  FlutterViewId next_view_id_ = 1;
+
+  // Composites the frames of the views if multiple views are enabled.
+  std::unique_ptr<Compositor> compositor_;
+
   // Task runner for tasks posted from the engine.
   std::unique_ptr<TaskRunner> task_runner_;
 
@@ -197,6 +259,13 @@ class FlutterELinuxEngine {
   std::unique_ptr<VsyncWaiter> vsync_waiter_;
 
   bool enable_impeller_ = false;
+
+  // The times of the startup phases, or 0 for the phases not reached yet.
+  std::array<std::atomic<uint64_t>, kStartupPhaseCount> startup_phase_times_;
+
+  // Called when kStartupPhaseFirstFramePresented is reached.
+  FlutterDesktopOnFirstFrameCallback first_frame_callback_ = nullptr;
+  void* first_frame_callback_user_data_ = nullptr;
 } SWIFT_UNSAFE_REFERENCE;
 
 }  // namespace flutter
@@ -41,8 +41,10 @@ FlutterELinuxView::FlutterELinuxView(
 
 FlutterELinuxView::~FlutterELinuxView() {
   // Need to stop running the Engine before destroying surface.
-  if (engine_) {
-    engine_->Stop();
+  if (owned_engine_) {
+    owned_engine_->Stop();
+  } else if (engine_) {
+    engine_->RemoveView(this);
   }
   DestroyRenderSurface();
 }
@@ -51,8 +53,25 @@ bool FlutterELinuxView::DispatchEvent() {
   return binding_handler_->DispatchEvent();
 }
 
+int FlutterELinuxView::GetEventFd() const {
+  return binding_handler_->GetEventFd();
+}
+
+bool FlutterELinuxView::HasPendingEvents() {
+  return binding_handler_->HasPendingEvents();
+}
+
+bool FlutterELinuxView::IsVsyncRequestSupported() const {
+  return binding_handler_->IsVsyncRequestSupported();
+}
+
+void FlutterELinuxView::RequestVsync() {
+  binding_handler_->RequestVsync();
+}
+
 void FlutterELinuxView::SetEngine(std::unique_ptr<FlutterELinuxEngine> engine) {
-  engine_ = std::move(engine);
+  owned_engine_ = std::move(engine);
+  engine_ = owned_engine_.get();
 
   engine_->SetView(this);
 
@@ -87,6 +106,15 @@ void FlutterELinuxView::SetEngine(std::unique_ptr<FlutterELinuxEngine> engine) {
                     binding_handler_->GetDpiScale());
 }
 
+bool FlutterELinuxView::AddToEngine(FlutterELinuxEngine* engine) {
+  engine_ = engine;
+  if (!CreateRenderSurface()) {
+    ELINUX_LOG(ERROR) << "Failed to create the surface of the view.";
+    return false;
+  }
+  return engine_->AddView(this);
+}
+
 void FlutterELinuxView::RegisterPlatformViewFactory(
     const char* view_type,
     std::unique_ptr<FlutterDesktopPlatformViewFactory> factory) {
@@ -95,7 +123,24 @@ void FlutterELinuxView::RegisterPlatformViewFactory(
 
 void FlutterELinuxView::OnWindowSizeChanged(size_t width_px,
                                             size_t height_px) const {
-  if (!GetRenderSurfaceTarget()->OnScreenSurfaceResize(width_px, height_px)) {
+  auto* software_surface = binding_handler_->GetSoftwareSurfaceTarget();
+#if defined(ENABLE_VULKAN)
+  auto* vulkan_surface = binding_handler_->GetVulkanSurfaceTarget();
+  if (vulkan_surface) {
+    if (!vulkan_surface->OnScreenSurfaceResize(width_px, height_px)) {
+      ELINUX_LOG(ERROR) << "Failed to change surface size.";
+      return;
+    }
+    SendWindowMetrics(width_px, height_px, binding_handler_->GetDpiScale());
+    return;
+  }
+#endif
+  const bool resized =
+      software_surface
+          ? software_surface->OnScreenSurfaceResize(width_px, height_px)
+          : GetRenderSurfaceTarget()->OnScreenSurfaceResize(width_px,
+                                                             height_px);
+  if (!resized) {
     ELINUX_LOG(ERROR) << "Failed to change surface size.";
     return;
   }
@@ -166,9 +211,7 @@ void FlutterELinuxView::OnTouchDown(uint32_t time,
       .scroll_delta_y = 0,
       .device_kind = kFlutterPointerDeviceKindTouch,
       .buttons = 0,
-      // TODO: Use the correct view ID for pointer events once the
-      // eLinux embedder supports multiple views.
-      .view_id = flutter::kFlutterImplicitViewId,
+      .view_id = view_id_,
   };
   engine_->SendPointerEvent(event);
 }
@@ -207,9 +250,7 @@ void FlutterELinuxView::OnTouchUp(uint32_t time, int32_t id) {
       .scroll_delta_y = 0,
       .device_kind = kFlutterPointerDeviceKindTouch,
       .buttons = 0,
-      // TODO: Use the correct view ID for pointer events once the
-      // eLinux embedder supports multiple views.
-      .view_id = flutter::kFlutterImplicitViewId,
+      .view_id = view_id_,
   };
   engine_->SendPointerEvent(event);
 }
@@ -254,9 +295,7 @@ void FlutterELinuxView::OnTouchMotion(uint32_t time,
       .scroll_delta_y = 0,
       .device_kind = kFlutterPointerDeviceKindTouch,
       .buttons = 0,
-      // TODO: Use the correct view ID for pointer events once the
-      // eLinux embedder supports multiple views.
-      .view_id = flutter::kFlutterImplicitViewId,
+      .view_id = view_id_,
   };
   engine_->SendPointerEvent(event);
 }
@@ -264,10 +303,18 @@ void FlutterELinuxView::OnTouchMotion(uint32_t time,
 void FlutterELinuxView::OnTouchCancel() {}
 
 void FlutterELinuxView::OnKeyMap(uint32_t format, int fd, uint32_t size) {
+  if (!IsImplicitView()) {
+    engine_->view()->OnKeyMap(format, fd, size);
+    return;
+  }
   keyboard_handler_->OnKeymap(format, fd, size);
 }
 
 void FlutterELinuxView::OnKey(uint32_t key, bool pressed) {
+  if (!IsImplicitView()) {
+    engine_->view()->OnKey(key, pressed);
+    return;
+  }
   keyboard_handler_->OnKey(key, pressed);
   if (pressed) {
     auto code_point = keyboard_handler_->GetCodePoint(key);
@@ -281,17 +328,30 @@ void FlutterELinuxView::OnKeyModifiers(uint32_t mods_depressed,
                                        uint32_t mods_latched,
                                        uint32_t mods_locked,
                                        uint32_t group) {
+  if (!IsImplicitView()) {
+    engine_->view()->OnKeyModifiers(mods_depressed, mods_latched, mods_locked,
+                                    group);
+    return;
+  }
   keyboard_handler_->OnModifiers(mods_depressed, mods_latched, mods_locked,
                                  group);
 }
 
 void FlutterELinuxView::OnVirtualKey(uint32_t code_point) {
+  if (!IsImplicitView()) {
+    engine_->view()->OnVirtualKey(code_point);
+    return;
+  }
   // Since the keycode cannot be specified, set an invalid value(0).
   constexpr uint32_t kCharKey = 0;
   textinput_handler_->OnKeyPressed(kCharKey, code_point);
 }
 
 void FlutterELinuxView::OnVirtualSpecialKey(uint32_t keycode) {
+  if (!IsImplicitView()) {
+    engine_->view()->OnVirtualSpecialKey(keycode);
+    return;
+  }
   auto code_point = keyboard_handler_->GetCodePoint(keycode);
   textinput_handler_->OnKeyPressed(keycode, code_point);
 }
@@ -306,8 +366,25 @@ void FlutterELinuxView::OnScroll(double x,
              scroll_offset_multiplier);
 }
 
+void FlutterELinuxView::OnWindowVisibilityChanged(bool visible) {
+  // The app lifecycle follows the implicit view.
+  if (!IsImplicitView()) {
+    return;
+  }
+  // The framework stops scheduling frames while the app is hidden.
+  if (visible) {
+    lifecycle_handler_->OnResumed();
+  } else {
+    lifecycle_handler_->OnHidden();
+  }
+}
+
 void FlutterELinuxView::OnVsync(uint64_t last_frame_time_nanos,
                                 uint64_t vsync_interval_time_nanos) {
+  // The frames of all the views are scheduled by the implicit view.
+  if (!IsImplicitView()) {
+    return;
+  }
   engine_->OnVsync(last_frame_time_nanos, vsync_interval_time_nanos);
 }
 
@@ -339,9 +416,21 @@ void FlutterELinuxView::SendWindowMetrics(size_t width_px,
   event.width = width_px;
   event.height = height_px;
   event.pixel_ratio = dpiScale;
+  event.view_id = view_id_;
   engine_->SendWindowMetricsEvent(event);
 }
 
+FlutterWindowMetricsEvent FlutterELinuxView::GetWindowMetrics() const {
+  PhysicalWindowBounds bounds = binding_handler_->GetPhysicalWindowBounds();
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = bounds.width;
+  event.height = bounds.height;
+  event.pixel_ratio = binding_handler_->GetDpiScale();
+  event.view_id = view_id_;
+  return event;
+}
+
 void FlutterELinuxView::SendInitialBounds() {
   PhysicalWindowBounds bounds = binding_handler_->GetPhysicalWindowBounds();
   SendWindowMetrics(bounds.width, bounds.height,
@@ -434,9 +523,7 @@ void FlutterELinuxView::SendPointerEventWithData(
   FlutterPointerEvent event = event_data;
   event.device_kind = kFlutterPointerDeviceKindMouse;
   event.buttons = mouse_state_.buttons;
-  // TODO: Use the correct view ID for pointer events once the
-  // eLinux embedder supports multiple views.
-  event.view_id = flutter::kFlutterImplicitViewId;
+  event.view_id = view_id_;
 
   // Set metadata that's always the same regardless of the event.
   event.struct_size = sizeof(event);
@@ -468,11 +555,14 @@ bool FlutterELinuxView::ClearCurrent() {
 }
 
 bool FlutterELinuxView::Present() {
-  return GetRenderSurfaceTarget()->GLContextPresent(0);
+  OnFrameRasterized();
+  return OnFramePresented(GetRenderSurfaceTarget()->GLContextPresent(0));
 }
 
 bool FlutterELinuxView::PresentWithInfo(const FlutterPresentInfo* info) {
-  return GetRenderSurfaceTarget()->GLContextPresentWithInfo(info);
+  OnFrameRasterized();
+  return OnFramePresented(
+      GetRenderSurfaceTarget()->GLContextPresentWithInfo(info));
 }
 
 void FlutterELinuxView::PopulateExistingDamage(const intptr_t fbo_id,
@@ -488,11 +578,81 @@ bool FlutterELinuxView::MakeResourceCurrent() {
   return GetRenderSurfaceTarget()->ResourceContextMakeCurrent();
 }
 
+bool FlutterELinuxView::PresentSoftwareBitmap(const void* allocation,
+                                              size_t row_bytes,
+                                              size_t height) {
+  auto* software_surface = binding_handler_->GetSoftwareSurfaceTarget();
+  if (!software_surface) {
+    return false;
+  }
+  OnFrameRasterized();
+  return OnFramePresented(
+      software_surface->Present(allocation, row_bytes, height));
+}
+
+#if defined(ENABLE_VULKAN)
+FlutterVulkanImage FlutterELinuxView::AcquireVulkanImage(
+    const FlutterFrameInfo* frame_info) {
+  auto* vulkan_surface = binding_handler_->GetVulkanSurfaceTarget();
+  if (!vulkan_surface) {
+    FlutterVulkanImage image = {};
+    image.struct_size = sizeof(FlutterVulkanImage);
+    return image;
+  }
+  auto image = vulkan_surface->AcquireImage(frame_info->size.width,
+                                            frame_info->size.height);
+  const auto extent = vulkan_surface->GetExtent();
+  if (!image.image && extent.width != 0 &&
+      (extent.width != frame_info->size.width ||
+       extent.height != frame_info->size.height)) {
+    // The frame is dropped. Have the next ones rendered in the size of the
+    // swapchain, which is the actual size of the window.
+    FlutterWindowMetricsEvent event = {};
+    event.struct_size = sizeof(event);
+    event.width = extent.width;
+    event.height = extent.height;
+    event.pixel_ratio = binding_handler_->GetDpiScale();
+    event.view_id = view_id_;
+    engine_->task_runner()->PostTask(
+        [engine = engine_, event]() { engine->SendWindowMetricsEvent(event); });
+  }
+  return image;
+}
+
+bool FlutterELinuxView::PresentVulkanImage(const FlutterVulkanImage* image) {
+  auto* vulkan_surface = binding_handler_->GetVulkanSurfaceTarget();
+  if (!vulkan_surface) {
+    return false;
+  }
+  OnFrameRasterized();
+  return OnFramePresented(vulkan_surface->Present(image));
+}
+#endif
+
 bool FlutterELinuxView::CreateRenderSurface() {
   PhysicalWindowBounds bounds = binding_handler_->GetPhysicalWindowBounds();
-  auto impeller_enable = engine_.get()->IsImpellerEnabled();
-  return binding_handler_->CreateRenderSurface(bounds.width, bounds.height,
-                                               impeller_enable);
+  auto impeller_enable = engine_->IsImpellerEnabled();
+  if (!binding_handler_->CreateRenderSurface(bounds.width, bounds.height,
+                                             impeller_enable)) {
+    return false;
+  }
+  if (IsImplicitView()) {
+    engine_->RecordStartupPhase(kStartupPhaseRenderSurfaceReady);
+  }
+  return true;
+}
+
+void FlutterELinuxView::OnFrameRasterized() {
+  if (IsImplicitView()) {
+    engine_->RecordStartupPhase(kStartupPhaseFirstFrameRasterized);
+  }
+}
+
+bool FlutterELinuxView::OnFramePresented(bool presented) {
+  if (presented && IsImplicitView()) {
+    engine_->RecordStartupPhase(kStartupPhaseFirstFramePresented);
+  }
+  return presented;
 }
 
 void FlutterELinuxView::DestroyRenderSurface() {
@@ -503,8 +663,18 @@ ELinuxRenderSurfaceTarget* FlutterELinuxView::GetRenderSurfaceTarget() const {
   return binding_handler_->GetRenderSurfaceTarget();
 }
 
+bool FlutterELinuxView::IsSoftwareRendering() const {
+  return binding_handler_->GetSoftwareSurfaceTarget() != nullptr;
+}
+
+#if defined(ENABLE_VULKAN)
+SurfaceVulkan* FlutterELinuxView::GetVulkanSurfaceTarget() const {
+  return binding_handler_->GetVulkanSurfaceTarget();
+}
+#endif
+
 FlutterELinuxEngine* FlutterELinuxView::GetEngine() {
-  return engine_.get();
+  return engine_;
 }
 
 int32_t FlutterELinuxView::GetFrameRate() {
@@ -512,7 +682,10 @@ int32_t FlutterELinuxView::GetFrameRate() {
 }
 
 FlutterTransformation FlutterELinuxView::GetRootSurfaceTransformation() {
-  auto degree = binding_handler_->GetRotationDegree();
+  // The pointer events still need to be rotated in GetPointerRotation().
+  auto degree = binding_handler_->IsRotationOffloaded()
+                    ? 0
+                    : binding_handler_->GetRotationDegree();
   if (view_rotation_degree_ != degree) {
     view_rotation_transformation_ = FlutterTransformationMake(degree);
   }
@@ -556,6 +729,9 @@ std::pair<double, double> FlutterELinuxView::GetPointerRotation(double x_px,
 }
 
 void FlutterELinuxView::UpdateHighContrastEnabled(bool enabled) {
+  if (!IsImplicitView()) {
+    return;
+  }
   int flags = 0;
   if (enabled) {
     flags |=
@@ -564,12 +740,15 @@ void FlutterELinuxView::UpdateHighContrastEnabled(bool enabled) {
     flags &=
         ~FlutterAccessibilityFeature::kFlutterAccessibilityFeatureHighContrast;
   }
-  engine_.get()->UpdateAccessibilityFeatures(
+  engine_->UpdateAccessibilityFeatures(
       static_cast<FlutterAccessibilityFeature>(flags));
   settings_handler_->UpdateHighContrastMode(enabled);
 }
 
 void FlutterELinuxView::UpdateTextScaleFactor(float factor) {
+  if (!IsImplicitView()) {
+    return;
+  }
   settings_handler_->UpdateTextScaleFactor(factor);
 }
 
@@ -577,6 +756,10 @@ void FlutterELinuxView::UpdateDisplayInfo(double refresh_rate,
                                           size_t width_px,
                                           size_t height_px,
                                           double pixel_ratio) {
+  // The engine is told about the display of the implicit view.
+  if (!IsImplicitView()) {
+    return;
+  }
   const FlutterEngineDisplaysUpdateType update_type =
       kFlutterEngineDisplaysUpdateTypeStartup;
   const FlutterEngineDisplay displays = {
@@ -589,7 +772,7 @@ void FlutterELinuxView::UpdateDisplayInfo(double refresh_rate,
       .device_pixel_ratio = pixel_ratio,
   };
   const size_t display_count = 1;
-  engine_.get()->UpdateDisplayInfo(update_type, &displays, display_count);
+  engine_->UpdateDisplayInfo(update_type, &displays, display_count);
 }
 
 }  // namespace flutter
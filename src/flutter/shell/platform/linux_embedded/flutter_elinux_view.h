@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "flutter/common/constants.h"
 #include "flutter/shell/platform/common/client_wrapper/include/flutter/plugin_registrar.h"
 #include "flutter/shell/platform/embedder/embedder.h"
 #include "flutter/shell/platform/linux_embedded/flutter_elinux_engine.h"
@@ -43,10 +44,40 @@ class FlutterELinuxView : public WindowBindingHandlerDelegate {
   // you have to call this every time in the main loop.
   bool DispatchEvent();
 
+  // Returns a file descriptor which becomes readable when there are events to
+  // be dispatched, or -1 if not supported by the backend.
+  int GetEventFd() const;
+
+  // Returns true if there are events to be dispatched that don't make the fd
+  // of GetEventFd() readable.
+  bool HasPendingEvents();
+
+  // Returns true if the window delivers a vsync after each RequestVsync().
+  bool IsVsyncRequestSupported() const;
+
+  // Requests a vsync from the window. Can be called on any thread.
+  void RequestVsync();
+
   // Configures the window instance with an instance of a running Flutter
   // engine.
   void SetEngine(std::unique_ptr<FlutterELinuxEngine> engine);
 
+  // Creates the rendering surface and adds this view to the running |engine|,
+  // which is owned by its implicit view. The engine's internal plugins are
+  // kept by the implicit view, and the keyboard inputs are forwarded to it.
+  //
+  // Returns false if the view couldn't be added.
+  bool AddToEngine(FlutterELinuxEngine* engine);
+
+  // Returns the view ID given by the engine.
+  FlutterViewId view_id() const { return view_id_; }
+
+  // Sets the view ID. Called by the engine when the view is added.
+  void SetViewId(FlutterViewId view_id) { view_id_ = view_id; }
+
+  // Returns the current window metrics of this view.
+  FlutterWindowMetricsEvent GetWindowMetrics() const;
+
   // Registers a factory of the platform view.
   void RegisterPlatformViewFactory(
       const char* view_type,
@@ -62,6 +93,15 @@ class FlutterELinuxView : public WindowBindingHandlerDelegate {
   // Return the currently configured ELinuxRenderSurfaceTarget.
   ELinuxRenderSurfaceTarget* GetRenderSurfaceTarget() const;
 
+  // Returns true if the view renders with the software renderer.
+  bool IsSoftwareRendering() const;
+
+#if defined(ENABLE_VULKAN)
+  // Returns the surface of the Vulkan renderer, or nullptr if the view renders
+  // with another renderer.
+  SurfaceVulkan* GetVulkanSurfaceTarget() const;
+#endif
+
   // Returns the FlutterTransformation of this view.
   FlutterTransformation GetRootSurfaceTransformation();
 
@@ -82,6 +122,17 @@ class FlutterELinuxView : public WindowBindingHandlerDelegate {
   uint32_t GetOnscreenFBO();
   bool MakeResourceCurrent();
 
+  // Callback for presenting a frame of the software renderer.
+  bool PresentSoftwareBitmap(const void* allocation,
+                             size_t row_bytes,
+                             size_t height);
+
+#if defined(ENABLE_VULKAN)
+  // Callbacks for acquiring and presenting a frame of the Vulkan renderer.
+  FlutterVulkanImage AcquireVulkanImage(const FlutterFrameInfo* frame_info);
+  bool PresentVulkanImage(const FlutterVulkanImage* image);
+#endif
+
   // Send initial bounds to embedder.  Must occur after engine has initialized.
   void SendInitialBounds();
 
@@ -141,6 +192,9 @@ class FlutterELinuxView : public WindowBindingHandlerDelegate {
                 double delta_y,
                 int scroll_offset_multiplier) override;
 
+  // |WindowBindingHandlerDelegate|
+  void OnWindowVisibilityChanged(bool visible) override;
+
   // |WindowBindingHandlerDelegate|
   void OnVsync(uint64_t frame_start_time_nanos,
                uint64_t frame_target_time_nanos) override;
@@ -273,8 +327,23 @@ class FlutterELinuxView : public WindowBindingHandlerDelegate {
   // @param[in] y_px The y coordinate of the pointer event in physical pixels.
   std::pair<double, double> GetPointerRotation(double x_px, double y_px);
 
+  // Returns true if this view owns the engine and its internal plugins.
+  bool IsImplicitView() const { return owned_engine_ != nullptr; }
+
+  // Record the startup phases of the first frame of the implicit view. Called
+  // before and after passing a frame to the surface. OnFramePresented()
+  // returns |presented|, the result of the surface.
+  void OnFrameRasterized();
+  bool OnFramePresented(bool presented);
+
+  // The engine owned by this view if it's the implicit view.
+  std::unique_ptr<FlutterELinuxEngine> owned_engine_;
+
   // The engine associated with this view.
-  std::unique_ptr<FlutterELinuxEngine> engine_;
+  FlutterELinuxEngine* engine_ = nullptr;
+
+  // The ID of this view in the engine.
+  FlutterViewId view_id_ = kFlutterImplicitViewId;
 
   // Keeps track of mouse state in relation to the window.
   MouseState mouse_state_;
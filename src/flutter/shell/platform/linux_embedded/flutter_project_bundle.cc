@@ -38,6 +38,23 @@ FlutterProjectBundle::FlutterProjectBundle(
     dart_entrypoint_arguments_.push_back(
         std::string(properties.dart_entrypoint_argv[i]));
   }
+  multi_view_enabled_ = properties.enable_multi_view;
+  startup_prefetch_enabled_ = properties.enable_startup_prefetch;
+  if (properties.prefetch_assets_list_path != nullptr) {
+    prefetch_assets_list_path_ =
+        ConvertWcharToString(properties.prefetch_assets_list_path);
+  }
+  aot_huge_pages_enabled_ = properties.enable_aot_huge_pages;
+  if (properties.persistent_cache_path != nullptr) {
+    persistent_cache_path_ =
+        ConvertWcharToString(properties.persistent_cache_path);
+  }
+  if (properties.persistent_cache_seed_path != nullptr) {
+    persistent_cache_seed_path_ =
+        ConvertWcharToString(properties.persistent_cache_seed_path);
+  }
+  persistent_cache_max_size_ = properties.persistent_cache_max_size;
+  is_persistent_cache_read_only_ = properties.is_persistent_cache_read_only;
 
   // Resolve any relative paths.
   std::string project_path;
@@ -57,6 +74,15 @@ FlutterProjectBundle::FlutterProjectBundle(
       }
     }
   }
+  for (auto* path : {&prefetch_assets_list_path_, &persistent_cache_path_,
+                     &persistent_cache_seed_path_}) {
+    if (!path->empty() && path->compare(0, 1, "/") != 0) {
+      auto executable_location = GetExecutableDirectory();
+      if (!executable_location.empty()) {
+        *path = executable_location + "/" + *path;
+      }
+    }
+  }
 }
 
 bool FlutterProjectBundle::HasValidPaths() {
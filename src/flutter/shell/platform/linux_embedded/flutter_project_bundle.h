@@ -42,6 +42,9 @@ class FlutterProjectBundle {
   // Returns the path to the ICU data file.
   const std::string& icu_path() { return icu_path_; }
 
+  // Returns the path to the AOT library file, if any.
+  const std::string& aot_library_path() { return aot_library_path_; }
+
   // Returns any switches that should be passed to the engine.
   const std::vector<std::string> GetSwitches();
 
@@ -60,6 +63,41 @@ class FlutterProjectBundle {
     return dart_entrypoint_arguments_;
   }
 
+  // Returns true if the engine can have additional views.
+  bool multi_view_enabled() const { return multi_view_enabled_; }
+
+  // Returns true if the files read at startup should be prefetched.
+  bool startup_prefetch_enabled() const { return startup_prefetch_enabled_; }
+
+  // Returns the path to the list of the assets to prefetch, if any.
+  const std::string& prefetch_assets_list_path() const {
+    return prefetch_assets_list_path_;
+  }
+
+  // Returns true if the AOT code should be backed with huge pages.
+  bool aot_huge_pages_enabled() const { return aot_huge_pages_enabled_; }
+
+  // Returns the path to the persistent cache directory, if any.
+  const std::string& persistent_cache_path() const {
+    return persistent_cache_path_;
+  }
+
+  // Returns the path to the bundled cache seeding the persistent cache, if
+  // any.
+  const std::string& persistent_cache_seed_path() const {
+    return persistent_cache_seed_path_;
+  }
+
+  // Returns the size limit of the persistent cache, or 0 for no limit.
+  size_t persistent_cache_max_size() const {
+    return persistent_cache_max_size_;
+  }
+
+  // Returns true if the engine must not write into the persistent cache.
+  bool is_persistent_cache_read_only() const {
+    return is_persistent_cache_read_only_;
+  }
+
  private:
   // Returns the execuable directory path.
   const std::string GetExecutableDirectory();
@@ -75,6 +113,17 @@ class FlutterProjectBundle {
 
   // Engine switches.
   std::vector<std::string> engine_switches_;
+
+  bool multi_view_enabled_ = false;
+
+  bool startup_prefetch_enabled_ = false;
+  std::string prefetch_assets_list_path_;
+  bool aot_huge_pages_enabled_ = false;
+
+  std::string persistent_cache_path_;
+  std::string persistent_cache_seed_path_;
+  size_t persistent_cache_max_size_ = 0;
+  bool is_persistent_cache_read_only_ = false;
 };
 
 }  // namespace flutter
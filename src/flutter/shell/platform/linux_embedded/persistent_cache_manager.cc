@@ -0,0 +1,209 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/persistent_cache_manager.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "flutter/shell/platform/linux_embedded/file_utils.h"
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+// The subdirectory of the configured path the cache is kept in.
+constexpr char kCacheDirectoryName[] = "flutter_elinux_cache";
+
+// The file stamping the cache directory with the build key.
+constexpr char kBuildKeyFileName[] = ".elinux_build_key";
+
+constexpr char kEngineLibraryName[] = "/libflutter_engine.so";
+
+// Returns the names of the entries in |dir| except "." and "..".
+std::vector<std::string> ListEntries(const std::string& dir) {
+  std::vector<std::string> names;
+  auto* stream = opendir(dir.c_str());
+  if (!stream) {
+    return names;
+  }
+  while (auto* entry = readdir(stream)) {
+    const std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      names.push_back(name);
+    }
+  }
+  closedir(stream);
+  return names;
+}
+
+// Removes everything in |dir| but |dir| itself.
+void RemoveContents(const std::string& dir) {
+  for (const auto& name : ListEntries(dir)) {
+    const auto path = dir + "/" + name;
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) {
+      continue;
+    }
+    if (S_ISDIR(st.st_mode)) {
+      RemoveContents(path);
+      rmdir(path.c_str());
+    } else {
+      unlink(path.c_str());
+    }
+  }
+}
+
+// Returns true if |dir| has no entries.
+bool IsEmpty(const std::string& dir) {
+  return ListEntries(dir).empty();
+}
+
+// Copies the contents of |src| into |dst|, which must exist.
+bool CopyContents(const std::string& src, const std::string& dst) {
+  for (const auto& name : ListEntries(src)) {
+    const auto src_path = src + "/" + name;
+    const auto dst_path = dst + "/" + name;
+    struct stat st;
+    if (stat(src_path.c_str(), &st) != 0) {
+      return false;
+    }
+    if (S_ISDIR(st.st_mode)) {
+      if ((mkdir(dst_path.c_str(), 0755) != 0 && errno != EEXIST) ||
+          !CopyContents(src_path, dst_path)) {
+        return false;
+      }
+    } else if (S_ISREG(st.st_mode)) {
+      std::ifstream in(src_path, std::ios::binary);
+      std::ofstream out(dst_path, std::ios::binary | std::ios::trunc);
+      if (!in || !(out << in.rdbuf())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Creates |path| and its missing parents.
+bool MakeDirectories(const std::string& path) {
+  size_t pos = 0;
+  do {
+    pos = path.find('/', pos + 1);
+    const auto dir = path.substr(0, pos);
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+      return false;
+    }
+  } while (pos != std::string::npos);
+  return true;
+}
+
+// Returns the path to the engine library mapped in this process, if any.
+std::string GetEngineLibraryPath() {
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  const std::string name = kEngineLibraryName;
+  while (std::getline(maps, line)) {
+    const auto pos = line.find('/');
+    if (pos != std::string::npos && line.size() >= name.size() &&
+        line.compare(line.size() - name.size(), name.size(), name) == 0) {
+      return line.substr(pos);
+    }
+  }
+  return "";
+}
+}  // namespace
+
+PersistentCacheManager::PersistentCacheManager(const std::string& path,
+                                               const std::string& seed_path,
+                                               size_t max_size)
+    : cache_path_(path + "/" + kCacheDirectoryName),
+      seed_path_(seed_path),
+      max_size_(max_size) {}
+
+bool PersistentCacheManager::Prepare(const std::string& app_path) {
+  if (!MakeDirectories(cache_path_)) {
+    ELINUX_LOG(WARNING) << "Failed to create the persistent cache directory "
+                        << cache_path_;
+    return false;
+  }
+
+  const auto key_path = cache_path_ + "/" + kBuildKeyFileName;
+  const auto build_key = GetBuildKey(app_path);
+  std::ifstream key_file(key_path);
+  std::string cached_key;
+  const bool has_key = static_cast<bool>(std::getline(key_file, cached_key));
+  if (!has_key || cached_key != build_key) {
+    // Only a cache stamped with another build is known to be stale. Files
+    // without the stamp are left as they are.
+    if (has_key) {
+      ELINUX_LOG(DEBUG) << "Clearing the persistent cache of another build.";
+      RemoveContents(cache_path_);
+    }
+    // Start over from the bundled cache.
+    if (!seed_path_.empty() && IsEmpty(cache_path_)) {
+      if (CopyContents(seed_path_, cache_path_)) {
+        ELINUX_LOG(DEBUG) << "Seeded the persistent cache from " << seed_path_;
+      } else {
+        ELINUX_LOG(WARNING) << "Failed to seed the persistent cache from "
+                            << seed_path_;
+        RemoveContents(cache_path_);
+      }
+    }
+    std::ofstream new_key_file(key_path, std::ios::trunc);
+    if (!(new_key_file << build_key << "\n")) {
+      ELINUX_LOG(WARNING) << "Failed to write " << key_path;
+    }
+  }
+
+  if (max_size_ > 0) {
+    Trim();
+  }
+  return true;
+}
+
+std::string PersistentCacheManager::GetBuildKey(
+    const std::string& app_path) const {
+  return "engine:" + GetFileStamp(GetEngineLibraryPath()) +
+         " app:" + GetFileStamp(app_path);
+}
+
+void PersistentCacheManager::Trim() const {
+  std::vector<FileInfo> files;
+  ListFiles(cache_path_, files);
+  size_t total_size = 0;
+  for (const auto& file : files) {
+    total_size += file.size;
+  }
+  if (total_size <= max_size_) {
+    return;
+  }
+
+  std::sort(files.begin(), files.end(),
+            [](const FileInfo& a, const FileInfo& b) {
+              return a.mtime < b.mtime;
+            });
+  const auto key_path = cache_path_ + "/" + kBuildKeyFileName;
+  int evicted = 0;
+  for (const auto& file : files) {
+    if (total_size <= max_size_) {
+      break;
+    }
+    if (file.path == key_path || unlink(file.path.c_str()) != 0) {
+      continue;
+    }
+    total_size -= file.size;
+    evicted++;
+  }
+  ELINUX_LOG(DEBUG) << "Evicted " << evicted
+                    << " files from the persistent cache.";
+}
+
+}  // namespace flutter
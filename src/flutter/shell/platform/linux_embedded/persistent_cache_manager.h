@@ -0,0 +1,61 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_PERSISTENT_CACHE_MANAGER_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_PERSISTENT_CACHE_MANAGER_H_
+
+#include <cstddef>
+#include <string>
+
+namespace flutter {
+
+// Manages the directory the engine persists its compiled shaders in across
+// runs (FlutterProjectArgs::persistent_cache_path).
+//
+// The cache is kept in a subdirectory of the configured path which only this
+// class writes to, so that the other files there are never touched. The
+// subdirectory is stamped with the builds of the engine and the app, and is
+// cleared when either of them changes, since the cached shaders are tied to
+// them. A cache captured beforehand, e.g. on a reference device of the same
+// model, can be bundled with the app to seed the directory, so that the
+// shaders are never compiled on the user's first interaction.
+class PersistentCacheManager {
+ public:
+  // |path| is the configured directory, which the cache is kept in a
+  // subdirectory of. |seed_path| is the directory of the bundled cache, if
+  // any. |max_size| is the size limit of the cache in bytes, or 0 for no
+  // limit.
+  PersistentCacheManager(const std::string& path,
+                         const std::string& seed_path,
+                         size_t max_size);
+  ~PersistentCacheManager() = default;
+
+  // Prevent copying.
+  PersistentCacheManager(PersistentCacheManager const&) = delete;
+  PersistentCacheManager& operator=(PersistentCacheManager const&) = delete;
+
+  // Returns the directory of the cache, which the engine is given.
+  const std::string& cache_path() const { return cache_path_; }
+
+  // Prepares the cache directory for a run of the app whose code is at
+  // |app_path|, i.e. the AOT library or the kernel blob. Returns false if the
+  // directory can't be used.
+  bool Prepare(const std::string& app_path);
+
+ private:
+  // Returns the key identifying the builds of the engine and the app.
+  std::string GetBuildKey(const std::string& app_path) const;
+
+  // Evicts the least recently written files until the cache fits in
+  // |max_size_|.
+  void Trim() const;
+
+  std::string cache_path_;
+  std::string seed_path_;
+  size_t max_size_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_PERSISTENT_CACHE_MANAGER_H_
@@ -0,0 +1,166 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/persistent_cache_manager.h"
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+constexpr char kCacheDirectoryName[] = "/flutter_elinux_cache";
+constexpr char kBuildKeyFileName[] = "/.elinux_build_key";
+
+void WriteFile(const std::string& path, const std::string& contents) {
+  std::ofstream file(path, std::ios::trunc);
+  file << contents;
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+bool Exists(const std::string& path) {
+  return access(path.c_str(), F_OK) == 0;
+}
+
+// Sets the modification time of the file at |path| to |seconds| since the
+// epoch.
+void SetModificationTime(const std::string& path, time_t seconds) {
+  const timeval times[2] = {{seconds, 0}, {seconds, 0}};
+  utimes(path.c_str(), times);
+}
+
+// Provides a temporary directory holding the configured cache path, the
+// bundled cache and the app.
+class PersistentCacheManagerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char dir[] = "/tmp/flutter_elinux_cache_test_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    root_ = dir;
+    path_ = root_ + "/cache";
+    seed_path_ = root_ + "/seed";
+    app_path_ = root_ + "/app.so";
+    cache_path_ = path_ + kCacheDirectoryName;
+    ASSERT_EQ(mkdir(path_.c_str(), 0755), 0);
+    ASSERT_EQ(mkdir(seed_path_.c_str(), 0755), 0);
+    ASSERT_EQ(mkdir((seed_path_ + "/skia").c_str(), 0755), 0);
+    WriteFile(seed_path_ + "/skia/shader", "seeded");
+    WriteFile(app_path_, "app");
+  }
+
+  void TearDown() override {
+    const auto command = "rm -rf " + root_;
+    system(command.c_str());
+  }
+
+  std::string root_;
+  std::string path_;
+  std::string seed_path_;
+  std::string app_path_;
+  std::string cache_path_;
+};
+}  // namespace
+
+TEST_F(PersistentCacheManagerTest, KeepsTheCacheInItsOwnDirectory) {
+  WriteFile(path_ + "/settings", "app");
+  PersistentCacheManager manager(path_, "", 0);
+  EXPECT_EQ(manager.cache_path(), cache_path_);
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  EXPECT_TRUE(Exists(cache_path_ + kBuildKeyFileName));
+
+  // The other files of the configured directory survive an update of the app.
+  WriteFile(app_path_, "updated app");
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  EXPECT_EQ(ReadFile(path_ + "/settings"), "app");
+}
+
+TEST_F(PersistentCacheManagerTest, CreatesMissingDirectories) {
+  PersistentCacheManager manager(root_ + "/a/b", "", 0);
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  EXPECT_TRUE(Exists(root_ + "/a/b" + kCacheDirectoryName + kBuildKeyFileName));
+}
+
+TEST_F(PersistentCacheManagerTest, SeedsAnEmptyCache) {
+  PersistentCacheManager manager(path_, seed_path_, 0);
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  EXPECT_EQ(ReadFile(cache_path_ + "/skia/shader"), "seeded");
+}
+
+TEST_F(PersistentCacheManagerTest, KeepsTheCacheOfTheSameBuild) {
+  PersistentCacheManager manager(path_, seed_path_, 0);
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  WriteFile(cache_path_ + "/skia/shader", "compiled");
+  WriteFile(cache_path_ + "/skia/other", "compiled");
+
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  EXPECT_EQ(ReadFile(cache_path_ + "/skia/shader"), "compiled");
+  EXPECT_EQ(ReadFile(cache_path_ + "/skia/other"), "compiled");
+}
+
+TEST_F(PersistentCacheManagerTest, ClearsTheCacheOfAnotherBuild) {
+  PersistentCacheManager manager(path_, seed_path_, 0);
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  const auto key = ReadFile(cache_path_ + kBuildKeyFileName);
+  WriteFile(cache_path_ + "/skia/shader", "compiled");
+  WriteFile(cache_path_ + "/skia/other", "compiled");
+
+  // The size of the app is part of the build key.
+  WriteFile(app_path_, "updated app");
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  EXPECT_NE(ReadFile(cache_path_ + kBuildKeyFileName), key);
+  EXPECT_EQ(ReadFile(cache_path_ + "/skia/shader"), "seeded");
+  EXPECT_FALSE(Exists(cache_path_ + "/skia/other"));
+}
+
+TEST_F(PersistentCacheManagerTest, KeepsFilesWithoutTheBuildKey) {
+  ASSERT_EQ(mkdir(cache_path_.c_str(), 0755), 0);
+  WriteFile(cache_path_ + "/shader", "unknown");
+
+  PersistentCacheManager manager(path_, seed_path_, 0);
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  EXPECT_EQ(ReadFile(cache_path_ + "/shader"), "unknown");
+  EXPECT_TRUE(Exists(cache_path_ + kBuildKeyFileName));
+  // A non-empty cache isn't seeded.
+  EXPECT_FALSE(Exists(cache_path_ + "/skia/shader"));
+}
+
+TEST_F(PersistentCacheManagerTest, EvictsTheOldestFilesOverTheLimit) {
+  PersistentCacheManager unlimited(path_, "", 0);
+  ASSERT_TRUE(unlimited.Prepare(app_path_));
+  const auto key_path = cache_path_ + kBuildKeyFileName;
+  WriteFile(cache_path_ + "/old", std::string(100, 'o'));
+  WriteFile(cache_path_ + "/middle", std::string(100, 'm'));
+  WriteFile(cache_path_ + "/new", std::string(100, 'n'));
+  SetModificationTime(key_path, 1000);
+  SetModificationTime(cache_path_ + "/old", 2000);
+  SetModificationTime(cache_path_ + "/middle", 3000);
+  SetModificationTime(cache_path_ + "/new", 4000);
+
+  // The key file, even though it's the oldest, and the newest files fit.
+  const auto key_size = ReadFile(key_path).size();
+  PersistentCacheManager manager(path_, "", key_size + 200);
+  ASSERT_TRUE(manager.Prepare(app_path_));
+  EXPECT_TRUE(Exists(key_path));
+  EXPECT_FALSE(Exists(cache_path_ + "/old"));
+  EXPECT_TRUE(Exists(cache_path_ + "/middle"));
+  EXPECT_TRUE(Exists(cache_path_ + "/new"));
+}
+
+}  // namespace testing
+}  // namespace flutter
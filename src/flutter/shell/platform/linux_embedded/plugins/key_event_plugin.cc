@@ -32,29 +32,34 @@ constexpr char kGLFWKey[] = "glfw";
 constexpr char kKeyUp[] = "keyup";
 constexpr char kKeyDown[] = "keydown";
 
+#if defined(USE_XKBCOMMON)
 constexpr char kKeyboardConfigFile[] = "/etc/default/keyboard";
 constexpr char kXkbmodelKey[] = "XKBMODEL";
 constexpr char kXkblayoutKey[] = "XKBLAYOUT";
 constexpr char kXkbvariantKey[] = "XKBVARIANT";
 constexpr char kXkboptionsKey[] = "XKBOPTIONS";
+#endif
 }  // namespace
 
+#if defined(USE_XKBCOMMON)
 KeyeventPlugin::KeyeventPlugin(BinaryMessenger* messenger)
     : channel_(std::make_unique<BasicMessageChannel<rapidjson::Document>>(
           messenger,
           kChannelName,
           &flutter::JsonMessageCodec::GetInstance())),
       xkb_context_(xkb_context_new(XKB_CONTEXT_NO_FLAGS)) {
-#if defined(DISPLAY_BACKEND_TYPE_WAYLAND)
   xkb_keymap_ = nullptr;
   xkb_state_ = nullptr;
-#else
-  xkb_keymap_ = CreateKeymap(xkb_context_);
-  xkb_state_ = xkb_state_new(xkb_keymap_);
+#if !defined(DISPLAY_BACKEND_TYPE_WAYLAND)
+  // Compiling the keymap takes tens of milliseconds, and it isn't needed until
+  // the first key event.
+  keymap_future_ = std::async(std::launch::async,
+                              [this]() { return CreateKeymap(xkb_context_); });
 #endif
 }
 
 KeyeventPlugin::~KeyeventPlugin() {
+  WaitForKeymap();
   xkb_context_unref(xkb_context_);
   xkb_keymap_unref(xkb_keymap_);
   xkb_state_unref(xkb_state_);
@@ -78,11 +83,13 @@ void KeyeventPlugin::OnKeymap(uint32_t format, uint32_t fd, uint32_t size) {
 }
 
 uint32_t KeyeventPlugin::GetCodePoint(uint32_t keycode) {
+  WaitForKeymap();
   auto sym = xkb_state_key_get_one_sym(xkb_state_, keycode + 8);
   return xkb_keysym_to_utf32(sym);
 }
 
 bool KeyeventPlugin::IsTextInputSuppressed(uint32_t code_point) {
+  WaitForKeymap();
   if (code_point) {
     auto ctrl_key_index =
         xkb_keymap_mod_get_index(xkb_keymap_, XKB_MOD_NAME_CTRL);
@@ -96,6 +103,7 @@ bool KeyeventPlugin::IsTextInputSuppressed(uint32_t code_point) {
 }
 
 void KeyeventPlugin::OnKey(uint32_t keycode, bool pressed) {
+  WaitForKeymap();
 #if !defined(DISPLAY_BACKEND_TYPE_WAYLAND)
   // We cannot get notifications of modifier keys when we use the DRM/X11
   // backends. In this case, we need to handle it by using xkb_state_update_key.
@@ -117,6 +125,39 @@ void KeyeventPlugin::OnModifiers(uint32_t mods_depressed,
       xkb_state_serialize_mods(xkb_state_, XKB_STATE_MODS_EFFECTIVE);
 }
 
+#else
+KeyeventPlugin::KeyeventPlugin(BinaryMessenger* messenger)
+    : channel_(std::make_unique<BasicMessageChannel<rapidjson::Document>>(
+          messenger,
+          kChannelName,
+          &flutter::JsonMessageCodec::GetInstance())) {}
+
+KeyeventPlugin::~KeyeventPlugin() = default;
+
+void KeyeventPlugin::OnKeymap(uint32_t format, uint32_t fd, uint32_t size) {
+  close(fd);
+}
+
+uint32_t KeyeventPlugin::GetCodePoint(uint32_t keycode) {
+  return 0;
+}
+
+bool KeyeventPlugin::IsTextInputSuppressed(uint32_t code_point) {
+  return false;
+}
+
+void KeyeventPlugin::OnKey(uint32_t keycode, bool pressed) {
+  constexpr uint32_t kUnicode = 0;
+  constexpr uint32_t kModifiers = 0;
+  SendKeyEvent(GetGlfwKeycode(keycode), kUnicode, kModifiers, pressed);
+}
+
+void KeyeventPlugin::OnModifiers(uint32_t mods_depressed,
+                                 uint32_t mods_latched,
+                                 uint32_t mods_locked,
+                                 uint32_t group) {}
+#endif
+
 void KeyeventPlugin::SendKeyEvent(uint32_t keycode,
                                   uint32_t unicode,
                                   uint32_t modifiers,
@@ -139,6 +180,7 @@ void KeyeventPlugin::SendKeyEvent(uint32_t keycode,
   channel_->Send(event);
 }
 
+#if defined(USE_XKBCOMMON)
 void KeyeventPlugin::OnModifiers(uint32_t keycode, bool pressed) {
   xkb_state_update_key(xkb_state_, keycode + 8,
                        pressed ? XKB_KEY_DOWN : XKB_KEY_UP);
@@ -174,6 +216,14 @@ xkb_keymap* KeyeventPlugin::CreateKeymap(xkb_context* context) {
                                    XKB_KEYMAP_COMPILE_NO_FLAGS);
 }
 
+void KeyeventPlugin::WaitForKeymap() {
+  if (!keymap_future_.valid()) {
+    return;
+  }
+  xkb_keymap_ = keymap_future_.get();
+  xkb_state_ = xkb_state_new(xkb_keymap_);
+}
+
 std::unordered_map<std::string, std::string> KeyeventPlugin::GetKeyboardConfig(
     std::string filename) {
   std::unordered_map<std::string, std::string> map;
@@ -198,5 +248,6 @@ std::unordered_map<std::string, std::string> KeyeventPlugin::GetKeyboardConfig(
   free(pattern);
   return map;
 }
+#endif
 
 }  // namespace flutter
@@ -6,8 +6,11 @@
 #define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_PLUGINS_KEY_EVENT_PLUGIN_H_
 
 #include <rapidjson/document.h>
+#if defined(USE_XKBCOMMON)
 #include <xkbcommon/xkbcommon.h>
+#endif
 
+#include <future>
 #include <memory>
 #include <unordered_map>
 
@@ -16,6 +19,9 @@
 
 namespace flutter {
 
+// Sends the key events to the framework. Without xkbcommon, which is optional
+// for the headless backend, the events have neither the code points nor the
+// modifiers.
 class KeyeventPlugin {
  public:
   KeyeventPlugin(BinaryMessenger* messenger);
@@ -39,16 +45,27 @@ class KeyeventPlugin {
                     uint32_t unicode,
                     uint32_t modifiers,
                     bool pressed);
+#if defined(USE_XKBCOMMON)
   void OnModifiers(uint32_t keycode, bool pressed);
   xkb_keymap* CreateKeymap(xkb_context* context);
+  // Waits for the keymap compiled in the background, if any.
+  void WaitForKeymap();
   std::unordered_map<std::string, std::string> GetKeyboardConfig(
       std::string filename);
 
+#endif
+
   std::unique_ptr<BasicMessageChannel<rapidjson::Document>> channel_;
+#if defined(USE_XKBCOMMON)
   xkb_context* xkb_context_;
   xkb_state* xkb_state_;
   xkb_keymap* xkb_keymap_;
   xkb_mod_mask_t xkb_mods_mask_;
+
+  // The keymap being compiled from the keyboard config while the engine
+  // starts up. |xkb_context_| isn't used elsewhere until it's ready.
+  std::future<xkb_keymap*> keymap_future_;
+#endif
 };
 
 }  // namespace flutter
@@ -146,6 +146,7 @@ constexpr uint32_t kGlfwKeyRightSuper = 347;
 constexpr uint32_t kGlfwKeyMenu = 348;
 }  // namespace
 
+#if defined(USE_XKBCOMMON)
 uint32_t GetGlfwModifiers(xkb_keymap* xkb_keymap,
                           xkb_mod_mask_t& xkb_mod_mask) {
   const xkb_mod_mask_t xkb_shift_key =
@@ -182,6 +183,7 @@ uint32_t GetGlfwModifiers(xkb_keymap* xkb_keymap,
   }
   return mods;
 }
+#endif
 
 uint32_t GetGlfwKeycode(uint32_t xkb_keycode) {
   static const std::unordered_map<uint32_t, uint32_t> keycode_to_glfwkey_map = {
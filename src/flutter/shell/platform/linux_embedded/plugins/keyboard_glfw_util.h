@@ -5,12 +5,18 @@
 #ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_PLUGINS_KEYBOARD_GLFW_UTIL_H_
 #define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_PLUGINS_KEYBOARD_GLFW_UTIL_H_
 
+#include <cstdint>
+
+#if defined(USE_XKBCOMMON)
 #include <xkbcommon/xkbcommon.h>
+#endif
 
 namespace flutter {
 
+#if defined(USE_XKBCOMMON)
 // Converts modifiers for xkb to modifiers for GLFW.
 uint32_t GetGlfwModifiers(xkb_keymap* xkb_keymap, xkb_mod_mask_t& xkb_mod_mask);
+#endif
 
 // Converts xkb keycode to GLFW keycode.
 uint32_t GetGlfwKeycode(uint32_t xkb_keycode);
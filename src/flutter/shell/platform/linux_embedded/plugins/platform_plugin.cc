@@ -63,14 +63,18 @@ void PlatformPlugin::HandleMethodCall(
       return;
     }
 
-    auto clipboardData = delegate_->GetClipboardData();
-    rapidjson::Document document;
-    document.SetObject();
-    rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
-    document.AddMember(rapidjson::Value(kTextKey, allocator),
-                       rapidjson::Value(clipboardData.c_str(), allocator),
-                       allocator);
-    result->Success(document);
+    // The data may arrive after this method returns, so the result is
+    // shared with the callback.
+    std::shared_ptr<flutter::MethodResult<rapidjson::Document>> shared_result =
+        std::move(result);
+    delegate_->GetClipboardData([shared_result](const std::string& data) {
+      rapidjson::Document document;
+      document.SetObject();
+      rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
+      document.AddMember(rapidjson::Value(kTextKey, allocator),
+                         rapidjson::Value(data.c_str(), allocator), allocator);
+      shared_result->Success(document);
+    });
   } else if (method.compare(kSetClipboardDataMethod) == 0) {
     const rapidjson::Value& document = *method_call.arguments();
     rapidjson::Value::ConstMemberIterator itr = document.FindMember(kTextKey);
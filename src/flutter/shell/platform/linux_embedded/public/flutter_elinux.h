@@ -52,8 +52,60 @@ typedef struct {
   // Array of Dart entrypoint arguments. This is deep copied during the call
   // to FlutterDesktopEngineCreate.
   const char** dart_entrypoint_argv;
+
+  // Enables additional views of the engine, see
+  // FlutterDesktopEngineCreateViewController. The frames are then composited
+  // by the embedder, which disables the partial repaint of the first view.
+  bool enable_multi_view;
+
+  // Prefetches the AOT library and the ICU data into the page cache in the
+  // background when the engine is created, which shortens the startup from
+  // slow storage.
+  bool enable_startup_prefetch;
+
+  // The path to a file listing the assets to prefetch as well, if any. The
+  // assets in the page cache once the first frame has been presented are
+  // recorded into it, so the next startups prefetch the assets read by the
+  // previous ones. The list is recorded again when the app is updated, or
+  // when it's deleted. This can either be an absolute path or a path relative
+  // to the directory containing the executable.
+  const wchar_t* prefetch_assets_list_path;
+
+  // Asks the kernel to back the code of the AOT library with transparent huge
+  // pages, which reduces the TLB misses. Needs a kernel with
+  // CONFIG_READ_ONLY_THP_FOR_FS.
+  bool enable_aot_huge_pages;
+
+  // The path to the directory the engine persists its compiled shaders in
+  // across runs, if any. The shaders are kept in its "flutter_elinux_cache"
+  // subdirectory, which is cleared when the engine or the app is updated, and
+  // the other files in the directory are never touched. This can either be an
+  // absolute path or a path relative to the directory containing the
+  // executable.
+  const wchar_t* persistent_cache_path;
+
+  // The path to a shader cache bundled with the app, if any, which is copied
+  // into the persistent cache directory when it's empty or cleared. This is
+  // typically the "flutter_elinux_cache" directory captured on a reference
+  // device.
+  // This can either be an absolute path or a path relative to the directory
+  // containing the executable.
+  const wchar_t* persistent_cache_seed_path;
+
+  // The size limit of the persistent cache in bytes, or 0 for no limit. The
+  // least recently written shaders are evicted at startup to fit in it.
+  size_t persistent_cache_max_size;
+
+  // If true, the engine only reads the persistent cache and never writes new
+  // shaders into it, e.g. on a read-only file system. The cache isn't seeded,
+  // cleared nor trimmed either.
+  bool is_persistent_cache_read_only;
 } FlutterDesktopEngineProperties;
 
+// The identifier of a view of an engine. The view created by
+// FlutterDesktopViewControllerCreate is the implicit view, whose ID is 0.
+typedef int64_t FlutterDesktopViewId;
+
 // The View display mode.
 enum FlutterDesktopViewMode {
   // Shows the Flutter view by user specific size.
@@ -74,6 +126,37 @@ enum FlutterDesktopViewRotation {
   kRotation_270 = 3,
 };
 
+// The color buffer format of the View.
+enum FlutterDesktopColorFormat {
+  // 8-bit RGB. The alpha component depends on the build option
+  // ENABLE_EGL_ALPHA_COMPONENT_OF_COLOR_BUFFER and `opaque`.
+  kColorFormatDefault = 0,
+  // 16 bits per pixel without alpha. Halves the memory bandwidth of the
+  // frame buffers at the cost of color depth.
+  kColorFormatRGB565 = 1,
+  // 8-bit RGB without alpha.
+  kColorFormatXRGB8888 = 2,
+  // 8-bit RGB with 8-bit alpha.
+  kColorFormatARGB8888 = 3,
+  // 10-bit RGB without alpha.
+  kColorFormatXRGB2101010 = 4,
+  // 10-bit RGB with 2-bit alpha.
+  kColorFormatARGB2101010 = 5,
+};
+
+// The renderer of the View.
+enum FlutterDesktopRendererType {
+  // Renders with OpenGL ES through EGL.
+  kRendererOpenGL = 0,
+  // Renders on the CPU and presents the frames through shared memory buffers
+  // (DRM dumb buffers, wl_shm or MIT-SHM). For devices without a usable GPU.
+  kRendererSoftware = 1,
+  // Renders with Vulkan and presents the frames with a Vulkan swapchain. Falls
+  // back to OpenGL ES if no Vulkan device can present to the window, or if the
+  // embedder is built without ENABLE_VULKAN.
+  kRendererVulkan = 2,
+};
+
 // Properties for configuring a Flutter view instance.
 typedef struct {
   // View width in logical pixels.
@@ -120,6 +203,38 @@ typedef struct {
   // True:  Sync to compositor redraw/v-blank  (eglSwapInterval 1)
   // False: Do not sync to compositor redraw/v-blank (eglSwapInterval 0)
   bool enable_vsync;
+
+  // Declares that the view has no transparent pixels. The color buffer is
+  // allocated without alpha and the compositor is told that the window is
+  // opaque, so that it can skip blending and the windows beneath.
+  // This option is only active for Wayland backend.
+  bool opaque;
+
+  // Enable low-latency mode. Frames are presented as soon as they are ready
+  // instead of at the next v-blank, at the cost of tearing (eglSwapInterval 0
+  // and the async presentation hint of the tearing-control protocol).
+  // This option is only active for Wayland backend in kFullscreen mode.
+  bool enable_low_latency;
+
+  // Color buffer format. If the platform has no matching buffer format, the
+  // closest one is used.
+  FlutterDesktopColorFormat color_format;
+
+  // Minimum bits of the depth and the stencil buffers. 0 means no depth or
+  // stencil buffer is needed (Impeller always uses an 8-bit stencil buffer).
+  int32_t depth_size;
+  int32_t stencil_size;
+
+  // Number of samples per pixel for MSAA. 0 uses the renderer's default, i.e.
+  // 4x MSAA for Impeller if available and no MSAA for Skia. 1 disables MSAA.
+  int32_t sample_count;
+
+  // Renderer of the view. The software renderer doesn't support Impeller,
+  // external textures, window decorations and rotations which the display
+  // can't perform. The color buffer is always 8-bit RGB. The Vulkan renderer
+  // doesn't support external textures, window decorations and rotations, and
+  // ignores the EGL config properties.
+  FlutterDesktopRendererType renderer_type;
 } FlutterDesktopViewProperties;
 
 // ========== View Controller ==========
@@ -159,12 +274,97 @@ FLUTTER_EXPORT FlutterDesktopEngineRef FlutterDesktopViewControllerGetEngine(
 FLUTTER_EXPORT FlutterDesktopViewRef
 FlutterDesktopViewControllerGetView(FlutterDesktopViewControllerRef controller);
 
+// Returns the ID of the view managed by the given controller, which is passed
+// to the Dart code as FlutterView.viewId.
+FLUTTER_EXPORT FlutterDesktopViewId FlutterDesktopViewControllerGetViewId(
+    FlutterDesktopViewControllerRef controller);
+
 FLUTTER_EXPORT bool FlutterDesktopViewDispatchEvent(FlutterDesktopViewRef view);
 
+// Returns a file descriptor which becomes readable when the view has events to
+// be dispatched with FlutterDesktopViewDispatchEvent, or -1 if the backend
+// doesn't provide one. The main loop may poll it instead of sleeping.
+FLUTTER_EXPORT int FlutterDesktopViewGetEventFd(FlutterDesktopViewRef view);
+
+// Returns true if the view has events to be dispatched which don't make the
+// fd of FlutterDesktopViewGetEventFd readable, e.g. X11 events already read
+// from the connection by another thread. Check it before polling the fd.
+FLUTTER_EXPORT bool FlutterDesktopViewHasPendingEvents(
+    FlutterDesktopViewRef view);
+
 // Returns the display frame rate by the given controller.
 FLUTTER_EXPORT int32_t
 FlutterDesktopViewGetFrameRate(FlutterDesktopViewRef view);
 
+// ========== Input injection ==========
+
+// Injects input events into the view as if they came from the display
+// backend, e.g. to drive the HEADLESS backend in automated tests and
+// benchmarks. The coordinates are in physical pixels. These must be called on
+// the thread running the main loop.
+
+// The mouse buttons. The values match FlutterPointerMouseButtons.
+typedef enum {
+  kPointerButtonPrimary = 1 << 0,
+  kPointerButtonSecondary = 1 << 1,
+  kPointerButtonMiddle = 1 << 2,
+  kPointerButtonBack = 1 << 3,
+  kPointerButtonForward = 1 << 4,
+} FlutterDesktopPointerButton;
+
+// Moves the mouse pointer to (|x|, |y|).
+FLUTTER_EXPORT void FlutterDesktopViewInjectPointerMove(
+    FlutterDesktopViewRef view,
+    double x,
+    double y);
+
+// Presses or releases |button| of the mouse at (|x|, |y|).
+FLUTTER_EXPORT void FlutterDesktopViewInjectPointerButton(
+    FlutterDesktopViewRef view,
+    double x,
+    double y,
+    FlutterDesktopPointerButton button,
+    bool pressed);
+
+// Moves the mouse pointer out of the view.
+FLUTTER_EXPORT void FlutterDesktopViewInjectPointerLeave(
+    FlutterDesktopViewRef view);
+
+// Scrolls by (|delta_x|, |delta_y|) pixels with the mouse at (|x|, |y|).
+FLUTTER_EXPORT void FlutterDesktopViewInjectScroll(FlutterDesktopViewRef view,
+                                                   double x,
+                                                   double y,
+                                                   double delta_x,
+                                                   double delta_y);
+
+// Puts the touch point |id| down at (|x|, |y|). |time| is a monotonically
+// increasing timestamp in milliseconds.
+FLUTTER_EXPORT void FlutterDesktopViewInjectTouchDown(
+    FlutterDesktopViewRef view,
+    uint32_t time,
+    int32_t id,
+    double x,
+    double y);
+
+// Moves the touch point |id| to (|x|, |y|).
+FLUTTER_EXPORT void FlutterDesktopViewInjectTouchMotion(
+    FlutterDesktopViewRef view,
+    uint32_t time,
+    int32_t id,
+    double x,
+    double y);
+
+// Lifts the touch point |id|.
+FLUTTER_EXPORT void FlutterDesktopViewInjectTouchUp(FlutterDesktopViewRef view,
+                                                    uint32_t time,
+                                                    int32_t id);
+
+// Presses or releases the key of the Linux input event code |keycode| (e.g.
+// KEY_A), which is mapped with the default keymap.
+FLUTTER_EXPORT void FlutterDesktopViewInjectKey(FlutterDesktopViewRef view,
+                                                uint32_t keycode,
+                                                bool pressed);
+
 // ========== Engine ==========
 
 // Creates a Flutter engine with the given properties.
@@ -204,6 +404,70 @@ FlutterDesktopEngineProcessMessages(FlutterDesktopEngineRef engine);
 FLUTTER_EXPORT void FlutterDesktopEngineReloadSystemFonts(
     FlutterDesktopEngineRef engine);
 
+// Creates an additional view of the running |engine|, which shares the Dart
+// isolate, the GPU context and the caches of the engine with its other views.
+//
+// |engine| must have been created with `enable_multi_view` and be owned by the
+// view controller of its first view. The frames of the additional views are
+// rendered by the engine's renderer, so `renderer_type` and `enable_vsync` are
+// ignored. With OpenGL ES, they're presented through EGL surfaces of their
+// own, whose contexts share the textures of the engine's context when the
+// windows share the native display (X11, headless and DRM-EGLStream) and the
+// EGL config properties with the first view. Otherwise the frames are read
+// back and uploaded to the contexts of the windows. With the software
+// renderer, they're presented through shared memory buffers. They are rotated
+// like the first view, and their keyboard inputs go to the text input and the
+// key event handlers of the first view.
+//
+// The caller owns the returned reference, and is responsible for calling
+// FlutterDesktopViewControllerDestroy before destroying the view controller of
+// the first view. Returns a null pointer in the event of an error.
+FLUTTER_EXPORT FlutterDesktopViewControllerRef
+FlutterDesktopEngineCreateViewController(
+    FlutterDesktopEngineRef engine,
+    const FlutterDesktopViewProperties* view_properties);
+
+// The startup phases recorded by the engine, in the order they're usually
+// reached.
+typedef enum {
+  // The process has started.
+  kStartupPhaseProcessStart = 0,
+  // The display backend of the first view has been initialized.
+  kStartupPhaseDisplayInitialized,
+  // The render surface of the first view (e.g. the EGL context) is ready.
+  kStartupPhaseRenderSurfaceReady,
+  // The AOT library has been loaded. Not reached in JIT mode.
+  kStartupPhaseAotLoaded,
+  // The engine is running.
+  kStartupPhaseEngineRunning,
+  // The first frame of the first view has been rasterized.
+  kStartupPhaseFirstFrameRasterized,
+  // The first frame of the first view has been handed to the display, i.e.
+  // the swap (e.g. eglSwapBuffers) has returned. No presentation feedback is
+  // used, so the frame usually appears on the screen a v-blank or a
+  // compositor repaint later.
+  kStartupPhaseFirstFramePresented,
+  kStartupPhaseCount,
+} FlutterDesktopStartupPhase;
+
+// Returns the time when |engine| reached |phase| in nanoseconds of
+// CLOCK_MONOTONIC, or 0 if it hasn't been reached yet.
+FLUTTER_EXPORT uint64_t
+FlutterDesktopEngineGetStartupPhaseTime(FlutterDesktopEngineRef engine,
+                                        FlutterDesktopStartupPhase phase);
+
+// A callback for the first frame presented by an engine.
+typedef void (*FlutterDesktopOnFirstFrameCallback)(void* user_data);
+
+// Sets |callback| to be called with |user_data| on the platform thread once
+// the first frame of the first view of |engine| has been presented, i.e. when
+// kStartupPhaseFirstFramePresented is reached after the swap has returned. It
+// isn't called if the frame has already been presented.
+FLUTTER_EXPORT void FlutterDesktopEngineSetFirstFrameCallback(
+    FlutterDesktopEngineRef engine,
+    FlutterDesktopOnFirstFrameCallback callback,
+    void* user_data);
+
 // Returns the plugin registrar handle for the plugin with the given name.
 //
 // The name must be unique across the application.
@@ -0,0 +1,280 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/startup_prefetcher.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "flutter/shell/platform/linux_embedded/file_utils.h"
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+// The prefix of the header of the assets list, which is followed by the stamp
+// of the app.
+constexpr char kAssetsListHeaderPrefix[] = "# app ";
+
+// The size of the transparent huge pages when it can't be read from sysfs,
+// which is the PMD size of x86-64 and arm64 with 4KiB pages.
+constexpr uintptr_t kDefaultHugePageSize = 2 * 1024 * 1024;
+
+// Starts reading the whole file at |path| into the page cache without waiting
+// for it. Returns false if the file can't be opened.
+bool PrefetchFile(const std::string& path) {
+  auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return false;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  close(fd);
+  return true;
+}
+
+// Returns true if the first page of the file at |path| is in the page cache.
+bool IsInPageCache(const std::string& path) {
+  auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  // Since Linux 5.2, mincore() only reports the page cache of a file to the
+  // processes which own it or may write to it. Otherwise, it only reports
+  // the pages mapped by this process, i.e. none.
+  if (st.st_uid == geteuid() ||
+      faccessat(AT_FDCWD, path.c_str(), W_OK, AT_EACCESS) == 0) {
+    const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto* page = mmap(nullptr, page_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (page == MAP_FAILED) {
+      return false;
+    }
+    unsigned char residency = 0;
+    const bool cached =
+        mincore(page, page_size, &residency) == 0 && (residency & 1);
+    munmap(page, page_size);
+    return cached;
+  }
+
+  // Try to read the page without waiting for the storage instead. Note that
+  // a miss still starts the readahead of the page, so the assets not read
+  // at startup are read once here, though they aren't recorded.
+  char byte;
+  struct iovec iov = {&byte, sizeof(byte)};
+  const auto result = preadv2(fd, &iov, 1, 0, RWF_NOWAIT);
+  close(fd);
+  return result == sizeof(byte);
+}
+
+// Returns true if |path| is relative and stays inside the directory it's
+// relative to.
+bool IsContainedPath(const std::string& path) {
+  if (path.empty() || path[0] == '/') {
+    return false;
+  }
+  std::istringstream components(path);
+  std::string component;
+  while (std::getline(components, component, '/')) {
+    if (component == "..") {
+      return false;
+    }
+  }
+  return true;
+}
+
+uintptr_t GetHugePageSize() {
+  std::ifstream file("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+  uintptr_t size = 0;
+  if (!(file >> size) || size == 0) {
+    return kDefaultHugePageSize;
+  }
+  return size;
+}
+}  // namespace
+
+StartupPrefetcher::StartupPrefetcher(const std::string& aot_library_path,
+                                     const std::string& icu_path,
+                                     const std::string& assets_path,
+                                     const std::string& assets_list_path)
+    : aot_library_path_(aot_library_path),
+      icu_path_(icu_path),
+      assets_path_(assets_path),
+      assets_list_path_(assets_list_path),
+      assets_list_header_(GetAssetsListHeader(
+          aot_library_path.empty() ? assets_path + "/kernel_blob.bin"
+                                   : aot_library_path)) {}
+
+StartupPrefetcher::~StartupPrefetcher() {
+  if (prefetch_future_.valid()) {
+    prefetch_future_.wait();
+  }
+  if (record_future_.valid()) {
+    record_future_.wait();
+  }
+}
+
+void StartupPrefetcher::Prefetch() {
+  prefetch_future_ = std::async(std::launch::async, [this]() {
+    // In the order the engine reads them.
+    if (!aot_library_path_.empty()) {
+      PrefetchFile(aot_library_path_);
+    }
+    PrefetchFile(icu_path_);
+    int prefetched = 0;
+    for (const auto& path : ReadAssetsList()) {
+      if (PrefetchFile(assets_path_ + "/" + path)) {
+        prefetched++;
+      }
+    }
+    ELINUX_LOG(DEBUG) << "Prefetched " << prefetched << " assets.";
+  });
+}
+
+void StartupPrefetcher::RecordAssets() {
+  if (assets_list_path_.empty() || record_future_.valid()) {
+    return;
+  }
+  record_future_ = std::async(std::launch::async, [this]() {
+    if (IsAssetsListCurrent()) {
+      return;
+    }
+    WriteAssetsList();
+  });
+}
+
+std::string StartupPrefetcher::GetAssetsListHeader(
+    const std::string& app_path) {
+  return kAssetsListHeaderPrefix + GetFileStamp(app_path);
+}
+
+bool StartupPrefetcher::ParseAssetsList(std::istream& list,
+                                        const std::string& header,
+                                        std::vector<std::string>& paths) {
+  std::string line;
+  if (!std::getline(list, line) || line != header) {
+    return false;
+  }
+  while (std::getline(list, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    if (!IsContainedPath(line)) {
+      ELINUX_LOG(WARNING) << "Ignored an asset outside the assets: " << line;
+      continue;
+    }
+    paths.push_back(line);
+  }
+  return true;
+}
+
+void StartupPrefetcher::AdviseHugePages(const std::string& path) {
+  char resolved_path[PATH_MAX];
+  if (!realpath(path.c_str(), resolved_path)) {
+    ELINUX_LOG(WARNING) << "Failed to resolve " << path;
+    return;
+  }
+
+  const auto huge_page_size = GetHugePageSize();
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  int advised = 0;
+  while (std::getline(maps, line)) {
+    // e.g. "7f5a200000-7f5a600000 r-xp 00200000 b3:02 1234 /usr/lib/libapp.so"
+    std::istringstream fields(line);
+    std::string range, perms, offset, device, inode, mapped_path;
+    fields >> range >> perms >> offset >> device >> inode;
+    std::getline(fields >> std::ws, mapped_path);
+    if (perms.find('x') == std::string::npos || mapped_path != resolved_path) {
+      continue;
+    }
+
+    unsigned long start, end;
+    if (std::sscanf(range.c_str(), "%lx-%lx", &start, &end) != 2) {
+      continue;
+    }
+    // Only the huge pages fully inside the mapping can be collapsed.
+    start = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+    end &= ~(huge_page_size - 1);
+    if (start >= end) {
+      continue;
+    }
+    if (madvise(reinterpret_cast<void*>(start), end - start, MADV_HUGEPAGE) !=
+        0) {
+      ELINUX_LOG(WARNING) << "Failed to advise huge pages for " << path;
+      return;
+    }
+    advised++;
+  }
+  if (advised == 0) {
+    ELINUX_LOG(DEBUG) << "No huge pages fit in the code of " << path;
+  }
+}
+
+std::vector<std::string> StartupPrefetcher::ReadAssetsList() const {
+  std::vector<std::string> paths;
+  if (assets_list_path_.empty()) {
+    return paths;
+  }
+  std::ifstream file(assets_list_path_);
+  if (file && !ParseAssetsList(file, assets_list_header_, paths)) {
+    ELINUX_LOG(DEBUG) << "The assets list is of another build of the app.";
+  }
+  return paths;
+}
+
+bool StartupPrefetcher::IsAssetsListCurrent() const {
+  std::ifstream file(assets_list_path_);
+  std::string header;
+  return std::getline(file, header) && header == assets_list_header_;
+}
+
+void StartupPrefetcher::WriteAssetsList() const {
+  std::vector<FileInfo> files;
+  ListFiles(assets_path_, files);
+
+  // Written to a temporary file first, so that an interrupted write doesn't
+  // leave a partial list behind.
+  const auto temp_path = assets_list_path_ + ".tmp";
+  std::ofstream file(temp_path, std::ios::trunc);
+  if (!file) {
+    ELINUX_LOG(WARNING) << "Failed to write " << temp_path;
+    return;
+  }
+  file << assets_list_header_ << "\n";
+  int recorded = 0;
+  for (const auto& asset : files) {
+    if (IsInPageCache(asset.path)) {
+      // Relative to the assets directory.
+      file << asset.path.substr(assets_path_.size() + 1) << "\n";
+      recorded++;
+    }
+  }
+  file.close();
+  if (!file || std::rename(temp_path.c_str(), assets_list_path_.c_str()) != 0) {
+    ELINUX_LOG(WARNING) << "Failed to write " << assets_list_path_;
+    std::remove(temp_path.c_str());
+    return;
+  }
+  ELINUX_LOG(DEBUG) << "Recorded " << recorded << " assets to prefetch.";
+}
+
+}  // namespace flutter
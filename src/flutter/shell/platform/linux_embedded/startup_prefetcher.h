@@ -0,0 +1,82 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_STARTUP_PREFETCHER_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_STARTUP_PREFETCHER_H_
+
+#include <future>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace flutter {
+
+// Warms up the page cache with the files read while the engine starts, so
+// that a cold startup from slow storage (e.g. eMMC) isn't bound by the page
+// faults of the AOT snapshot, the ICU data and the assets.
+//
+// The assets to prefetch are listed in a file, which is recorded from the
+// assets found in the page cache once the first frame has been presented. The
+// list starts with a header naming the build of the app it was recorded for,
+// and is recorded again when the app is updated.
+class StartupPrefetcher {
+ public:
+  StartupPrefetcher(const std::string& aot_library_path,
+                    const std::string& icu_path,
+                    const std::string& assets_path,
+                    const std::string& assets_list_path);
+  ~StartupPrefetcher();
+
+  // Prevent copying.
+  StartupPrefetcher(StartupPrefetcher const&) = delete;
+  StartupPrefetcher& operator=(StartupPrefetcher const&) = delete;
+
+  // Starts reading the AOT library, the ICU data and the listed assets into
+  // the page cache in the background.
+  void Prefetch();
+
+  // Records the assets in the page cache into the assets list in the
+  // background, if there is no list for this build of the app yet.
+  void RecordAssets();
+
+  // Returns the header of the assets list of the app whose code is at
+  // |app_path|, i.e. the AOT library or the kernel blob.
+  static std::string GetAssetsListHeader(const std::string& app_path);
+
+  // Reads the paths of the assets, relative to the assets directory, from
+  // |list| into |paths|. Returns false without reading them if the list
+  // doesn't start with |header|, i.e. it was recorded for another build.
+  static bool ParseAssetsList(std::istream& list,
+                              const std::string& header,
+                              std::vector<std::string>& paths);
+
+  // Advises the kernel to back the executable mappings of the library at
+  // |path| with transparent huge pages. Must be called after the library has
+  // been loaded.
+  static void AdviseHugePages(const std::string& path);
+
+ private:
+  // Returns the paths of the assets relative to |assets_path_|, or none if
+  // the list is missing or stale.
+  std::vector<std::string> ReadAssetsList() const;
+
+  // Returns true if the list exists and was recorded for this build.
+  bool IsAssetsListCurrent() const;
+
+  // Writes the paths of the assets in the page cache to |assets_list_path_|.
+  void WriteAssetsList() const;
+
+  std::string aot_library_path_;
+  std::string icu_path_;
+  std::string assets_path_;
+  std::string assets_list_path_;
+  std::string assets_list_header_;
+
+  std::future<void> prefetch_future_;
+  std::future<void> record_future_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_STARTUP_PREFETCHER_H_
@@ -0,0 +1,131 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/startup_prefetcher.h"
+
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+constexpr char kHeader[] = "# app 100-1000";
+
+void WriteFile(const std::string& path, const std::string& contents) {
+  std::ofstream file(path, std::ios::trunc);
+  file << contents;
+}
+
+std::string ReadFirstLine(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+bool Parse(const std::string& list, std::vector<std::string>& paths) {
+  std::istringstream stream(list);
+  return StartupPrefetcher::ParseAssetsList(stream, kHeader, paths);
+}
+}  // namespace
+
+TEST(StartupPrefetcherTest, ParsesTheAssetsOfTheList) {
+  std::vector<std::string> paths;
+  ASSERT_TRUE(Parse(std::string(kHeader) +
+                        "\n"
+                        "AssetManifest.bin\n"
+                        "\n"
+                        "# A comment.\n"
+                        "fonts/MaterialIcons-Regular.otf\r\n",
+                    paths));
+  ASSERT_EQ(paths.size(), 2u);
+  EXPECT_EQ(paths[0], "AssetManifest.bin");
+  EXPECT_EQ(paths[1], "fonts/MaterialIcons-Regular.otf");
+}
+
+TEST(StartupPrefetcherTest, IgnoresPathsOutsideTheAssets) {
+  std::vector<std::string> paths;
+  ASSERT_TRUE(Parse(std::string(kHeader) +
+                        "\n"
+                        "/etc/passwd\n"
+                        "../libapp.so\n"
+                        "fonts/../../libapp.so\n"
+                        "fonts/..font\n",
+                    paths));
+  ASSERT_EQ(paths.size(), 1u);
+  EXPECT_EQ(paths[0], "fonts/..font");
+}
+
+TEST(StartupPrefetcherTest, RejectsTheListOfAnotherBuild) {
+  std::vector<std::string> paths;
+  EXPECT_FALSE(Parse("# app 200-1000\nAssetManifest.bin\n", paths));
+  EXPECT_TRUE(paths.empty());
+  // A list without a header, e.g. written by hand, is stale too.
+  EXPECT_FALSE(Parse("AssetManifest.bin\n", paths));
+  EXPECT_FALSE(Parse("", paths));
+  EXPECT_TRUE(paths.empty());
+}
+
+TEST(StartupPrefetcherTest, HeaderChangesWithTheBuildOfTheApp) {
+  char dir[] = "/tmp/flutter_elinux_prefetch_test_XXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  const std::string app_path = std::string(dir) + "/libapp.so";
+
+  const auto missing_header = StartupPrefetcher::GetAssetsListHeader(app_path);
+  WriteFile(app_path, "app");
+  const auto header = StartupPrefetcher::GetAssetsListHeader(app_path);
+  EXPECT_NE(header, missing_header);
+  EXPECT_EQ(StartupPrefetcher::GetAssetsListHeader(app_path), header);
+  WriteFile(app_path, "updated app");
+  EXPECT_NE(StartupPrefetcher::GetAssetsListHeader(app_path), header);
+
+  const auto command = std::string("rm -rf ") + dir;
+  system(command.c_str());
+}
+
+TEST(StartupPrefetcherTest, RecordsTheListAgainForAnotherBuild) {
+  char dir[] = "/tmp/flutter_elinux_prefetch_test_XXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  const std::string root = dir;
+  const auto app_path = root + "/libapp.so";
+  const auto assets_path = root + "/flutter_assets";
+  const auto list_path = root + "/assets.list";
+  ASSERT_EQ(mkdir(assets_path.c_str(), 0755), 0);
+  WriteFile(assets_path + "/AssetManifest.bin", "manifest");
+  WriteFile(app_path, "app");
+  WriteFile(list_path, "# app 0-0\nAssetManifest.bin\n");
+
+  {
+    StartupPrefetcher prefetcher(app_path, "", assets_path, list_path);
+    prefetcher.RecordAssets();
+  }
+  const auto header = StartupPrefetcher::GetAssetsListHeader(app_path);
+  EXPECT_EQ(ReadFirstLine(list_path), header);
+
+  // The list of the current build is kept.
+  WriteFile(list_path, header + "\nkept\n");
+  {
+    StartupPrefetcher prefetcher(app_path, "", assets_path, list_path);
+    prefetcher.RecordAssets();
+  }
+  std::ifstream list(list_path);
+  std::vector<std::string> paths;
+  ASSERT_TRUE(StartupPrefetcher::ParseAssetsList(list, header, paths));
+  ASSERT_EQ(paths.size(), 1u);
+  EXPECT_EQ(paths[0], "kept");
+
+  const auto command = "rm -rf " + root;
+  system(command.c_str());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,93 +4,83 @@
 
 #include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
 #include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/egl_share_group.h"
 #include "flutter/shell/platform/linux_embedded/surface/egl_utils.h"
 
 namespace flutter {
 
+namespace {
+// Impeller needs a stencil buffer and prefers 4x MSAA.
+constexpr EGLint kImpellerStencilSize = 8;
+constexpr EGLint kImpellerSamples = 4;
+
+// Returns how far |config| is from |config_attributes|. Smaller is better:
+// a config rendering to the native visual comes first, then one with the
+// exact color sizes, then one with the closest number of samples.
+std::tuple<bool, EGLint, EGLint> GetConfigDistance(
+    EGLDisplay display,
+    EGLConfig config,
+    const EglConfigAttributes& config_attributes,
+    EGLint samples) {
+  auto get_attrib = [display, config](EGLint attribute) {
+    EGLint value = 0;
+    eglGetConfigAttrib(display, config, attribute, &value);
+    return value;
+  };
+
+  const bool visual_mismatch =
+      config_attributes.native_visual_id != 0 &&
+      get_attrib(EGL_NATIVE_VISUAL_ID) != config_attributes.native_visual_id;
+  const EGLint color_distance =
+      std::abs(get_attrib(EGL_RED_SIZE) - config_attributes.red_size) +
+      std::abs(get_attrib(EGL_GREEN_SIZE) - config_attributes.green_size) +
+      std::abs(get_attrib(EGL_BLUE_SIZE) - config_attributes.blue_size) +
+      std::abs(get_attrib(EGL_ALPHA_SIZE) - config_attributes.alpha_size);
+  const EGLint samples_distance = std::abs(get_attrib(EGL_SAMPLES) - samples);
+  return {visual_mismatch, color_distance, samples_distance};
+}
+}  // namespace
+
 ContextEgl::ContextEgl(std::unique_ptr<EnvironmentEgl> environment,
                        bool enable_impeller,
-                       EGLint egl_surface_type)
+                       EGLint egl_surface_type,
+                       const EglConfigAttributes& config_attributes)
     : environment_(std::move(environment)), config_(nullptr) {
-  EGLint config_count = 0;
-  const EGLint attribs[] = {
-      // clang-format off
-    EGL_SURFACE_TYPE,    egl_surface_type,
-    EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
-    EGL_RED_SIZE,        8,
-    EGL_GREEN_SIZE,      8,
-    EGL_BLUE_SIZE,       8,
-#if defined(ENABLE_EGL_ALPHA_COMPONENT_OF_COLOR_BUFFER)
-    EGL_ALPHA_SIZE,      8,
-#endif
-    EGL_DEPTH_SIZE,      0,
-    EGL_STENCIL_SIZE,    0,
-    EGL_NONE
-      // clang-format on
-  };
-  const EGLint impeller_config_attributes[] = {
-      // clang-format off
-    EGL_RED_SIZE,        8,
-    EGL_GREEN_SIZE,      8,
-    EGL_BLUE_SIZE,       8,
-#if defined(ENABLE_EGL_ALPHA_COMPONENT_OF_COLOR_BUFFER)
-    EGL_ALPHA_SIZE,      8,
-#endif
-    EGL_DEPTH_SIZE,      0,
-    EGL_STENCIL_SIZE,    8,
-    EGL_SAMPLE_BUFFERS,  1,
-    EGL_SAMPLES,         4,
-    EGL_NONE
-      // clang-format on
-  };
-  const EGLint impeller_config_attributes_no_msaa[] = {
-      // clang-format off
-    EGL_RED_SIZE,        8,
-    EGL_GREEN_SIZE,      8,
-    EGL_BLUE_SIZE,       8,
-#if defined(ENABLE_EGL_ALPHA_COMPONENT_OF_COLOR_BUFFER)
-    EGL_ALPHA_SIZE,      8,
-#endif
-    EGL_DEPTH_SIZE,      0,
-    EGL_STENCIL_SIZE,    8,
-    EGL_NONE
-      // clang-format on
-  };
-
+  EglConfigAttributes attributes = config_attributes;
   if (enable_impeller) {
-    // First try the MSAA configuration.
-    if ((eglChooseConfig(environment_->Display(), impeller_config_attributes,
-                         &config_, 1, &config_count) == EGL_FALSE) ||
-        (config_count == 0)) {
-      // Next fall back to disabled MSAA.
-      if ((eglChooseConfig(environment_->Display(),
-                           impeller_config_attributes_no_msaa, &config_, 1,
-                           &config_count) == EGL_FALSE) ||
-          (config_count == 0)) {
-        ELINUX_LOG(ERROR) << "Failed to choose EGL surface config: "
-                          << get_egl_error_cause();
-        return;
-      }
-    }
-  } else {
-    if (eglChooseConfig(environment_->Display(), attribs, &config_, 1,
-                        &config_count) != EGL_TRUE) {
-      ELINUX_LOG(ERROR) << "Failed to choose EGL surface config: "
-                        << get_egl_error_cause();
-      return;
-    }
+    attributes.stencil_size =
+        std::max(attributes.stencil_size, kImpellerStencilSize);
+  }
+  if (attributes.samples == 0) {
+    attributes.samples = enable_impeller ? kImpellerSamples : 1;
   }
 
-  if (config_count == 0 || config_ == nullptr) {
+  bool found = ChooseConfig(egl_surface_type, attributes);
+  if (!found && attributes.samples > 1) {
+    // Next fall back to disabled MSAA.
+    ELINUX_LOG(WARNING) << "No EGL config with " << attributes.samples
+                        << "x MSAA. Falls back to disabled MSAA.";
+    attributes.samples = 1;
+    found = ChooseConfig(egl_surface_type, attributes);
+  }
+  if (!found) {
     ELINUX_LOG(ERROR) << "No matching configs: " << get_egl_error_cause();
     return;
   }
 
   {
+    // Joins the share group of the other engines on the same display.
+    share_context_ =
+        EglShareGroup::GetShareContext(environment_->Display(), config_);
     const EGLint attribs[] = {EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE};
     context_ = eglCreateContext(environment_->Display(), config_,
-                                EGL_NO_CONTEXT, attribs);
+                                share_context_, attribs);
     if (context_ == EGL_NO_CONTEXT) {
       ELINUX_LOG(ERROR) << "Failed to create an onscreen context: "
                         << get_egl_error_cause();
@@ -106,9 +96,85 @@ ContextEgl::ContextEgl(std::unique_ptr<EnvironmentEgl> environment,
     }
   }
 
+  surfaceless_supported_ = has_egl_extension(
+      eglQueryString(environment_->Display(), EGL_EXTENSIONS),
+      "EGL_KHR_surfaceless_context");
+
   valid_ = true;
 }
 
+ContextEgl::~ContextEgl() {
+  // The display outlives the contexts when it's shared with other engines.
+  if (resource_context_ != EGL_NO_CONTEXT) {
+    eglDestroyContext(environment_->Display(), resource_context_);
+  }
+  if (context_ != EGL_NO_CONTEXT) {
+    eglDestroyContext(environment_->Display(), context_);
+  }
+}
+
+bool ContextEgl::ChooseConfig(EGLint egl_surface_type,
+                              const EglConfigAttributes& config_attributes) {
+  const bool msaa = config_attributes.samples > 1;
+  const EGLint attribs[] = {
+      // clang-format off
+    EGL_SURFACE_TYPE,    egl_surface_type,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+    EGL_RED_SIZE,        config_attributes.red_size,
+    EGL_GREEN_SIZE,      config_attributes.green_size,
+    EGL_BLUE_SIZE,       config_attributes.blue_size,
+    EGL_ALPHA_SIZE,      config_attributes.alpha_size,
+    EGL_DEPTH_SIZE,      config_attributes.depth_size,
+    EGL_STENCIL_SIZE,    config_attributes.stencil_size,
+    EGL_SAMPLE_BUFFERS,  msaa ? 1 : 0,
+    EGL_SAMPLES,         msaa ? config_attributes.samples : 0,
+    EGL_NONE
+      // clang-format on
+  };
+
+  // The sizes in |attribs| are minimums, and eglChooseConfig sorts configs
+  // with larger color buffers first. So rank all the matching configs by
+  // ourselves, e.g. to get RGB565 or a config without alpha (which lets the
+  // compositor skip blending) when they are asked for.
+  auto display = environment_->Display();
+  EGLint count = 0;
+  if (eglChooseConfig(display, attribs, nullptr, 0, &count) != EGL_TRUE) {
+    ELINUX_LOG(ERROR) << "Failed to choose EGL surface config: "
+                      << get_egl_error_cause();
+    return false;
+  }
+  if (count == 0) {
+    return false;
+  }
+  std::vector<EGLConfig> configs(count);
+  if (eglChooseConfig(display, attribs, configs.data(), count, &count) !=
+          EGL_TRUE ||
+      count == 0) {
+    ELINUX_LOG(ERROR) << "Failed to choose EGL surface config: "
+                      << get_egl_error_cause();
+    return false;
+  }
+
+  const EGLint samples = msaa ? config_attributes.samples : 0;
+  config_ = configs[0];
+  auto best_distance =
+      GetConfigDistance(display, configs[0], config_attributes, samples);
+  for (EGLint i = 1; i < count; i++) {
+    auto distance =
+        GetConfigDistance(display, configs[i], config_attributes, samples);
+    if (distance < best_distance) {
+      config_ = configs[i];
+      best_distance = distance;
+    }
+  }
+
+  if (std::get<0>(best_distance)) {
+    ELINUX_LOG(WARNING) << "No EGL config matches the native visual "
+                        << config_attributes.native_visual_id;
+  }
+  return true;
+}
+
 std::unique_ptr<ELinuxEGLSurface> ContextEgl::CreateOnscreenSurface(
     NativeWindow* window) const {
   const EGLint attribs[] = {EGL_NONE};
@@ -124,8 +190,16 @@ std::unique_ptr<ELinuxEGLSurface> ContextEgl::CreateOnscreenSurface(
 
 std::unique_ptr<ELinuxEGLSurface> ContextEgl::CreateOffscreenSurface(
     NativeWindow* window) const {
-#if defined(DISPLAY_BACKEND_TYPE_X11) || \
-    defined(DISPLAY_BACKEND_TYPE_DRM_EGLSTREAM)
+  // The resource context only uploads textures, so it doesn't need any
+  // surface (and the native window behind it) if the driver allows it.
+  if (surfaceless_supported_) {
+    return std::make_unique<ELinuxEGLSurface>(environment_->Display(),
+                                              resource_context_);
+  }
+
+#if defined(DISPLAY_BACKEND_TYPE_X11) ||           \
+    defined(DISPLAY_BACKEND_TYPE_DRM_EGLSTREAM) || \
+    defined(DISPLAY_BACKEND_TYPE_HEADLESS)
   const EGLint attribs[] = {
       // clang-format off
       EGL_WIDTH, 1,
@@ -159,6 +233,12 @@ bool ContextEgl::IsValid() const {
   return valid_;
 }
 
+bool ContextEgl::IsSharedWith(const ContextEgl& other) const {
+  // The root contexts are per display and config.
+  return share_context_ != EGL_NO_CONTEXT &&
+         share_context_ == other.share_context_;
+}
+
 bool ContextEgl::ClearCurrent() const {
   if (eglGetCurrentContext() != context_) {
     return true;
@@ -15,12 +15,40 @@
 
 namespace flutter {
 
+// Properties of the EGL frame buffer config to choose.
+struct EglConfigAttributes {
+  // Bits of each color component. Configs with exactly these sizes are
+  // preferred over larger ones, e.g. a zero |alpha_size| prefers XRGB8888 to
+  // ARGB8888.
+  EGLint red_size = 8;
+  EGLint green_size = 8;
+  EGLint blue_size = 8;
+#if defined(ENABLE_EGL_ALPHA_COMPONENT_OF_COLOR_BUFFER)
+  EGLint alpha_size = 8;
+#else
+  EGLint alpha_size = 0;
+#endif
+
+  // Minimum bits of the depth and the stencil buffers.
+  EGLint depth_size = 0;
+  EGLint stencil_size = 0;
+
+  // Samples per pixel for MSAA. 0 uses the renderer's default and 1 disables
+  // MSAA.
+  EGLint samples = 0;
+
+  // Native visual (e.g. the GBM format) of the buffers allocated by the
+  // window. Configs rendering to it are preferred. 0 matches any visual.
+  EGLint native_visual_id = 0;
+};
+
 class ContextEgl {
  public:
   ContextEgl(std::unique_ptr<EnvironmentEgl> environment,
              bool enable_impeller,
-             EGLint egl_surface_type = EGL_WINDOW_BIT);
-  ~ContextEgl() = default;
+             EGLint egl_surface_type = EGL_WINDOW_BIT,
+             const EglConfigAttributes& config_attributes = {});
+  ~ContextEgl();
 
   virtual std::unique_ptr<ELinuxEGLSurface> CreateOnscreenSurface(
       NativeWindow* window) const;
@@ -36,12 +64,25 @@ class ContextEgl {
 
   EGLint GetAttrib(EGLint attribute);
 
+  // Returns true if the GL objects such as the textures of |other| can be used
+  // in this context, i.e. both contexts joined the same share group.
+  bool IsSharedWith(const ContextEgl& other) const;
+
  protected:
+  // Chooses |config_| among the configs satisfying |config_attributes|,
+  // preferring the closest one. Returns false if no config matches.
+  bool ChooseConfig(EGLint egl_surface_type,
+                    const EglConfigAttributes& config_attributes);
+
   std::unique_ptr<EnvironmentEgl> environment_;
   EGLConfig config_;
-  EGLContext context_;
-  EGLContext resource_context_;
-  bool valid_;
+  EGLContext context_ = EGL_NO_CONTEXT;
+  EGLContext resource_context_ = EGL_NO_CONTEXT;
+  // The root context of the share group |context_| joined, if any.
+  EGLContext share_context_ = EGL_NO_CONTEXT;
+  // The resource context can be made current without a surface.
+  bool surfaceless_supported_ = false;
+  bool valid_ = false;
 };
 
 }  // namespace flutter
@@ -0,0 +1,38 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/surface/context_egl_headless.h"
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/egl_utils.h"
+
+namespace flutter {
+
+ContextEglHeadless::ContextEglHeadless(
+    std::unique_ptr<EnvironmentEglHeadless> environment,
+    bool enable_impeller,
+    const EglConfigAttributes& config_attributes)
+    : ContextEgl(std::move(environment), enable_impeller, EGL_PBUFFER_BIT,
+                 config_attributes) {}
+
+std::unique_ptr<ELinuxEGLSurface> ContextEglHeadless::CreateOnscreenSurface(
+    NativeWindow* window) const {
+  const EGLint attribs[] = {
+      // clang-format off
+      EGL_WIDTH, window->Width(),
+      EGL_HEIGHT, window->Height(),
+      EGL_NONE
+      // clang-format on
+  };
+  EGLSurface surface =
+      eglCreatePbufferSurface(environment_->Display(), config_, attribs);
+  if (surface == EGL_NO_SURFACE) {
+    ELINUX_LOG(ERROR) << "Failed to create EGL pbuffer surface: "
+                      << get_egl_error_cause();
+  }
+  return std::make_unique<ELinuxEGLSurface>(surface, environment_->Display(),
+                                            context_, window->EnableVsync());
+}
+
+}  // namespace flutter
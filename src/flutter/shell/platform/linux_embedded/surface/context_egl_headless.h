@@ -0,0 +1,33 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_CONTEXT_EGL_HEADLESS_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_CONTEXT_EGL_HEADLESS_H_
+
+#include <EGL/egl.h>
+
+#include <memory>
+
+#include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
+#include "flutter/shell/platform/linux_embedded/surface/elinux_egl_surface.h"
+#include "flutter/shell/platform/linux_embedded/surface/environment_egl_headless.h"
+
+namespace flutter {
+
+// Renders the onscreen frames into a pbuffer surface of the window size.
+class ContextEglHeadless : public ContextEgl {
+ public:
+  ContextEglHeadless(std::unique_ptr<EnvironmentEglHeadless> environment,
+                     bool enable_impeller,
+                     const EglConfigAttributes& config_attributes);
+  ~ContextEglHeadless() = default;
+
+  // |ContextEgl|
+  std::unique_ptr<ELinuxEGLSurface> CreateOnscreenSurface(
+      NativeWindow* window) const override;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_CONTEXT_EGL_HEADLESS_H_
@@ -10,8 +10,10 @@
 namespace flutter {
 
 ContextEglStream::ContextEglStream(
-    std::unique_ptr<EnvironmentEglStream> environment)
-    : ContextEgl(std::move(environment), false, EGL_STREAM_BIT_KHR) {
+    std::unique_ptr<EnvironmentEglStream> environment,
+    const EglConfigAttributes& config_attributes)
+    : ContextEgl(std::move(environment), false, EGL_STREAM_BIT_KHR,
+                 config_attributes) {
   if (!valid_) {
     return;
   }
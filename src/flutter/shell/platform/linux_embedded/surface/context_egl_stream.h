@@ -16,7 +16,8 @@ namespace flutter {
 
 class ContextEglStream : public ContextEgl {
  public:
-  ContextEglStream(std::unique_ptr<EnvironmentEglStream> environment);
+  ContextEglStream(std::unique_ptr<EnvironmentEglStream> environment,
+                   const EglConfigAttributes& config_attributes);
   ~ContextEglStream() = default;
 
   // |ContextEgl|
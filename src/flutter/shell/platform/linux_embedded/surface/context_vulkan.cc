@@ -0,0 +1,272 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/surface/context_vulkan.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+constexpr char kApplicationName[] = "flutter-elinux";
+
+// The instance extensions to create the window surface.
+constexpr const char* kSurfaceInstanceExtensions[] = {
+    VK_KHR_SURFACE_EXTENSION_NAME,
+#if defined(DISPLAY_BACKEND_TYPE_DRM_GBM) || \
+    defined(DISPLAY_BACKEND_TYPE_DRM_EGLSTREAM)
+    VK_KHR_DISPLAY_EXTENSION_NAME,
+    VK_EXT_DIRECT_MODE_DISPLAY_EXTENSION_NAME,
+    VK_EXT_ACQUIRE_DRM_DISPLAY_EXTENSION_NAME,
+#elif defined(DISPLAY_BACKEND_TYPE_X11)
+    VK_KHR_XCB_SURFACE_EXTENSION_NAME,
+#elif defined(DISPLAY_BACKEND_TYPE_HEADLESS)
+    VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME,
+#else
+    VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME,
+#endif
+};
+
+// Lower is preferred.
+int GetDeviceTypeRank(VkPhysicalDeviceType type) {
+  switch (type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+      return 0;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+      return 1;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+      return 2;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:
+      return 3;
+    default:
+      return 4;
+  }
+}
+
+bool HasDeviceExtension(VkPhysicalDevice physical_device, const char* name) {
+  uint32_t count = 0;
+  vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &count,
+                                       nullptr);
+  std::vector<VkExtensionProperties> extensions(count);
+  vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &count,
+                                       extensions.data());
+  return std::any_of(extensions.begin(), extensions.end(),
+                     [name](const VkExtensionProperties& extension) {
+                       return std::strcmp(extension.extensionName, name) == 0;
+                     });
+}
+
+// The queue functions of the engine, serialized with the presentation.
+VKAPI_ATTR VkResult VKAPI_CALL QueueSubmit(VkQueue queue,
+                                           uint32_t submit_count,
+                                           const VkSubmitInfo* submits,
+                                           VkFence fence) {
+  std::lock_guard<std::mutex> lock(ContextVulkan::QueueMutex());
+  return vkQueueSubmit(queue, submit_count, submits, fence);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL QueueWaitIdle(VkQueue queue) {
+  std::lock_guard<std::mutex> lock(ContextVulkan::QueueMutex());
+  return vkQueueWaitIdle(queue);
+}
+
+PFN_vkVoidFunction GetQueueFunction(const char* name) {
+  if (std::strcmp(name, "vkQueueSubmit") == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(QueueSubmit);
+  }
+  if (std::strcmp(name, "vkQueueWaitIdle") == 0) {
+    return reinterpret_cast<PFN_vkVoidFunction>(QueueWaitIdle);
+  }
+  return nullptr;
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(VkDevice device,
+                                                           const char* name) {
+  auto function = GetQueueFunction(name);
+  return function ? function : vkGetDeviceProcAddr(device, name);
+}
+}  // namespace
+
+ContextVulkan::ContextVulkan(NativeWindow* window) {
+  if (!CreateInstance()) {
+    return;
+  }
+  if (!ChoosePhysicalDevice(window)) {
+    return;
+  }
+  if (!CreateDevice()) {
+    return;
+  }
+  valid_ = true;
+}
+
+ContextVulkan::~ContextVulkan() {
+  if (device_ != VK_NULL_HANDLE) {
+    {
+      std::lock_guard<std::mutex> lock(QueueMutex());
+      vkDeviceWaitIdle(device_);
+    }
+    vkDestroyDevice(device_, nullptr);
+  }
+  if (surface_ != VK_NULL_HANDLE) {
+    vkDestroySurfaceKHR(instance_, surface_, nullptr);
+  }
+  if (instance_ != VK_NULL_HANDLE) {
+    vkDestroyInstance(instance_, nullptr);
+  }
+}
+
+// static
+void* ContextVulkan::GetInstanceProcAddress(VkInstance instance,
+                                            const char* name) {
+  if (std::strcmp(name, "vkGetDeviceProcAddr") == 0) {
+    return reinterpret_cast<void*>(GetDeviceProcAddr);
+  }
+  auto function = GetQueueFunction(name);
+  if (!function) {
+    function = vkGetInstanceProcAddr(instance, name);
+  }
+  return reinterpret_cast<void*>(function);
+}
+
+// static
+std::mutex& ContextVulkan::QueueMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+bool ContextVulkan::CreateInstance() {
+  uint32_t loader_version = VK_API_VERSION_1_0;
+  vkEnumerateInstanceVersion(&loader_version);
+  if (loader_version < api_version_) {
+    ELINUX_LOG(ERROR) << "Vulkan " << VK_VERSION_MAJOR(api_version_) << "."
+                      << VK_VERSION_MINOR(api_version_)
+                      << " isn't supported by the Vulkan loader.";
+    return false;
+  }
+
+  uint32_t count = 0;
+  vkEnumerateInstanceExtensionProperties(nullptr, &count, nullptr);
+  std::vector<VkExtensionProperties> extensions(count);
+  vkEnumerateInstanceExtensionProperties(nullptr, &count, extensions.data());
+  for (const auto* name : kSurfaceInstanceExtensions) {
+    auto found =
+        std::any_of(extensions.begin(), extensions.end(),
+                    [name](const VkExtensionProperties& extension) {
+                      return std::strcmp(extension.extensionName, name) == 0;
+                    });
+    if (!found) {
+      ELINUX_LOG(ERROR) << name << " isn't supported.";
+      return false;
+    }
+    instance_extensions_.push_back(name);
+  }
+
+  VkApplicationInfo application_info = {};
+  application_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+  application_info.pApplicationName = kApplicationName;
+  application_info.pEngineName = kApplicationName;
+  application_info.apiVersion = api_version_;
+
+  VkInstanceCreateInfo create_info = {};
+  create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+  create_info.pApplicationInfo = &application_info;
+  create_info.enabledExtensionCount = instance_extensions_.size();
+  create_info.ppEnabledExtensionNames = instance_extensions_.data();
+  auto result = vkCreateInstance(&create_info, nullptr, &instance_);
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create the Vulkan instance: " << result;
+    instance_ = VK_NULL_HANDLE;
+    return false;
+  }
+  return true;
+}
+
+bool ContextVulkan::ChoosePhysicalDevice(NativeWindow* window) {
+  uint32_t count = 0;
+  vkEnumeratePhysicalDevices(instance_, &count, nullptr);
+  std::vector<VkPhysicalDevice> physical_devices(count);
+  vkEnumeratePhysicalDevices(instance_, &count, physical_devices.data());
+  std::stable_sort(physical_devices.begin(), physical_devices.end(),
+                   [](VkPhysicalDevice a, VkPhysicalDevice b) {
+                     VkPhysicalDeviceProperties properties_a;
+                     VkPhysicalDeviceProperties properties_b;
+                     vkGetPhysicalDeviceProperties(a, &properties_a);
+                     vkGetPhysicalDeviceProperties(b, &properties_b);
+                     return GetDeviceTypeRank(properties_a.deviceType) <
+                            GetDeviceTypeRank(properties_b.deviceType);
+                   });
+
+  for (auto physical_device : physical_devices) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physical_device, &properties);
+    if (properties.apiVersion < api_version_ ||
+        !HasDeviceExtension(physical_device, VK_KHR_SWAPCHAIN_EXTENSION_NAME)) {
+      continue;
+    }
+
+    // The surface of the DRM backend belongs to the device driving the
+    // display, so it's created for each candidate.
+    auto surface = window->CreateVulkanSurface(instance_, physical_device);
+    if (surface == VK_NULL_HANDLE) {
+      continue;
+    }
+
+    uint32_t family_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &family_count,
+                                             nullptr);
+    std::vector<VkQueueFamilyProperties> families(family_count);
+    vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &family_count,
+                                             families.data());
+    for (uint32_t i = 0; i < family_count; i++) {
+      VkBool32 present_support = VK_FALSE;
+      vkGetPhysicalDeviceSurfaceSupportKHR(physical_device, i, surface,
+                                           &present_support);
+      if ((families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) &&
+          present_support) {
+        ELINUX_LOG(INFO) << "Vulkan device: " << properties.deviceName;
+        physical_device_ = physical_device;
+        queue_family_index_ = i;
+        surface_ = surface;
+        return true;
+      }
+    }
+    vkDestroySurfaceKHR(instance_, surface, nullptr);
+  }
+
+  ELINUX_LOG(ERROR) << "No Vulkan device can present to the window.";
+  return false;
+}
+
+bool ContextVulkan::CreateDevice() {
+  device_extensions_.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+
+  const float priority = 1.0f;
+  VkDeviceQueueCreateInfo queue_info = {};
+  queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+  queue_info.queueFamilyIndex = queue_family_index_;
+  queue_info.queueCount = 1;
+  queue_info.pQueuePriorities = &priority;
+
+  VkDeviceCreateInfo create_info = {};
+  create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+  create_info.queueCreateInfoCount = 1;
+  create_info.pQueueCreateInfos = &queue_info;
+  create_info.enabledExtensionCount = device_extensions_.size();
+  create_info.ppEnabledExtensionNames = device_extensions_.data();
+  auto result =
+      vkCreateDevice(physical_device_, &create_info, nullptr, &device_);
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create the Vulkan device: " << result;
+    device_ = VK_NULL_HANDLE;
+    return false;
+  }
+  vkGetDeviceQueue(device_, queue_family_index_, 0, &queue_);
+  return true;
+}
+
+}  // namespace flutter
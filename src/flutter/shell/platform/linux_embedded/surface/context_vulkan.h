@@ -0,0 +1,84 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_CONTEXT_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_CONTEXT_VULKAN_H_
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window.h"
+
+namespace flutter {
+
+// The Vulkan instance and device shared by the engine and the swapchain of a
+// window. The instance extensions for the window surface depend on the
+// display backend.
+class ContextVulkan {
+ public:
+  // Creates the device on the first physical device (preferring discrete and
+  // integrated GPUs) which can present to |window|.
+  ContextVulkan(NativeWindow* window);
+  ~ContextVulkan();
+
+  bool IsValid() const { return valid_; }
+
+  uint32_t ApiVersion() const { return api_version_; }
+
+  VkInstance Instance() const { return instance_; }
+
+  VkPhysicalDevice PhysicalDevice() const { return physical_device_; }
+
+  VkDevice Device() const { return device_; }
+
+  uint32_t QueueFamilyIndex() const { return queue_family_index_; }
+
+  VkQueue Queue() const { return queue_; }
+
+  // The surface of the window on the physical device.
+  VkSurfaceKHR Surface() const { return surface_; }
+
+  const std::vector<const char*>& InstanceExtensions() const {
+    return instance_extensions_;
+  }
+
+  const std::vector<const char*>& DeviceExtensions() const {
+    return device_extensions_;
+  }
+
+  // Resolves the Vulkan functions for the engine. The functions using the
+  // queues are replaced with ones serialized with QueueMutex().
+  static void* GetInstanceProcAddress(VkInstance instance, const char* name);
+
+  // Guards the queues, which are used by the engine threads and by the
+  // presentation on the raster thread.
+  static std::mutex& QueueMutex();
+
+ private:
+  bool CreateInstance();
+
+  // Picks the physical device and the queue family, and creates the surface.
+  bool ChoosePhysicalDevice(NativeWindow* window);
+
+  bool CreateDevice();
+
+  uint32_t api_version_ = VK_API_VERSION_1_1;
+  std::vector<const char*> instance_extensions_;
+  std::vector<const char*> device_extensions_;
+
+  VkInstance instance_ = VK_NULL_HANDLE;
+  VkPhysicalDevice physical_device_ = VK_NULL_HANDLE;
+  VkSurfaceKHR surface_ = VK_NULL_HANDLE;
+  VkDevice device_ = VK_NULL_HANDLE;
+  uint32_t queue_family_index_ = 0;
+  VkQueue queue_ = VK_NULL_HANDLE;
+  bool valid_ = false;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_CONTEXT_VULKAN_H_
@@ -0,0 +1,114 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/surface/damage_history.h"
+
+#include <algorithm>
+
+namespace flutter {
+
+namespace {
+// Maximum damage history - for triple buffering we need to store damage for
+// last two frames; Some Android devices (Pixel 4) use quad buffering.
+constexpr size_t kMaxHistorySize = 10;
+
+// Above this number of disjoint rects, the bounding box is reported instead.
+// Drivers tend to handle a few rects well but degrade with many small ones.
+constexpr size_t kMaxExistingDamageRects = 4;
+
+bool IsEmpty(const FlutterRect& rect) {
+  return rect.right <= rect.left || rect.bottom <= rect.top;
+}
+
+bool Intersects(const FlutterRect& a, const FlutterRect& b) {
+  return a.left <= b.right && b.left <= a.right && a.top <= b.bottom &&
+         b.top <= a.bottom;
+}
+
+void Join(FlutterRect& rect, const FlutterRect& other) {
+  rect.left = std::min(rect.left, other.left);
+  rect.top = std::min(rect.top, other.top);
+  rect.right = std::max(rect.right, other.right);
+  rect.bottom = std::max(rect.bottom, other.bottom);
+}
+
+// Adds |rect| to |rects|, merging it with every rect it touches.
+void AddRect(std::vector<FlutterRect>& rects, FlutterRect rect) {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (auto it = rects.begin(); it != rects.end(); ++it) {
+      if (Intersects(*it, rect)) {
+        Join(rect, *it);
+        rects.erase(it);
+        merged = true;
+        break;
+      }
+    }
+  }
+  rects.push_back(rect);
+}
+}  // namespace
+
+void DamageHistory::Push(const FlutterRect* rects, size_t num_rects) {
+  std::vector<FlutterRect> frame;
+  if (rects) {
+    for (size_t i = 0; i < num_rects; i++) {
+      if (!IsEmpty(rects[i])) {
+        AddRect(frame, rects[i]);
+      }
+    }
+    if (frame.empty()) {
+      // Nothing changed in this frame. Keep a zero-sized rect so that the
+      // entry is not mistaken for full damage.
+      frame.push_back(FlutterRect{0, 0, 0, 0});
+    }
+  }
+
+  frames_.push_back(std::move(frame));
+  if (frames_.size() > kMaxHistorySize) {
+    frames_.pop_front();
+  }
+}
+
+void DamageHistory::PushFullDamage() {
+  Push(nullptr, 0);
+}
+
+void DamageHistory::Clear() {
+  frames_.clear();
+}
+
+bool DamageHistory::GetExistingDamage(int buffer_age,
+                                      std::vector<FlutterRect>& rects) const {
+  rects.clear();
+  if (buffer_age <= 0 || static_cast<size_t>(buffer_age - 1) > frames_.size()) {
+    return false;
+  }
+
+  // Join the damage of the (age - 1) frames presented since this buffer was
+  // last used.
+  auto frame = frames_.rbegin();
+  for (int i = 1; i < buffer_age; i++, ++frame) {
+    if (frame->empty()) {
+      return false;
+    }
+    for (const auto& rect : *frame) {
+      if (!IsEmpty(rect)) {
+        AddRect(rects, rect);
+      }
+    }
+  }
+
+  if (rects.size() > kMaxExistingDamageRects) {
+    FlutterRect bounds = rects[0];
+    for (const auto& rect : rects) {
+      Join(bounds, rect);
+    }
+    rects.assign(1, bounds);
+  }
+  return true;
+}
+
+}  // namespace flutter
@@ -0,0 +1,52 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_DAMAGE_HISTORY_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_DAMAGE_HISTORY_H_
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "flutter/shell/platform/embedder/embedder.h"
+
+namespace flutter {
+
+// Tracks the damage of the most recently presented frames so that the stale
+// region of a back buffer can be computed from its buffer age
+// (EGL_EXT_buffer_age).
+//
+// A buffer of age N holds the contents presented N frames ago, so it misses
+// the damage of the last N - 1 frames. An age of 0 means the contents are
+// undefined, and an age older than the history means the damage is unknown.
+// Both cases require a full repaint.
+class DamageHistory {
+ public:
+  DamageHistory() = default;
+  ~DamageHistory() = default;
+
+  // Records the frame damage of a presented frame. Passing no rects records a
+  // frame whose damage is unknown, which forces a full repaint of every buffer
+  // that has not seen it.
+  void Push(const FlutterRect* rects, size_t num_rects);
+
+  // Records a frame that repainted the whole surface.
+  void PushFullDamage();
+
+  // Forgets all frames, e.g. when the buffers are resized or recreated.
+  void Clear();
+
+  // Computes the stale region of a buffer of |buffer_age| into |rects|.
+  // Returns false if the whole buffer must be repainted.
+  bool GetExistingDamage(int buffer_age, std::vector<FlutterRect>& rects) const;
+
+ private:
+  // Frame damages of the most recent frames, newest at the back. An empty
+  // entry means the damage of that frame is unknown (i.e. full damage).
+  std::deque<std::vector<FlutterRect>> frames_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_DAMAGE_HISTORY_H_
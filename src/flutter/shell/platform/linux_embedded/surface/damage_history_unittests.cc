@@ -0,0 +1,133 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/surface/damage_history.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+bool operator==(const FlutterRect& a, const FlutterRect& b) {
+  return a.left == b.left && a.top == b.top && a.right == b.right &&
+         a.bottom == b.bottom;
+}
+
+void Push(DamageHistory& history, std::vector<FlutterRect> rects) {
+  history.Push(rects.data(), rects.size());
+}
+}  // namespace
+
+TEST(DamageHistoryTest, UndefinedBufferNeedsFullRepaint) {
+  DamageHistory history;
+  Push(history, {{0, 0, 10, 10}});
+  std::vector<FlutterRect> rects;
+  EXPECT_FALSE(history.GetExistingDamage(0, rects));
+  EXPECT_TRUE(rects.empty());
+}
+
+TEST(DamageHistoryTest, BufferOfAgeOneIsUpToDate) {
+  DamageHistory history;
+  Push(history, {{0, 0, 10, 10}});
+  std::vector<FlutterRect> rects = {{1, 2, 3, 4}};
+  EXPECT_TRUE(history.GetExistingDamage(1, rects));
+  EXPECT_TRUE(rects.empty());
+}
+
+TEST(DamageHistoryTest, JoinsTheFramesMissedByTheBuffer) {
+  DamageHistory history;
+  Push(history, {{0, 0, 10, 10}});
+  Push(history, {{100, 100, 110, 110}});
+  Push(history, {{200, 200, 210, 210}});
+
+  // A buffer of age 3 misses the last two frames, but not the first one.
+  std::vector<FlutterRect> rects;
+  ASSERT_TRUE(history.GetExistingDamage(3, rects));
+  ASSERT_EQ(rects.size(), 2u);
+  EXPECT_TRUE(rects[0] == (FlutterRect{200, 200, 210, 210}));
+  EXPECT_TRUE(rects[1] == (FlutterRect{100, 100, 110, 110}));
+}
+
+TEST(DamageHistoryTest, KeepsEveryRectOfAFrame) {
+  DamageHistory history;
+  Push(history, {{0, 0, 10, 10}, {50, 50, 60, 60}});
+  Push(history, {{0, 0, 0, 0}});
+  std::vector<FlutterRect> rects;
+  ASSERT_TRUE(history.GetExistingDamage(3, rects));
+  EXPECT_EQ(rects.size(), 2u);
+}
+
+TEST(DamageHistoryTest, MergesOverlappingRects) {
+  DamageHistory history;
+  Push(history, {{0, 0, 10, 10}});
+  Push(history, {{5, 5, 20, 20}});
+  std::vector<FlutterRect> rects;
+  ASSERT_TRUE(history.GetExistingDamage(3, rects));
+  ASSERT_EQ(rects.size(), 1u);
+  EXPECT_TRUE(rects[0] == (FlutterRect{0, 0, 20, 20}));
+}
+
+TEST(DamageHistoryTest, CollapsesManyRectsToTheirBounds) {
+  DamageHistory history;
+  Push(history, {{0, 0, 1, 1},
+                 {10, 10, 11, 11},
+                 {20, 20, 21, 21},
+                 {30, 30, 31, 31},
+                 {40, 40, 41, 41}});
+  Push(history, {{0, 0, 0, 0}});
+  std::vector<FlutterRect> rects;
+  ASSERT_TRUE(history.GetExistingDamage(3, rects));
+  ASSERT_EQ(rects.size(), 1u);
+  EXPECT_TRUE(rects[0] == (FlutterRect{0, 0, 41, 41}));
+}
+
+TEST(DamageHistoryTest, FrameWithoutDamageIsNotFullDamage) {
+  DamageHistory history;
+  const FlutterRect unused = {};
+  history.Push(&unused, 0);
+  Push(history, {{0, 0, 0, 0}});
+  std::vector<FlutterRect> rects;
+  EXPECT_TRUE(history.GetExistingDamage(3, rects));
+  EXPECT_TRUE(rects.empty());
+}
+
+TEST(DamageHistoryTest, FullDamageNeedsFullRepaint) {
+  DamageHistory history;
+  Push(history, {{0, 0, 10, 10}});
+  history.PushFullDamage();
+  Push(history, {{0, 0, 10, 10}});
+  std::vector<FlutterRect> rects;
+  // Age 2 only misses the last frame, which has a known damage.
+  EXPECT_TRUE(history.GetExistingDamage(2, rects));
+  // Age 3 also misses the fully damaged frame.
+  EXPECT_FALSE(history.GetExistingDamage(3, rects));
+}
+
+TEST(DamageHistoryTest, BufferOlderThanTheHistoryNeedsFullRepaint) {
+  DamageHistory history;
+  Push(history, {{0, 0, 10, 10}});
+  std::vector<FlutterRect> rects;
+  EXPECT_TRUE(history.GetExistingDamage(2, rects));
+  EXPECT_FALSE(history.GetExistingDamage(3, rects));
+
+  history.Clear();
+  EXPECT_TRUE(history.GetExistingDamage(1, rects));
+  EXPECT_FALSE(history.GetExistingDamage(2, rects));
+}
+
+TEST(DamageHistoryTest, ForgetsTheOldestFrames) {
+  DamageHistory history;
+  for (int i = 0; i < 20; i++) {
+    Push(history, {{0, 0, 10, 10}});
+  }
+  std::vector<FlutterRect> rects;
+  EXPECT_TRUE(history.GetExistingDamage(11, rects));
+  EXPECT_FALSE(history.GetExistingDamage(12, rects));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -0,0 +1,94 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/surface/egl_share_group.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/egl_utils.h"
+
+namespace flutter {
+
+namespace {
+struct DisplayEntry {
+  // Number of the environments using the display.
+  int ref_count = 0;
+  // Root context of the share group of each config.
+  std::unordered_map<EGLConfig, EGLContext> share_contexts;
+};
+
+std::mutex& GetMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_map<EGLDisplay, DisplayEntry>& GetDisplays() {
+  static auto* displays = new std::unordered_map<EGLDisplay, DisplayEntry>();
+  return *displays;
+}
+}  // namespace
+
+bool EglShareGroup::AcquireDisplay(EGLDisplay display) {
+  std::lock_guard<std::mutex> lock(GetMutex());
+  auto& entry = GetDisplays()[display];
+  if (entry.ref_count == 0) {
+    if (eglInitialize(display, nullptr, nullptr) != EGL_TRUE) {
+      ELINUX_LOG(ERROR) << "Failed to initialize the EGL display: "
+                        << get_egl_error_cause();
+      GetDisplays().erase(display);
+      return false;
+    }
+  } else {
+    ELINUX_LOG(DEBUG) << "Reusing the EGL display of another engine.";
+  }
+  entry.ref_count++;
+  return true;
+}
+
+void EglShareGroup::ReleaseDisplay(EGLDisplay display) {
+  std::lock_guard<std::mutex> lock(GetMutex());
+  auto it = GetDisplays().find(display);
+  if (it == GetDisplays().end() || --it->second.ref_count > 0) {
+    return;
+  }
+
+  for (const auto& [config, context] : it->second.share_contexts) {
+    eglDestroyContext(display, context);
+  }
+  GetDisplays().erase(it);
+  if (eglTerminate(display) != EGL_TRUE) {
+    ELINUX_LOG(ERROR) << "Failed to terminate the EGL display: "
+                      << get_egl_error_cause();
+  }
+}
+
+EGLContext EglShareGroup::GetShareContext(EGLDisplay display,
+                                          EGLConfig config) {
+  std::lock_guard<std::mutex> lock(GetMutex());
+  auto it = GetDisplays().find(display);
+  if (it == GetDisplays().end()) {
+    return EGL_NO_CONTEXT;
+  }
+
+  auto& share_contexts = it->second.share_contexts;
+  auto context = share_contexts.find(config);
+  if (context != share_contexts.end()) {
+    return context->second;
+  }
+
+  const EGLint attribs[] = {EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE};
+  auto share_context =
+      eglCreateContext(display, config, EGL_NO_CONTEXT, attribs);
+  if (share_context == EGL_NO_CONTEXT) {
+    ELINUX_LOG(WARNING) << "Failed to create a share context: "
+                        << get_egl_error_cause();
+    return EGL_NO_CONTEXT;
+  }
+  share_contexts[config] = share_context;
+  return share_context;
+}
+
+}  // namespace flutter
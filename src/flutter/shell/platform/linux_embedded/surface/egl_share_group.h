@@ -0,0 +1,47 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_EGL_SHARE_GROUP_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_EGL_SHARE_GROUP_H_
+
+#include <EGL/egl.h>
+
+namespace flutter {
+
+// Process-wide registry of the EGL displays used by the engines.
+//
+// EGL displays are per process, so the engines rendering to the same display
+// (e.g. the headless and EGLStream backends) must not initialize and
+// terminate it on their own. The display is initialized by the first engine
+// and terminated when the last one releases it.
+//
+// The contexts created on a display with the same config join one share
+// group, so the driver state and the GL objects such as the compiled
+// programs live once per process rather than once per engine.
+//
+// The EGL display follows the native display, so only the windows sharing a
+// native display share a group: the X11 windows share the connection of the
+// process (see X11Display), and the headless and EGLStream backends use the
+// default display. The Wayland and DRM-GBM windows open their own wl_display
+// and GBM device, so their contexts aren't shared with other windows.
+//
+// All the functions are thread-safe.
+class EglShareGroup {
+ public:
+  // Initializes |display| unless another engine already has. Returns false if
+  // the display can't be initialized.
+  static bool AcquireDisplay(EGLDisplay display);
+
+  // Terminates |display| if nothing else uses it.
+  static void ReleaseDisplay(EGLDisplay display);
+
+  // Returns the context to share with when creating a context with |config|
+  // on |display|, or EGL_NO_CONTEXT if |display| isn't acquired. It's never
+  // made current and lives until |display| is terminated.
+  static EGLContext GetShareContext(EGLDisplay display, EGLConfig config);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_EGL_SHARE_GROUP_H_
@@ -44,6 +44,10 @@ std::string get_egl_error_cause() {
 // Auxiliary function used to check if the given list of extensions contains the
 // requested extension name.
 bool has_egl_extension(const char* extensions, const char* name) {
+  // eglQueryString() returns NULL for a display which isn't initialized.
+  if (!extensions) {
+    return false;
+  }
   const char* r = std::strstr(extensions, name);
   auto len = std::strlen(name);
 
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/platform/linux_embedded/surface/elinux_egl_surface.h"
 
+#include <algorithm>
+
 #include "flutter/shell/platform/linux_embedded/logger.h"
 #include "flutter/shell/platform/linux_embedded/surface/egl_utils.h"
 
@@ -12,10 +14,6 @@ namespace flutter {
 constexpr size_t kInitialWindowWidthPx = 1280;
 constexpr size_t kInitialWindowHeightPx = 720;
 
-// Maximum damage history - for triple buffering we need to store damage for
-// last two frames; Some Android devices (Pixel 4) use quad buffering.
-constexpr const int kMaxHistorySize = 10;
-
 ELinuxEGLSurface::ELinuxEGLSurface(EGLSurface surface,
                                    EGLDisplay display,
                                    EGLContext context,
@@ -28,9 +26,12 @@ ELinuxEGLSurface::ELinuxEGLSurface(EGLSurface surface,
       height_px_(kInitialWindowHeightPx) {
   const char* extensions = eglQueryString(display_, EGL_EXTENSIONS);
 
-  if (has_egl_extension(extensions, "EGL_KHR_partial_update")) {
-    eglSetDamageRegionKHR_ = reinterpret_cast<PFNEGLSETDAMAGEREGIONKHRPROC>(
-        eglGetProcAddress("eglSetDamageRegionKHR"));
+  // EGL_KHR_partial_update also defines the buffer age query. Its damage
+  // region must be set before rendering, when the damage of the frame isn't
+  // known yet, so only swap-with-damage is used to report it.
+  if (has_egl_extension(extensions, "EGL_KHR_partial_update") ||
+      has_egl_extension(extensions, "EGL_EXT_buffer_age")) {
+    buffer_age_supported_ = true;
   }
 
   if (has_egl_extension(extensions, "EGL_EXT_swap_buffers_with_damage")) {
@@ -47,6 +48,11 @@ ELinuxEGLSurface::ELinuxEGLSurface(EGLSurface surface,
   }
 };
 
+ELinuxEGLSurface::ELinuxEGLSurface(EGLDisplay display, EGLContext context)
+    : ELinuxEGLSurface(EGL_NO_SURFACE, display, context, false) {
+  surfaceless_ = true;
+}
+
 ELinuxEGLSurface::~ELinuxEGLSurface() {
   if (surface_ != EGL_NO_SURFACE) {
     if (eglDestroySurface(display_, surface_) != EGL_TRUE) {
@@ -58,13 +64,16 @@ ELinuxEGLSurface::~ELinuxEGLSurface() {
 }
 
 bool ELinuxEGLSurface::IsValid() const {
-  return surface_ != EGL_NO_SURFACE;
+  return surface_ != EGL_NO_SURFACE || surfaceless_;
 }
 
 void ELinuxEGLSurface::SurfaceResize(const size_t width_px,
                                      const size_t height_px) {
   width_px_ = width_px;
   height_px_ = height_px;
+
+  // The contents of the buffers are undefined after resizing.
+  damage_history_.Clear();
 }
 
 bool ELinuxEGLSurface::MakeCurrent() const {
@@ -109,36 +118,18 @@ bool ELinuxEGLSurface::SwapBuffers() const {
 // https://github.com/flutter/engine/blob/main/examples/glfw_drm/FlutterEmbedderGLFW.cc
 
 bool ELinuxEGLSurface::SwapBuffers(const FlutterPresentInfo* info) {
-  // Free the existing damage that was allocated to this frame.
-  if (existing_damage_map_.find(info->fbo_id) != existing_damage_map_.end() &&
-      existing_damage_map_[info->fbo_id] != nullptr) {
-    free(existing_damage_map_[info->fbo_id]);
-    existing_damage_map_[info->fbo_id] = nullptr;
-  }
-
-  // Set the buffer damage as the damage region.
-  if (eglSetDamageRegionKHR_) {
-    auto buffer_rects = RectToInts(info->buffer_damage.damage[0]);
-    if (eglSetDamageRegionKHR_(display_, surface_, buffer_rects.data(), 1) !=
-        EGL_TRUE) {
-      ELINUX_LOG(ERROR) << "eglSetDamageRegionKHR failed: "
-                        << get_egl_error_cause();
-      return false;
-    }
-  }
-
   // Add frame damage to damage history
-  damage_history_.push_back(info->frame_damage.damage[0]);
-  if (damage_history_.size() > kMaxHistorySize) {
-    damage_history_.pop_front();
-  }
+  damage_history_.Push(info->frame_damage.damage,
+                       info->frame_damage.num_rects);
 
-  if (eglSwapBuffersWithDamageEXT_) {
-    auto frame_rects = RectToInts(info->frame_damage.damage[0]);
+  if (eglSwapBuffersWithDamageEXT_ && info->frame_damage.num_rects > 0) {
+    auto frame_rects = RectsToInts(info->frame_damage);
     if (eglSwapBuffersWithDamageEXT_(display_, surface_, frame_rects.data(),
-                                     1) != EGL_TRUE) {
+                                     info->frame_damage.num_rects) !=
+        EGL_TRUE) {
       ELINUX_LOG(ERROR) << "eglSwapBuffersWithDamageEXT failed: "
                         << get_egl_error_cause();
+      damage_history_.Clear();
       return false;
     }
   } else {
@@ -146,6 +137,7 @@ bool ELinuxEGLSurface::SwapBuffers(const FlutterPresentInfo* info) {
     // full repaint.
     if (eglSwapBuffers(display_, surface_) != EGL_TRUE) {
       ELINUX_LOG(ERROR) << "eglSwapBuffers failed: " << get_egl_error_cause();
+      damage_history_.Clear();
       return false;
     }
   }
@@ -156,62 +148,61 @@ bool ELinuxEGLSurface::SwapBuffers(const FlutterPresentInfo* info) {
 void ELinuxEGLSurface::PopulateExistingDamage(const intptr_t fbo_id,
                                               FlutterDamage* existing_damage) {
   // Given the FBO age, create existing damage region by joining all frame
-  // damages since FBO was last used
+  // damages since FBO was last used. An age of 0 means that the contents of
+  // the buffer are undefined.
   EGLint age = 0;
-  if (eglQuerySurface(display_, surface_, EGL_BUFFER_AGE_EXT, &age) !=
-          EGL_TRUE ||
-      age == 0) {
-    age = 4;  // Virtually no driver should have a swapchain length > 4.
+  if (buffer_age_supported_ &&
+      eglQuerySurface(display_, surface_, EGL_BUFFER_AGE_EXT, &age) !=
+          EGL_TRUE) {
+    age = 0;
   }
 
-  existing_damage->num_rects = 1;
-
-  // Allocate the array of rectangles for the existing damage.
-  existing_damage_map_[fbo_id] = static_cast<FlutterRect*>(
-      malloc(sizeof(FlutterRect) * existing_damage->num_rects));
-
-  existing_damage_map_[fbo_id][0] = FlutterRect{
-      0, 0, static_cast<double>(width_px_), static_cast<double>(height_px_)};
-  existing_damage->damage = existing_damage_map_[fbo_id];
-
-  if (age > 1) {
-    --age;
-    // join up to (age - 1) last rects from damage history
-    for (auto i = damage_history_.rbegin();
-         i != damage_history_.rend() && age > 0; ++i, --age) {
-      if (i == damage_history_.rbegin()) {
-        if (i != damage_history_.rend()) {
-          existing_damage->damage[0] = {i->left, i->top, i->right, i->bottom};
-        }
-      } else {
-        // Auxiliary function to union the damage regions comprised by two
-        // FlutterRect element. It saves the result of this join in the rect
-        // variable.
-        FlutterRect* rect = &(existing_damage->damage[0]);
-        const FlutterRect additional_rect = *i;
-
-        rect->left = std::min(rect->left, additional_rect.left);
-        rect->top = std::min(rect->top, additional_rect.top);
-        rect->right = std::max(rect->right, additional_rect.right);
-        rect->bottom = std::max(rect->bottom, additional_rect.bottom);
-      }
-    }
+  auto& rects = existing_damage_map_[fbo_id];
+  if (!damage_history_.GetExistingDamage(age, rects)) {
+    // Repaint the whole buffer.
+    rects.assign(1, GetSurfaceRect());
+  } else if (rects.empty()) {
+    // The buffer is up to date. Flutter treats a missing region as full
+    // damage, so report an empty rect instead.
+    rects.assign(1, FlutterRect{0, 0, 0, 0});
   }
+
+  existing_damage->num_rects = rects.size();
+  existing_damage->damage = rects.data();
 }
 
-// Auxiliary function used to transform a FlutterRect into the format that is
-// expected by the EGL functions (i.e. array of EGLint).
-std::array<EGLint, 4> ELinuxEGLSurface::RectToInts(const FlutterRect rect) {
-  EGLint height;
-  eglQuerySurface(display_, surface_, EGL_HEIGHT, &height);
-
-  std::array<EGLint, 4> res{
-      static_cast<int>(rect.left),
-      height - static_cast<int>(rect.bottom),
-      static_cast<int>(rect.right) - static_cast<int>(rect.left),
-      static_cast<int>(rect.bottom) - static_cast<int>(rect.top),
-  };
+std::vector<EGLint> ELinuxEGLSurface::RectsToInts(
+    const FlutterDamage& damage) const {
+  const auto surface_rect = GetSurfaceRect();
+  const auto height = static_cast<EGLint>(surface_rect.bottom);
+
+  std::vector<EGLint> res;
+  res.reserve(damage.num_rects * 4);
+  for (size_t i = 0; i < damage.num_rects; i++) {
+    const auto& rect = damage.damage[i];
+    auto left = static_cast<EGLint>(std::max(rect.left, surface_rect.left));
+    auto top = static_cast<EGLint>(std::max(rect.top, surface_rect.top));
+    auto right = static_cast<EGLint>(std::min(rect.right, surface_rect.right));
+    auto bottom =
+        static_cast<EGLint>(std::min(rect.bottom, surface_rect.bottom));
+    res.push_back(left);
+    res.push_back(height - bottom);
+    res.push_back(std::max(0, right - left));
+    res.push_back(std::max(0, bottom - top));
+  }
   return res;
 }
 
+FlutterRect ELinuxEGLSurface::GetSurfaceRect() const {
+  EGLint width;
+  EGLint height;
+  if (eglQuerySurface(display_, surface_, EGL_WIDTH, &width) != EGL_TRUE ||
+      eglQuerySurface(display_, surface_, EGL_HEIGHT, &height) != EGL_TRUE) {
+    width = width_px_;
+    height = height_px_;
+  }
+  return FlutterRect{0, 0, static_cast<double>(width),
+                     static_cast<double>(height)};
+}
+
 }  // namespace flutter
@@ -8,11 +8,11 @@
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
 
-#include <array>
-#include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/linux_embedded/surface/damage_history.h"
 
 namespace flutter {
 
@@ -23,6 +23,8 @@ class ELinuxEGLSurface {
                    EGLDisplay display,
                    EGLContext context,
                    bool vsync_enabled);
+  // Makes |context| current without any surface (EGL_KHR_surfaceless_context).
+  ELinuxEGLSurface(EGLDisplay display, EGLContext context);
   ~ELinuxEGLSurface();
 
   bool IsValid() const;
@@ -39,27 +41,34 @@ class ELinuxEGLSurface {
                               FlutterDamage* existing_damage);
 
  private:
-  // Auxiliary function used to transform a FlutterRect into the format that is
-  // expected by the EGL functions (i.e. array of EGLint).
-  std::array<EGLint, 4> RectToInts(const FlutterRect rect);
+  // Auxiliary function used to transform FlutterRects into the format that is
+  // expected by the EGL functions (i.e. array of EGLint with the origin at the
+  // bottom-left corner).
+  std::vector<EGLint> RectsToInts(const FlutterDamage& damage) const;
+
+  // Returns the current size of the surface in physical pixels.
+  FlutterRect GetSurfaceRect() const;
 
   EGLDisplay display_;
   EGLSurface surface_;
   EGLContext context_;
   bool vsync_enabled_;
+  bool surfaceless_ = false;
 
   size_t width_px_;
   size_t height_px_;
 
-  PFNEGLSETDAMAGEREGIONKHRPROC eglSetDamageRegionKHR_ = nullptr;
   PFNEGLSWAPBUFFERSWITHDAMAGEEXTPROC eglSwapBuffersWithDamageEXT_ = nullptr;
 
+  // Whether EGL_EXT_buffer_age (or EGL_KHR_partial_update) is supported.
+  bool buffer_age_supported_ = false;
+
   // Keeps track of the most recent frame damages so that existing damage can
   // be easily computed.
-  std::list<FlutterRect> damage_history_;
+  DamageHistory damage_history_;
 
   // Keeps track of the existing damage associated with each FBO ID
-  std::unordered_map<intptr_t, FlutterRect*> existing_damage_map_;
+  std::unordered_map<intptr_t, std::vector<FlutterRect>> existing_damage_map_;
 };
 
 }  // namespace flutter
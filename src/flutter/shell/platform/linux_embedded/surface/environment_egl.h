@@ -8,6 +8,7 @@
 #include <EGL/egl.h>
 
 #include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/egl_share_group.h"
 #include "flutter/shell/platform/linux_embedded/surface/egl_utils.h"
 
 namespace flutter {
@@ -38,21 +39,18 @@ class EnvironmentEgl {
       : display_(EGL_NO_DISPLAY), sub_environment_(sub_environment) {}
 
   ~EnvironmentEgl() {
-    if (display_ != EGL_NO_DISPLAY && !sub_environment_) {
-      if (eglTerminate(display_) != EGL_TRUE) {
-        ELINUX_LOG(ERROR) << "Failed to terminate the EGL display: "
-                          << get_egl_error_cause();
-      }
+    if (display_acquired_) {
+      EglShareGroup::ReleaseDisplay(display_);
       display_ = EGL_NO_DISPLAY;
     }
   }
 
-  bool InitializeEgl() const {
-    if (eglInitialize(display_, nullptr, nullptr) != EGL_TRUE) {
-      ELINUX_LOG(ERROR) << "Failed to initialize the EGL display: "
-                        << get_egl_error_cause();
+  // Initializes the EGL display, which may be shared with other engines.
+  bool InitializeEgl() {
+    if (!EglShareGroup::AcquireDisplay(display_)) {
       return false;
     }
+    display_acquired_ = true;
 
     if (eglBindAPI(EGL_OPENGL_ES_API) != EGL_TRUE) {
       ELINUX_LOG(ERROR) << "Failed to bind EGL API: " << get_egl_error_cause();
@@ -70,6 +68,8 @@ class EnvironmentEgl {
   EGLDisplay display_;
   bool valid_ = false;
   bool sub_environment_;
+  // True if the display has been initialized through EglShareGroup.
+  bool display_acquired_ = false;
 };
 
 }  // namespace flutter
@@ -0,0 +1,51 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/surface/environment_egl_headless.h"
+
+#include <EGL/eglext.h>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/egl_utils.h"
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+namespace flutter {
+
+namespace {
+constexpr char kEglExtensionPlatformSurfaceless[] =
+    "EGL_MESA_platform_surfaceless";
+}  // namespace
+
+EnvironmentEglHeadless::EnvironmentEglHeadless(bool sub_environment)
+    : EnvironmentEgl(sub_environment) {
+  // The client extensions are queried without a display.
+  auto client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  if (has_egl_extension(client_extensions, kEglExtensionPlatformSurfaceless)) {
+    auto get_platform_display =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (get_platform_display) {
+      display_ = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA,
+                                      EGL_DEFAULT_DISPLAY, nullptr);
+    }
+  }
+  if (display_ == EGL_NO_DISPLAY) {
+    ELINUX_LOG(WARNING) << kEglExtensionPlatformSurfaceless
+                        << " isn't supported. Falls back to the default EGL "
+                           "display.";
+    display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  }
+  if (display_ == EGL_NO_DISPLAY) {
+    ELINUX_LOG(ERROR) << "Failed to get the EGL display: "
+                      << get_egl_error_cause();
+    return;
+  }
+
+  valid_ = InitializeEgl();
+}
+
+}  // namespace flutter
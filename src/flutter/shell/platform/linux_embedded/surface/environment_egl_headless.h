@@ -0,0 +1,24 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_ENVIRONMENT_EGL_HEADLESS_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_ENVIRONMENT_EGL_HEADLESS_H_
+
+#include <EGL/egl.h>
+
+#include "flutter/shell/platform/linux_embedded/surface/environment_egl.h"
+
+namespace flutter {
+
+// An EGL display which doesn't need any window system or display device, i.e.
+// the surfaceless platform of Mesa (e.g. llvmpipe on machines without a GPU).
+class EnvironmentEglHeadless : public EnvironmentEgl {
+ public:
+  EnvironmentEglHeadless(bool sub_environment = false);
+  ~EnvironmentEglHeadless() = default;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_ENVIRONMENT_EGL_HEADLESS_H_
@@ -19,6 +19,7 @@ bool SurfaceGl::GLContextClearCurrent() const {
 }
 
 bool SurfaceGl::GLContextPresent(uint32_t fbo_id) const {
+  native_window_->PrepareSwapBuffers();
   if (!onscreen_surface_->SwapBuffers()) {
     return false;
   }
@@ -27,6 +28,7 @@ bool SurfaceGl::GLContextPresent(uint32_t fbo_id) const {
 }
 
 bool SurfaceGl::GLContextPresentWithInfo(const FlutterPresentInfo* info) const {
+  native_window_->PrepareSwapBuffers();
   if (!onscreen_surface_->SwapBuffers(info)) {
     return false;
   }
@@ -47,4 +49,8 @@ void* SurfaceGl::GlProcResolver(const char* name) const {
   return context_->GlProcResolver(name);
 }
 
+bool SurfaceGl::IsSharedWith(const SurfaceGl& other) const {
+  return context_->IsSharedWith(*other.context_);
+}
+
 }  // namespace flutter
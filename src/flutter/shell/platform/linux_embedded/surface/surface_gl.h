@@ -39,6 +39,10 @@ class SurfaceGl final : public SurfaceBase, public SurfaceGlDelegate {
 
   // |SurfaceGlDelegate|
   void* GlProcResolver(const char* name) const override;
+
+  // Returns true if the GL objects of |other|'s context can be used in the
+  // context of this surface.
+  bool IsSharedWith(const SurfaceGl& other) const;
 };
 
 }  // namespace flutter
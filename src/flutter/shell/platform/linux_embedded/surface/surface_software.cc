@@ -0,0 +1,121 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/surface/surface_software.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+constexpr size_t kBytesPerPixel = 4;
+}  // namespace
+
+bool SurfaceSoftware::SetNativeWindow(NativeWindow* window) {
+  native_window_ = window;
+  frame_number_ = 0;
+  damage_history_.Clear();
+  return true;
+}
+
+bool SurfaceSoftware::OnScreenSurfaceResize(const size_t width_px,
+                                            const size_t height_px) {
+  if (!native_window_->Resize(width_px, height_px)) {
+    ELINUX_LOG(ERROR) << "Failed to resize.";
+    return false;
+  }
+  return true;
+}
+
+bool SurfaceSoftware::Present(const void* allocation,
+                              size_t row_bytes,
+                              size_t height) {
+  const auto* frame = static_cast<const uint8_t*>(allocation);
+  const auto damage = UpdateLastFrame(frame, row_bytes, height);
+
+  auto* buffer = native_window_->AcquireSoftwareBuffer();
+  if (!buffer) {
+    ELINUX_LOG(ERROR) << "Failed to acquire a buffer.";
+    return false;
+  }
+
+  // The buffer also misses the damage of the frames presented since it was
+  // last used.
+  auto copy_rect = damage;
+  std::vector<FlutterRect> existing_damage;
+  const int buffer_age =
+      buffer->frame_number ? frame_number_ - buffer->frame_number + 1 : 0;
+  if (damage_history_.GetExistingDamage(buffer_age, existing_damage)) {
+    for (const auto& rect : existing_damage) {
+      if (rect.bottom <= rect.top) {
+        continue;
+      }
+      if (copy_rect.bottom <= copy_rect.top) {
+        copy_rect = rect;
+        continue;
+      }
+      copy_rect.top = std::min(copy_rect.top, rect.top);
+      copy_rect.bottom = std::max(copy_rect.bottom, rect.bottom);
+    }
+  } else {
+    copy_rect = {0, 0, static_cast<double>(row_bytes / kBytesPerPixel),
+                 static_cast<double>(height)};
+  }
+
+  // The sizes differ only for a moment while the window is being resized.
+  const size_t top = copy_rect.top;
+  const size_t bottom = std::min<size_t>(
+      {static_cast<size_t>(copy_rect.bottom),
+       static_cast<size_t>(buffer->height), height});
+  const size_t copy_bytes =
+      std::min(row_bytes, buffer->width * kBytesPerPixel);
+  for (size_t y = top; y < bottom; y++) {
+    std::memcpy(buffer->pixels + y * buffer->stride, frame + y * row_bytes,
+                copy_bytes);
+  }
+
+  buffer->frame_number = ++frame_number_;
+  damage_history_.Push(&damage, 1);
+  return native_window_->PresentSoftwareBuffer(buffer, damage);
+}
+
+FlutterRect SurfaceSoftware::UpdateLastFrame(const uint8_t* frame,
+                                             size_t row_bytes,
+                                             size_t height) {
+  const double width = row_bytes / kBytesPerPixel;
+  if (row_bytes != last_row_bytes_ || height != last_height_) {
+    last_frame_.assign(frame, frame + row_bytes * height);
+    last_row_bytes_ = row_bytes;
+    last_height_ = height;
+    return {0, 0, width, static_cast<double>(height)};
+  }
+
+  // Flutter mostly repaints a few regions at a time, so only the band of rows
+  // between the first and the last changed ones is considered.
+  size_t top = 0;
+  while (top < height &&
+         std::memcmp(frame + top * row_bytes,
+                     last_frame_.data() + top * row_bytes, row_bytes) == 0) {
+    top++;
+  }
+  if (top == height) {
+    return {0, 0, 0, 0};
+  }
+  size_t bottom = height;
+  while (bottom > top && std::memcmp(frame + (bottom - 1) * row_bytes,
+                                     last_frame_.data() +
+                                         (bottom - 1) * row_bytes,
+                                     row_bytes) == 0) {
+    bottom--;
+  }
+
+  std::memcpy(last_frame_.data() + top * row_bytes, frame + top * row_bytes,
+              (bottom - top) * row_bytes);
+  return {0, static_cast<double>(top), width, static_cast<double>(bottom)};
+}
+
+}  // namespace flutter
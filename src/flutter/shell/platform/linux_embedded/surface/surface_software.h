@@ -0,0 +1,63 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_SURFACE_SOFTWARE_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_SURFACE_SOFTWARE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "flutter/shell/platform/linux_embedded/surface/damage_history.h"
+#include "flutter/shell/platform/linux_embedded/window/native_window.h"
+
+namespace flutter {
+
+// Presents the frames of the software renderer by copying them into the
+// buffers of the native window.
+//
+// Each frame is compared with the previous one, so that only the rows which
+// have changed are copied into the buffers and reported to the display.
+class SurfaceSoftware {
+ public:
+  SurfaceSoftware() = default;
+  ~SurfaceSoftware() = default;
+
+  // Shows a surface is valid or not.
+  bool IsValid() const { return native_window_ != nullptr; }
+
+  // Sets a native platform's window.
+  bool SetNativeWindow(NativeWindow* window);
+
+  // Changes the size of the window buffers.
+  // @param[in] width_px       Physical width of the surface.
+  // @param[in] height_px      Physical height of the surface.
+  bool OnScreenSurfaceResize(const size_t width_px, const size_t height_px);
+
+  // Copies a frame of the software renderer into a window buffer and presents
+  // it. Called on the raster thread.
+  bool Present(const void* allocation, size_t row_bytes, size_t height);
+
+ private:
+  // Compares |frame| with the previous frame and keeps it. Returns the rows
+  // which have changed.
+  FlutterRect UpdateLastFrame(const uint8_t* frame,
+                              size_t row_bytes,
+                              size_t height);
+
+  NativeWindow* native_window_ = nullptr;
+
+  // Copy of the previous frame.
+  std::vector<uint8_t> last_frame_;
+  size_t last_row_bytes_ = 0;
+  size_t last_height_ = 0;
+
+  // Number of the frames presented so far.
+  uint64_t frame_number_ = 0;
+  DamageHistory damage_history_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_SURFACE_SOFTWARE_H_
@@ -0,0 +1,395 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/surface/surface_vulkan.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+// The formats supported by the engine, in order of preference.
+constexpr VkFormat kSupportedFormats[] = {
+    VK_FORMAT_B8G8R8A8_UNORM,
+    VK_FORMAT_R8G8B8A8_UNORM,
+};
+
+VkPresentModeKHR ChoosePresentMode(VkPhysicalDevice physical_device,
+                                   VkSurfaceKHR surface,
+                                   bool enable_vsync) {
+  // FIFO is always supported.
+  if (enable_vsync) {
+    return VK_PRESENT_MODE_FIFO_KHR;
+  }
+
+  uint32_t count = 0;
+  vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &count,
+                                            nullptr);
+  std::vector<VkPresentModeKHR> modes(count);
+  vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &count,
+                                            modes.data());
+  for (auto mode :
+       {VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR}) {
+    if (std::find(modes.begin(), modes.end(), mode) != modes.end()) {
+      return mode;
+    }
+  }
+  return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+VkCompositeAlphaFlagBitsKHR ChooseCompositeAlpha(
+    VkCompositeAlphaFlagsKHR supported) {
+  for (auto alpha : {VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+                     VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR,
+                     VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR}) {
+    if (supported & alpha) {
+      return alpha;
+    }
+  }
+  return VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR;
+}
+}  // namespace
+
+SurfaceVulkan::SurfaceVulkan(std::unique_ptr<ContextVulkan> context)
+    : context_(std::move(context)) {}
+
+SurfaceVulkan::~SurfaceVulkan() {
+  DestroySwapchain(swapchain_);
+  if (acquire_fence_ != VK_NULL_HANDLE) {
+    vkDestroyFence(context_->Device(), acquire_fence_, nullptr);
+  }
+}
+
+bool SurfaceVulkan::SetNativeWindow(NativeWindow* window) {
+  if (!context_->IsValid()) {
+    return false;
+  }
+
+  VkFenceCreateInfo fence_info = {};
+  fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+  if (acquire_fence_ == VK_NULL_HANDLE &&
+      vkCreateFence(context_->Device(), &fence_info, nullptr,
+                    &acquire_fence_) != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create a fence.";
+    return false;
+  }
+
+  native_window_ = window;
+  return true;
+}
+
+bool SurfaceVulkan::OnScreenSurfaceResize(const size_t width_px,
+                                          const size_t height_px) {
+  if (!native_window_->Resize(width_px, height_px)) {
+    ELINUX_LOG(ERROR) << "Failed to resize.";
+    return false;
+  }
+  return true;
+}
+
+FlutterVulkanImage SurfaceVulkan::AcquireImage(uint32_t width,
+                                               uint32_t height) {
+  FlutterVulkanImage image = {};
+  image.struct_size = sizeof(FlutterVulkanImage);
+
+  // Retried once when the swapchain is out of date.
+  for (int attempt = 0; attempt < 2; attempt++) {
+    if (swapchain_ == VK_NULL_HANDLE || need_recreate_swapchain_ ||
+        requested_extent_.width != width ||
+        requested_extent_.height != height) {
+      if (!CreateSwapchain(width, height)) {
+        return image;
+      }
+    }
+    if (extent_.width != width || extent_.height != height) {
+      // Rendering the frame into the images would be out of their bounds.
+      ELINUX_LOG(DEBUG) << "Dropped a frame of " << width << "x" << height
+                        << " for the swapchain of " << extent_.width << "x"
+                        << extent_.height;
+      return image;
+    }
+
+    auto result =
+        vkAcquireNextImageKHR(context_->Device(), swapchain_, UINT64_MAX,
+                              VK_NULL_HANDLE, acquire_fence_,
+                              &current_image_index_);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+      need_recreate_swapchain_ = true;
+      continue;
+    }
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+      ELINUX_LOG(ERROR) << "Failed to acquire a swapchain image: " << result;
+      return image;
+    }
+    if (result == VK_SUBOPTIMAL_KHR) {
+      need_recreate_swapchain_ = true;
+    }
+
+    vkWaitForFences(context_->Device(), 1, &acquire_fence_, VK_TRUE,
+                    UINT64_MAX);
+    vkResetFences(context_->Device(), 1, &acquire_fence_);
+
+    image.image = reinterpret_cast<uint64_t>(images_[current_image_index_]);
+    image.format = format_;
+    return image;
+  }
+
+  ELINUX_LOG(ERROR) << "The swapchain is out of date.";
+  return image;
+}
+
+bool SurfaceVulkan::Present(const FlutterVulkanImage* image) {
+  if (swapchain_ == VK_NULL_HANDLE ||
+      image->image !=
+          reinterpret_cast<uint64_t>(images_[current_image_index_])) {
+    ELINUX_LOG(ERROR) << "The image wasn't acquired from the swapchain.";
+    return false;
+  }
+
+  VkSubmitInfo submit_info = {};
+  submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submit_info.commandBufferCount = 1;
+  submit_info.pCommandBuffers = &present_commands_[current_image_index_];
+  submit_info.signalSemaphoreCount = 1;
+  submit_info.pSignalSemaphores = &present_semaphores_[current_image_index_];
+
+  VkPresentInfoKHR present_info = {};
+  present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+  present_info.waitSemaphoreCount = 1;
+  present_info.pWaitSemaphores = &present_semaphores_[current_image_index_];
+  present_info.swapchainCount = 1;
+  present_info.pSwapchains = &swapchain_;
+  present_info.pImageIndices = &current_image_index_;
+
+  VkResult result;
+  {
+    std::lock_guard<std::mutex> lock(ContextVulkan::QueueMutex());
+    result = vkQueueSubmit(context_->Queue(), 1, &submit_info, VK_NULL_HANDLE);
+    if (result != VK_SUCCESS) {
+      ELINUX_LOG(ERROR) << "Failed to submit the layout transition: "
+                        << result;
+      return false;
+    }
+    result = vkQueuePresentKHR(context_->Queue(), &present_info);
+  }
+
+  if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+    need_recreate_swapchain_ = true;
+    return true;
+  }
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to present: " << result;
+    return false;
+  }
+  return true;
+}
+
+bool SurfaceVulkan::CreateSwapchain(uint32_t width, uint32_t height) {
+  auto physical_device = context_->PhysicalDevice();
+  auto surface = context_->Surface();
+
+  VkSurfaceCapabilitiesKHR capabilities;
+  if (vkGetPhysicalDeviceSurfaceCapabilitiesKHR(
+          physical_device, surface, &capabilities) != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to get the surface capabilities.";
+    return false;
+  }
+
+  uint32_t count = 0;
+  vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &count,
+                                       nullptr);
+  std::vector<VkSurfaceFormatKHR> formats(count);
+  vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &count,
+                                       formats.data());
+  VkSurfaceFormatKHR surface_format = {VK_FORMAT_UNDEFINED,
+                                       VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+  for (auto format : kSupportedFormats) {
+    auto found = std::find_if(formats.begin(), formats.end(),
+                              [format](const VkSurfaceFormatKHR& f) {
+                                return f.format == format &&
+                                       f.colorSpace ==
+                                           VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+                              });
+    if (found != formats.end()) {
+      surface_format = *found;
+      break;
+    }
+  }
+  if (surface_format.format == VK_FORMAT_UNDEFINED) {
+    ELINUX_LOG(ERROR) << "The surface doesn't support any of the formats.";
+    return false;
+  }
+
+  // The extent is fixed to the size of the window on some platforms, e.g.
+  // X11, where the window system resizes the window before the engine renders
+  // the frames of the new size.
+  constexpr uint32_t kUndefinedExtent = 0xFFFFFFFF;
+  VkExtent2D extent = capabilities.currentExtent;
+  if (extent.width == kUndefinedExtent) {
+    extent.width = std::clamp(width, capabilities.minImageExtent.width,
+                              capabilities.maxImageExtent.width);
+    extent.height = std::clamp(height, capabilities.minImageExtent.height,
+                               capabilities.maxImageExtent.height);
+  }
+  if (extent.width == 0 || extent.height == 0) {
+    // e.g. the window is minimized.
+    return false;
+  }
+
+  uint32_t image_count = capabilities.minImageCount + 1;
+  if (capabilities.maxImageCount > 0) {
+    image_count = std::min(image_count, capabilities.maxImageCount);
+  }
+
+  VkSwapchainCreateInfoKHR create_info = {};
+  create_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+  create_info.surface = surface;
+  create_info.minImageCount = image_count;
+  create_info.imageFormat = surface_format.format;
+  create_info.imageColorSpace = surface_format.colorSpace;
+  create_info.imageExtent = extent;
+  create_info.imageArrayLayers = 1;
+  create_info.imageUsage =
+      (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+       VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+       VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT) &
+      capabilities.supportedUsageFlags;
+  create_info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  create_info.preTransform =
+      (capabilities.supportedTransforms & VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR)
+          ? VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR
+          : capabilities.currentTransform;
+  create_info.compositeAlpha =
+      ChooseCompositeAlpha(capabilities.supportedCompositeAlpha);
+  create_info.presentMode = ChoosePresentMode(physical_device, surface,
+                                              native_window_->EnableVsync());
+  create_info.clipped = VK_TRUE;
+  create_info.oldSwapchain = swapchain_;
+
+  VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+  auto result = vkCreateSwapchainKHR(context_->Device(), &create_info,
+                                     nullptr, &swapchain);
+  DestroySwapchain(swapchain_);
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create the swapchain: " << result;
+    return false;
+  }
+  swapchain_ = swapchain;
+  format_ = surface_format.format;
+  extent_ = extent;
+  // Not to recreate the swapchain for every frame of a size it can't have.
+  requested_extent_ = {width, height};
+  need_recreate_swapchain_ = false;
+
+  vkGetSwapchainImagesKHR(context_->Device(), swapchain_, &count, nullptr);
+  images_.resize(count);
+  vkGetSwapchainImagesKHR(context_->Device(), swapchain_, &count,
+                          images_.data());
+  if (!CreatePresentCommands()) {
+    DestroySwapchain(swapchain_);
+    return false;
+  }
+  return true;
+}
+
+void SurfaceVulkan::DestroySwapchain(VkSwapchainKHR swapchain) {
+  if (swapchain == VK_NULL_HANDLE) {
+    return;
+  }
+
+  // The previous frames may still be using the images and the commands.
+  {
+    std::lock_guard<std::mutex> lock(ContextVulkan::QueueMutex());
+    vkQueueWaitIdle(context_->Queue());
+  }
+  DestroyPresentCommands();
+  vkDestroySwapchainKHR(context_->Device(), swapchain, nullptr);
+  if (swapchain == swapchain_) {
+    swapchain_ = VK_NULL_HANDLE;
+    images_.clear();
+  }
+}
+
+bool SurfaceVulkan::CreatePresentCommands() {
+  auto device = context_->Device();
+
+  VkCommandPoolCreateInfo pool_info = {};
+  pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+  pool_info.queueFamilyIndex = context_->QueueFamilyIndex();
+  if (vkCreateCommandPool(device, &pool_info, nullptr, &command_pool_) !=
+      VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create a command pool.";
+    command_pool_ = VK_NULL_HANDLE;
+    return false;
+  }
+
+  VkCommandBufferAllocateInfo allocate_info = {};
+  allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  allocate_info.commandPool = command_pool_;
+  allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  allocate_info.commandBufferCount = images_.size();
+  present_commands_.resize(images_.size());
+  if (vkAllocateCommandBuffers(device, &allocate_info,
+                               present_commands_.data()) != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to allocate command buffers.";
+    present_commands_.clear();
+    return false;
+  }
+
+  VkSemaphoreCreateInfo semaphore_info = {};
+  semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+  for (size_t i = 0; i < images_.size(); i++) {
+    VkSemaphore semaphore;
+    if (vkCreateSemaphore(device, &semaphore_info, nullptr, &semaphore) !=
+        VK_SUCCESS) {
+      ELINUX_LOG(ERROR) << "Failed to create a semaphore.";
+      return false;
+    }
+    present_semaphores_.push_back(semaphore);
+
+    VkCommandBufferBeginInfo begin_info = {};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    vkBeginCommandBuffer(present_commands_[i], &begin_info);
+
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask = 0;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = images_[i];
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+    vkCmdPipelineBarrier(present_commands_[i],
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+                         0, nullptr, 1, &barrier);
+
+    if (vkEndCommandBuffer(present_commands_[i]) != VK_SUCCESS) {
+      ELINUX_LOG(ERROR) << "Failed to record the layout transition.";
+      return false;
+    }
+  }
+  return true;
+}
+
+void SurfaceVulkan::DestroyPresentCommands() {
+  auto device = context_->Device();
+  for (auto semaphore : present_semaphores_) {
+    vkDestroySemaphore(device, semaphore, nullptr);
+  }
+  present_semaphores_.clear();
+  present_commands_.clear();
+  if (command_pool_ != VK_NULL_HANDLE) {
+    // The command buffers are freed with the pool.
+    vkDestroyCommandPool(device, command_pool_, nullptr);
+    command_pool_ = VK_NULL_HANDLE;
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,91 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_SURFACE_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_SURFACE_VULKAN_H_
+
+#include <vulkan/vulkan.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "flutter/shell/platform/embedder/embedder.h"
+#include "flutter/shell/platform/linux_embedded/surface/context_vulkan.h"
+#include "flutter/shell/platform/linux_embedded/window/native_window.h"
+
+namespace flutter {
+
+// Presents the frames of the Vulkan renderer with a swapchain of the window
+// surface. The engine renders into the swapchain images in
+// VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, and they are transitioned to
+// VK_IMAGE_LAYOUT_PRESENT_SRC_KHR when presented.
+class SurfaceVulkan {
+ public:
+  SurfaceVulkan(std::unique_ptr<ContextVulkan> context);
+  ~SurfaceVulkan();
+
+  // Shows a surface is valid or not.
+  bool IsValid() const { return native_window_ && context_->IsValid(); }
+
+  // Sets a native platform's window.
+  bool SetNativeWindow(NativeWindow* window);
+
+  // Changes the size of the window. The swapchain is recreated when the
+  // engine renders a frame of the new size.
+  // @param[in] width_px       Physical width of the surface.
+  // @param[in] height_px      Physical height of the surface.
+  bool OnScreenSurfaceResize(const size_t width_px, const size_t height_px);
+
+  ContextVulkan* Context() const { return context_.get(); }
+
+  // Acquires the next swapchain image for a frame of |width| x |height|, or
+  // returns an image whose handle is 0 on failure. It also fails if the
+  // swapchain can't have the size of the frame, e.g. because the window
+  // system has already resized the window, and GetExtent() is the size the
+  // frames have to be rendered in. Called on the raster thread.
+  FlutterVulkanImage AcquireImage(uint32_t width, uint32_t height);
+
+  // Returns the size of the swapchain images. Called on the raster thread.
+  VkExtent2D GetExtent() const { return extent_; }
+
+  // Presents |image| returned by AcquireImage(). Called on the raster thread.
+  bool Present(const FlutterVulkanImage* image);
+
+ private:
+  bool CreateSwapchain(uint32_t width, uint32_t height);
+
+  void DestroySwapchain(VkSwapchainKHR swapchain);
+
+  // Records the layout transitions of the swapchain images for presenting.
+  bool CreatePresentCommands();
+
+  void DestroyPresentCommands();
+
+  std::unique_ptr<ContextVulkan> context_;
+  NativeWindow* native_window_ = nullptr;
+
+  VkSwapchainKHR swapchain_ = VK_NULL_HANDLE;
+  VkFormat format_ = VK_FORMAT_UNDEFINED;
+  VkExtent2D extent_ = {};
+  // The frame size the swapchain was created for, which differs from
+  // |extent_| when the surface has a fixed size.
+  VkExtent2D requested_extent_ = {};
+  bool need_recreate_swapchain_ = false;
+  std::vector<VkImage> images_;
+  uint32_t current_image_index_ = 0;
+
+  // Signaled when the acquired image is ready to be rendered into.
+  VkFence acquire_fence_ = VK_NULL_HANDLE;
+
+  VkCommandPool command_pool_ = VK_NULL_HANDLE;
+  // The layout transition and the semaphore signaled by it for each image.
+  std::vector<VkCommandBuffer> present_commands_;
+  std::vector<VkSemaphore> present_semaphores_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_SURFACE_SURFACE_VULKAN_H_
@@ -35,4 +35,10 @@ void VsyncWaiter::NotifyVsync(FLUTTER_API_SYMBOL(FlutterEngine) engine,
   }
 }
 
+void VsyncWaiter::Reset() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  baton_ = 0;
+  event_counter_ = 0;
+}
+
 }  // namespace flutter
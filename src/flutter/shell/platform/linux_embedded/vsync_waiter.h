@@ -24,6 +24,10 @@ class VsyncWaiter {
                    uint64_t frame_start_time_nanos,
                    uint64_t frame_target_time_nanos);
 
+  // Drops the pending vsync request. NotifyVsync() may be called on another
+  // thread, so this must be called before shutting down the engine.
+  void Reset();
+
  private:
   intptr_t baton_;
   uint32_t event_counter_;
@@ -0,0 +1,63 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/drm_connector_utils.h"
+
+#include <cstdlib>
+#include <sstream>
+
+namespace flutter {
+
+namespace {
+constexpr char kFlutterDrmConnectorEnvironmentKey[] = "FLUTTER_DRM_CONNECTOR";
+}  // namespace
+
+std::vector<std::string> GetConnectorNamesFromEnvironment() {
+  std::vector<std::string> names;
+  auto value = std::getenv(kFlutterDrmConnectorEnvironmentKey);
+  if (!value) {
+    return names;
+  }
+  std::istringstream stream(value);
+  std::string name;
+  while (std::getline(stream, name, ',')) {
+    if (!name.empty()) {
+      names.push_back(name);
+    }
+  }
+  return names;
+}
+
+size_t SelectMirrorMode(const std::vector<DrmModeSize>& modes,
+                        uint32_t width,
+                        uint32_t height) {
+  for (size_t i = 0; i < modes.size(); i++) {
+    if (modes[i].width == width && modes[i].height == height) {
+      return i;
+    }
+  }
+
+  auto fits = [width, height](const DrmModeSize& mode) {
+    return mode.width <= width && mode.height <= height;
+  };
+  if (fits(modes[0])) {
+    return 0;
+  }
+  bool found = false;
+  size_t largest = 0;
+  for (size_t i = 1; i < modes.size(); i++) {
+    const auto& mode = modes[i];
+    if (fits(mode) &&
+        (!found || static_cast<uint64_t>(mode.width) * mode.height >
+                       static_cast<uint64_t>(modes[largest].width) *
+                           modes[largest].height)) {
+      largest = i;
+      found = true;
+    }
+  }
+  // Otherwise setting the CRTC may fail since the frames don't cover the mode.
+  return largest;
+}
+
+}  // namespace flutter
@@ -0,0 +1,38 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_DRM_CONNECTOR_UTILS_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_DRM_CONNECTOR_UTILS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace flutter {
+
+// The size of a mode of a DRM connector.
+struct DrmModeSize {
+  uint32_t width;
+  uint32_t height;
+};
+
+// Returns the names of the connectors in FLUTTER_DRM_CONNECTOR, which are
+// separated by commas, e.g. "HDMI-A-1,DSI-1".
+std::vector<std::string> GetConnectorNamesFromEnvironment();
+
+// Returns the index of the mode in |modes|, which must not be empty and
+// starts with the preferred mode, that a mirror connector shows frames of
+// |width|x|height| in.
+//
+// A mode of the size of the frames needs no scaling. Otherwise the frames must
+// cover the mode to set the CRTC before the plane scales them, so the
+// preferred mode is used if it fits, or else the largest one which fits.
+size_t SelectMirrorMode(const std::vector<DrmModeSize>& modes,
+                        uint32_t width,
+                        uint32_t height);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_DRM_CONNECTOR_UTILS_H_
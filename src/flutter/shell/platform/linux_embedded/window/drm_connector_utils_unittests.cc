@@ -0,0 +1,68 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/drm_connector_utils.h"
+
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+std::vector<std::string> GetConnectorNames(const char* value) {
+  setenv("FLUTTER_DRM_CONNECTOR", value, 1);
+  auto names = GetConnectorNamesFromEnvironment();
+  unsetenv("FLUTTER_DRM_CONNECTOR");
+  return names;
+}
+}  // namespace
+
+TEST(DrmConnectorUtilsTest, NoConnectorNamesWithoutEnvironment) {
+  unsetenv("FLUTTER_DRM_CONNECTOR");
+  EXPECT_TRUE(GetConnectorNamesFromEnvironment().empty());
+  EXPECT_TRUE(GetConnectorNames("").empty());
+}
+
+TEST(DrmConnectorUtilsTest, SplitsConnectorNamesAtCommas) {
+  EXPECT_EQ(GetConnectorNames("HDMI-A-1"),
+            (std::vector<std::string>{"HDMI-A-1"}));
+  EXPECT_EQ(GetConnectorNames("HDMI-A-1,DSI-1,DP-2"),
+            (std::vector<std::string>{"HDMI-A-1", "DSI-1", "DP-2"}));
+  // Empty names are skipped.
+  EXPECT_EQ(GetConnectorNames(",HDMI-A-1,,DSI-1,"),
+            (std::vector<std::string>{"HDMI-A-1", "DSI-1"}));
+}
+
+TEST(DrmConnectorUtilsTest, SelectsTheModeOfTheFrameSize) {
+  const std::vector<DrmModeSize> modes = {
+      {3840, 2160}, {1920, 1080}, {1280, 720}};
+  EXPECT_EQ(SelectMirrorMode(modes, 1920, 1080), 1u);
+  EXPECT_EQ(SelectMirrorMode(modes, 1280, 720), 2u);
+}
+
+TEST(DrmConnectorUtilsTest, SelectsThePreferredModeIfItFits) {
+  const std::vector<DrmModeSize> modes = {
+      {1280, 720}, {1920, 1080}, {640, 480}};
+  EXPECT_EQ(SelectMirrorMode(modes, 1920, 1200), 0u);
+}
+
+TEST(DrmConnectorUtilsTest, SelectsTheLargestModeWhichFits) {
+  const std::vector<DrmModeSize> modes = {
+      {3840, 2160}, {1280, 720}, {1600, 900}, {640, 480}, {1920, 1200}};
+  // 1920x1200 is taller than the frames, so it doesn't fit.
+  EXPECT_EQ(SelectMirrorMode(modes, 1920, 1080), 2u);
+}
+
+TEST(DrmConnectorUtilsTest, SelectsThePreferredModeIfNoneFits) {
+  const std::vector<DrmModeSize> modes = {{3840, 2160}, {1920, 1080}};
+  EXPECT_EQ(SelectMirrorMode(modes, 800, 480), 0u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -5,9 +5,12 @@
 #ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_ELINUX_WINDOW_H_
 #define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_ELINUX_WINDOW_H_
 
+#include <algorithm>
 #include <cmath>
 
+#include "flutter/shell/platform/linux_embedded/logger.h"
 #include "flutter/shell/platform/linux_embedded/public/flutter_elinux.h"
+#include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
 #include "flutter/shell/platform/linux_embedded/window_binding_handler.h"
 
 namespace flutter {
@@ -20,14 +23,28 @@ class ELinuxWindow {
  protected:
   virtual bool IsValid() const = 0;
 
+  // Sets the view properties, falling back to the renderers of this build.
+  void SetViewProperties(const FlutterDesktopViewProperties& view_properties) {
+    view_properties_ = view_properties;
+#if !defined(ENABLE_VULKAN)
+    if (view_properties_.renderer_type ==
+        FlutterDesktopRendererType::kRendererVulkan) {
+      ELINUX_LOG(WARNING) << "The Vulkan renderer isn't enabled in this build "
+                             "(ENABLE_VULKAN), use OpenGL ES.";
+      view_properties_.renderer_type =
+          FlutterDesktopRendererType::kRendererOpenGL;
+    }
+#endif
+  }
+
   // Get current window width in physical pixels.
   uint32_t GetCurrentWidth() const {
-    return view_properties_.width * current_scale_;
+    return std::round(view_properties_.width * current_scale_);
   }
 
   // Get current window height in physical pixels.
   uint32_t GetCurrentHeight() const {
-    return view_properties_.height * current_scale_;
+    return std::round(view_properties_.height * current_scale_);
   }
 
   void SetRotation(FlutterDesktopViewRotation rotation) {
@@ -42,6 +59,46 @@ class ELinuxWindow {
     }
   }
 
+  // Returns the EGL config attributes requested by the view properties.
+  EglConfigAttributes GetEglConfigAttributes() const {
+    EglConfigAttributes attributes;
+    switch (view_properties_.color_format) {
+      case FlutterDesktopColorFormat::kColorFormatRGB565:
+        attributes.red_size = 5;
+        attributes.green_size = 6;
+        attributes.blue_size = 5;
+        attributes.alpha_size = 0;
+        break;
+      case FlutterDesktopColorFormat::kColorFormatXRGB8888:
+        attributes.alpha_size = 0;
+        break;
+      case FlutterDesktopColorFormat::kColorFormatARGB8888:
+        attributes.alpha_size = 8;
+        break;
+      case FlutterDesktopColorFormat::kColorFormatXRGB2101010:
+        attributes.red_size = 10;
+        attributes.green_size = 10;
+        attributes.blue_size = 10;
+        attributes.alpha_size = 0;
+        break;
+      case FlutterDesktopColorFormat::kColorFormatARGB2101010:
+        attributes.red_size = 10;
+        attributes.green_size = 10;
+        attributes.blue_size = 10;
+        attributes.alpha_size = 2;
+        break;
+      default:
+        break;
+    }
+    if (view_properties_.opaque) {
+      attributes.alpha_size = 0;
+    }
+    attributes.depth_size = std::max(view_properties_.depth_size, 0);
+    attributes.stencil_size = std::max(view_properties_.stencil_size, 0);
+    attributes.samples = std::max(view_properties_.sample_count, 0);
+    return attributes;
+  }
+
   void NotifyDisplayInfoUpdates() const {
     if (binding_handler_delegate_) {
       binding_handler_delegate_->UpdateDisplayInfo(
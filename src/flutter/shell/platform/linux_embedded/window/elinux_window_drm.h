@@ -25,8 +25,16 @@
 
 #include "flutter/shell/platform/linux_embedded/logger.h"
 #include "flutter/shell/platform/linux_embedded/surface/surface_gl.h"
+#include "flutter/shell/platform/linux_embedded/surface/surface_software.h"
+#if defined(ENABLE_VULKAN)
+#include "flutter/shell/platform/linux_embedded/surface/surface_vulkan.h"
+#endif
 #include "flutter/shell/platform/linux_embedded/window/elinux_window.h"
 #include "flutter/shell/platform/linux_embedded/window/native_window_drm.h"
+#include "flutter/shell/platform/linux_embedded/window/native_window_drm_dumb.h"
+#if defined(ENABLE_VULKAN)
+#include "flutter/shell/platform/linux_embedded/window/native_window_drm_vulkan.h"
+#endif
 #include "flutter/shell/platform/linux_embedded/window_binding_handler.h"
 
 namespace flutter {
@@ -41,7 +49,7 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
  public:
   ELinuxWindowDrm(FlutterDesktopViewProperties view_properties)
       : display_valid_(false), is_pending_cursor_add_event_(false) {
-    view_properties_ = view_properties;
+    SetViewProperties(view_properties);
     current_scale_ =
         view_properties.force_scale_factor ? view_properties.scale_factor : 1.0;
     SetRotation(view_properties_.view_rotation);
@@ -126,11 +134,18 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
 
   // |ELinuxWindow|
   bool IsValid() const override {
-    if (!display_valid_ || !native_window_ || !render_surface_ ||
-        !native_window_->IsValid() || !render_surface_->IsValid()) {
+    if (!display_valid_ || !native_window_ || !native_window_->IsValid()) {
       return false;
     }
-    return true;
+    if (software_surface_) {
+      return software_surface_->IsValid();
+    }
+#if defined(ENABLE_VULKAN)
+    if (vulkan_surface_) {
+      return vulkan_surface_->IsValid();
+    }
+#endif
+    return render_surface_ && render_surface_->IsValid();
   }
 
   // |FlutterWindowBindingHandler|
@@ -160,10 +175,38 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
       devices.push_back(const_cast<char*>(kDrmDeviceDefaultFilename));
     }
 
+    const bool software_rendering =
+        view_properties_.renderer_type ==
+        FlutterDesktopRendererType::kRendererSoftware;
+#if defined(ENABLE_VULKAN)
+    const bool vulkan_rendering =
+        view_properties_.renderer_type ==
+        FlutterDesktopRendererType::kRendererVulkan;
+    if (vulkan_rendering && current_rotation_ != 0) {
+      // There's no surface transformation with Vulkan.
+      ELINUX_LOG(WARNING) << "The Vulkan renderer can't rotate the frames. "
+                             "The view rotation is ignored.";
+      SetRotation(FlutterDesktopViewRotation::kRotation_0);
+    }
+#endif
     bool device_found = false;
+    std::string selected_device;
     for (auto i = 0; i < devices.size(); i++) {
-      native_window_ = std::make_unique<T>(
-          devices[i].c_str(), current_rotation_, view_properties_.enable_vsync);
+      if (software_rendering) {
+        native_window_ = std::make_unique<NativeWindowDrmDumb>(
+            devices[i].c_str(), current_rotation_,
+            view_properties_.enable_vsync, GetEglConfigAttributes());
+#if defined(ENABLE_VULKAN)
+      } else if (vulkan_rendering) {
+        native_window_ = std::make_unique<NativeWindowDrmVulkan>(
+            devices[i].c_str(), current_rotation_,
+            view_properties_.enable_vsync, GetEglConfigAttributes());
+#endif
+      } else {
+        native_window_ = std::make_unique<T>(
+            devices[i].c_str(), current_rotation_,
+            view_properties_.enable_vsync, GetEglConfigAttributes());
+      }
       if (!native_window_->IsValid()) {
         ELINUX_LOG(ERROR) << "Failed to create the native window ("
                           << devices[i] << ").";
@@ -179,6 +222,7 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
       }
 
       device_found = true;
+      selected_device = devices[i];
       ELINUX_LOG(INFO) << devices[i] << " was selected as the DRM device.";
     }
     if (!device_found) {
@@ -187,9 +231,40 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
 
     display_valid_ = true;
 
-    render_surface_ = native_window_->CreateRenderSurface(enable_impeller);
-    if (!render_surface_->SetNativeWindow(native_window_.get())) {
-      return false;
+    bool vulkan_surface_created = false;
+#if defined(ENABLE_VULKAN)
+    if (vulkan_rendering) {
+      vulkan_surface_created = CreateVulkanSurface();
+      if (!vulkan_surface_created) {
+        ELINUX_LOG(WARNING) << "Vulkan isn't available, use OpenGL ES.";
+        view_properties_.renderer_type =
+            FlutterDesktopRendererType::kRendererOpenGL;
+        // Drops the DRM master before opening the device again.
+        native_window_ = nullptr;
+        native_window_ = std::make_unique<T>(
+            selected_device.c_str(), current_rotation_,
+            view_properties_.enable_vsync, GetEglConfigAttributes());
+        if (!native_window_->IsValid()) {
+          ELINUX_LOG(ERROR) << "Failed to create the native window ("
+                            << selected_device << ").";
+          return false;
+        }
+      }
+    }
+#endif
+
+    if (software_rendering) {
+      if (current_rotation_ != 0 && !native_window_->IsRotationOffloaded()) {
+        // The frames are presented with the size of the display.
+        SetRotation(FlutterDesktopViewRotation::kRotation_0);
+      }
+      software_surface_ = std::make_unique<SurfaceSoftware>();
+      software_surface_->SetNativeWindow(native_window_.get());
+    } else if (!vulkan_surface_created) {
+      render_surface_ = native_window_->CreateRenderSurface(enable_impeller);
+      if (!render_surface_->SetNativeWindow(native_window_.get())) {
+        return false;
+      }
     }
 
     if (view_properties_.view_mode != FlutterDesktopViewMode::kFullscreen) {
@@ -214,6 +289,10 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
   void DestroyRenderSurface() override {
     // destroy the main surface before destroying the client window on DRM.
     render_surface_ = nullptr;
+    software_surface_ = nullptr;
+#if defined(ENABLE_VULKAN)
+    vulkan_surface_ = nullptr;
+#endif
     native_window_ = nullptr;
   }
 
@@ -227,9 +306,26 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
     return render_surface_.get();
   }
 
+  // |FlutterWindowBindingHandler|
+  SurfaceSoftware* GetSoftwareSurfaceTarget() const override {
+    return software_surface_.get();
+  }
+
+#if defined(ENABLE_VULKAN)
+  // |FlutterWindowBindingHandler|
+  SurfaceVulkan* GetVulkanSurfaceTarget() const override {
+    return vulkan_surface_.get();
+  }
+#endif
+
   // |FlutterWindowBindingHandler|
   uint16_t GetRotationDegree() const override { return current_rotation_; }
 
+  // |FlutterWindowBindingHandler|
+  bool IsRotationOffloaded() const override {
+    return native_window_ && native_window_->IsRotationOffloaded();
+  }
+
   // |FlutterWindowBindingHandler|
   double GetDpiScale() override { return current_scale_; }
 
@@ -254,7 +350,9 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
   }
 
   // |FlutterWindowBindingHandler|
-  std::string GetClipboardData() override { return clipboard_data_; }
+  void GetClipboardData(ClipboardCallback callback) override {
+    callback(clipboard_data_);
+  }
 
   // |FlutterWindowBindingHandler|
   void SetClipboardData(const std::string& data) override {
@@ -275,6 +373,23 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
       .close_restricted = [](int fd, void* user_data) -> void { close(fd); },
   };
 
+#if defined(ENABLE_VULKAN)
+  // Creates the surface of the Vulkan renderer on |native_window_|. Returns
+  // false if no Vulkan device can drive the display.
+  bool CreateVulkanSurface() {
+    auto context = std::make_unique<ContextVulkan>(native_window_.get());
+    if (!context->IsValid()) {
+      return false;
+    }
+    vulkan_surface_ = std::make_unique<SurfaceVulkan>(std::move(context));
+    if (!vulkan_surface_->SetNativeWindow(native_window_.get())) {
+      vulkan_surface_ = nullptr;
+      return false;
+    }
+    return true;
+  }
+#endif
+
   bool RegisterUdevDrmEventLoop(const std::string& device_filename) {
     auto udev = udev_new();
     if (!udev) {
@@ -789,8 +904,13 @@ class ELinuxWindowDrm : public ELinuxWindow, public WindowBindingHandler {
     bool is_pointer_device;
   };
 
-  std::unique_ptr<T> native_window_;
+  // Either T, or NativeWindowDrmDumb for the software renderer.
+  std::unique_ptr<NativeWindowDrm> native_window_;
   std::unique_ptr<SurfaceGl> render_surface_;
+  std::unique_ptr<SurfaceSoftware> software_surface_;
+#if defined(ENABLE_VULKAN)
+  std::unique_ptr<SurfaceVulkan> vulkan_surface_;
+#endif
 
   bool display_valid_;
   bool is_pending_cursor_add_event_;
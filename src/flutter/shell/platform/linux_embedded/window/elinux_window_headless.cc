@@ -0,0 +1,284 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/elinux_window_headless.h"
+
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/context_egl_headless.h"
+#include "flutter/shell/platform/linux_embedded/surface/environment_egl_headless.h"
+
+namespace flutter {
+
+namespace {
+// Frame rate of the vsync timer in Hz, e.g. "120" or "59.94".
+constexpr char kFlutterHeadlessFrameRateEnvironmentKey[] =
+    "FLUTTER_HEADLESS_FRAME_RATE";
+
+// Size of the virtual display in kFullscreen mode.
+constexpr int32_t kDisplayWidth = 1920;
+constexpr int32_t kDisplayHeight = 1080;
+
+constexpr uint64_t kNanosecondsPerSecond = 1000000000;
+}  // namespace
+
+ELinuxWindowHeadless::ELinuxWindowHeadless(
+    FlutterDesktopViewProperties view_properties) {
+  SetViewProperties(view_properties);
+  current_scale_ =
+      view_properties.force_scale_factor ? view_properties.scale_factor : 1.0;
+  SetRotation(view_properties_.view_rotation);
+
+  display_max_width_ = kDisplayWidth;
+  display_max_height_ = kDisplayHeight;
+  if (view_properties_.view_mode == FlutterDesktopViewMode::kFullscreen) {
+    view_properties_.width = std::round(kDisplayWidth / current_scale_);
+    view_properties_.height = std::round(kDisplayHeight / current_scale_);
+    if (current_rotation_ == 90 || current_rotation_ == 270) {
+      std::swap(view_properties_.width, view_properties_.height);
+    }
+  }
+
+  auto frame_rate_string = std::getenv(kFlutterHeadlessFrameRateEnvironmentKey);
+  if (frame_rate_string && frame_rate_string[0] != '\0') {
+    auto frame_rate = std::strtod(frame_rate_string, nullptr);
+    if (frame_rate > 0) {
+      frame_rate_ = std::round(frame_rate * 1000);
+    } else {
+      ELINUX_LOG(WARNING) << "Invalid "
+                          << kFlutterHeadlessFrameRateEnvironmentKey << ": "
+                          << frame_rate_string;
+    }
+  }
+  ELINUX_LOG(INFO) << "Vsync rate: " << frame_rate_ / 1000.0 << " Hz";
+
+  vsync_timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (vsync_timer_fd_ == -1) {
+    ELINUX_LOG(ERROR) << "Failed to create the vsync timer.";
+  }
+}
+
+ELinuxWindowHeadless::~ELinuxWindowHeadless() {
+  if (vsync_timer_fd_ != -1) {
+    close(vsync_timer_fd_);
+    vsync_timer_fd_ = -1;
+  }
+}
+
+bool ELinuxWindowHeadless::IsValid() const {
+  if (vsync_timer_fd_ == -1 || !native_window_ || !native_window_->IsValid()) {
+    return false;
+  }
+  if (software_surface_) {
+    return software_surface_->IsValid();
+  }
+#if defined(ENABLE_VULKAN)
+  if (vulkan_surface_) {
+    return vulkan_surface_->IsValid();
+  }
+#endif
+  return render_surface_ && render_surface_->IsValid();
+}
+
+bool ELinuxWindowHeadless::DispatchEvent() {
+  uint64_t expirations = 0;
+  if (vsync_timer_fd_ == -1 ||
+      read(vsync_timer_fd_, &expirations, sizeof(expirations)) !=
+          sizeof(expirations)) {
+    // No vsync since the last dispatch.
+    return true;
+  }
+
+  // Missed vsync events are skipped, like on a real display.
+  vsync_count_ += expirations;
+  if (binding_handler_delegate_) {
+    const uint64_t interval_nanos = kNanosecondsPerSecond * 1000 / frame_rate_;
+    binding_handler_delegate_->OnVsync(
+        vsync_base_time_nanos_ + vsync_count_ * interval_nanos,
+        interval_nanos);
+  }
+  return true;
+}
+
+int ELinuxWindowHeadless::GetEventFd() const {
+  return vsync_timer_fd_;
+}
+
+bool ELinuxWindowHeadless::CreateRenderSurface(int32_t width,
+                                               int32_t height,
+                                               bool enable_impeller) {
+#if defined(ENABLE_VULKAN)
+  if (view_properties_.renderer_type ==
+      FlutterDesktopRendererType::kRendererVulkan) {
+    if (CreateVulkanSurface(width, height)) {
+      StartVsyncTimer();
+      return true;
+    }
+    ELINUX_LOG(WARNING) << "Vulkan isn't available, use OpenGL ES.";
+    view_properties_.renderer_type =
+        FlutterDesktopRendererType::kRendererOpenGL;
+  }
+#endif
+
+  if (view_properties_.renderer_type ==
+      FlutterDesktopRendererType::kRendererSoftware) {
+    if (current_rotation_ != 0) {
+      ELINUX_LOG(WARNING) << "The software renderer can't rotate the frames. "
+                             "The view rotation is ignored.";
+      SetRotation(FlutterDesktopViewRotation::kRotation_0);
+    }
+
+    native_window_ = std::make_unique<NativeWindowHeadless>(
+        width, height, view_properties_.enable_vsync);
+    software_surface_ = std::make_unique<SurfaceSoftware>();
+    software_surface_->SetNativeWindow(native_window_.get());
+  } else {
+    auto context_egl = std::make_unique<ContextEglHeadless>(
+        std::make_unique<EnvironmentEglHeadless>(), enable_impeller,
+        GetEglConfigAttributes());
+    if (!context_egl->IsValid()) {
+      ELINUX_LOG(ERROR) << "Failed to create the EGL context.";
+      return false;
+    }
+
+    if (current_rotation_ == 90 || current_rotation_ == 270) {
+      std::swap(width, height);
+    }
+    native_window_ = std::make_unique<NativeWindowHeadless>(
+        width, height, view_properties_.enable_vsync);
+    render_surface_ = std::make_unique<SurfaceGl>(std::move(context_egl));
+    if (!render_surface_->SetNativeWindow(native_window_.get())) {
+      ELINUX_LOG(ERROR) << "Failed to create the EGL surfaces.";
+      render_surface_ = nullptr;
+      native_window_ = nullptr;
+      return false;
+    }
+  }
+
+  StartVsyncTimer();
+  return true;
+}
+
+#if defined(ENABLE_VULKAN)
+bool ELinuxWindowHeadless::CreateVulkanSurface(int32_t width, int32_t height) {
+  native_window_ = std::make_unique<NativeWindowHeadless>(
+      width, height, view_properties_.enable_vsync);
+  auto context = std::make_unique<ContextVulkan>(native_window_.get());
+  if (!context->IsValid()) {
+    native_window_ = nullptr;
+    return false;
+  }
+
+  vulkan_surface_ = std::make_unique<SurfaceVulkan>(std::move(context));
+  if (!vulkan_surface_->SetNativeWindow(native_window_.get())) {
+    vulkan_surface_ = nullptr;
+    native_window_ = nullptr;
+    return false;
+  }
+
+  // There's no surface transformation with Vulkan.
+  if (current_rotation_ != 0) {
+    ELINUX_LOG(WARNING) << "The Vulkan renderer can't rotate the frames. The "
+                           "view rotation is ignored.";
+    SetRotation(FlutterDesktopViewRotation::kRotation_0);
+  }
+  return true;
+}
+#endif
+
+void ELinuxWindowHeadless::StartVsyncTimer() {
+  if (vsync_timer_fd_ == -1) {
+    return;
+  }
+
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  vsync_base_time_nanos_ = now.tv_sec * kNanosecondsPerSecond + now.tv_nsec;
+  vsync_count_ = 0;
+
+  const uint64_t interval_nanos = kNanosecondsPerSecond * 1000 / frame_rate_;
+  const uint64_t first_vsync_nanos = vsync_base_time_nanos_ + interval_nanos;
+  itimerspec spec = {};
+  spec.it_interval.tv_sec = interval_nanos / kNanosecondsPerSecond;
+  spec.it_interval.tv_nsec = interval_nanos % kNanosecondsPerSecond;
+  spec.it_value.tv_sec = first_vsync_nanos / kNanosecondsPerSecond;
+  spec.it_value.tv_nsec = first_vsync_nanos % kNanosecondsPerSecond;
+  if (timerfd_settime(vsync_timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr) ==
+      -1) {
+    ELINUX_LOG(ERROR) << "Failed to start the vsync timer.";
+  }
+}
+
+void ELinuxWindowHeadless::DestroyRenderSurface() {
+  if (vsync_timer_fd_ != -1) {
+    const itimerspec spec = {};
+    timerfd_settime(vsync_timer_fd_, 0, &spec, nullptr);
+  }
+  render_surface_ = nullptr;
+  software_surface_ = nullptr;
+#if defined(ENABLE_VULKAN)
+  vulkan_surface_ = nullptr;
+#endif
+  native_window_ = nullptr;
+}
+
+void ELinuxWindowHeadless::SetView(WindowBindingHandlerDelegate* window) {
+  binding_handler_delegate_ = window;
+}
+
+ELinuxRenderSurfaceTarget* ELinuxWindowHeadless::GetRenderSurfaceTarget()
+    const {
+  return render_surface_.get();
+}
+
+SurfaceSoftware* ELinuxWindowHeadless::GetSoftwareSurfaceTarget() const {
+  return software_surface_.get();
+}
+
+#if defined(ENABLE_VULKAN)
+SurfaceVulkan* ELinuxWindowHeadless::GetVulkanSurfaceTarget() const {
+  return vulkan_surface_.get();
+}
+#endif
+
+uint16_t ELinuxWindowHeadless::GetRotationDegree() const {
+  return current_rotation_;
+}
+
+double ELinuxWindowHeadless::GetDpiScale() {
+  return current_scale_;
+}
+
+PhysicalWindowBounds ELinuxWindowHeadless::GetPhysicalWindowBounds() {
+  return {GetCurrentWidth(), GetCurrentHeight()};
+}
+
+int32_t ELinuxWindowHeadless::GetFrameRate() {
+  return frame_rate_;
+}
+
+void ELinuxWindowHeadless::UpdateFlutterCursor(const std::string& cursor_name) {
+  // There's no cursor to show.
+}
+
+void ELinuxWindowHeadless::UpdateVirtualKeyboardStatus(const bool show) {
+  // There's no on-screen keyboard to show.
+}
+
+void ELinuxWindowHeadless::GetClipboardData(ClipboardCallback callback) {
+  callback(clipboard_data_);
+}
+
+void ELinuxWindowHeadless::SetClipboardData(const std::string& data) {
+  clipboard_data_ = data;
+}
+
+}  // namespace flutter
@@ -0,0 +1,114 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_ELINUX_WINDOW_HEADLESS_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_ELINUX_WINDOW_HEADLESS_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "flutter/shell/platform/linux_embedded/surface/surface_gl.h"
+#include "flutter/shell/platform/linux_embedded/surface/surface_software.h"
+#if defined(ENABLE_VULKAN)
+#include "flutter/shell/platform/linux_embedded/surface/surface_vulkan.h"
+#endif
+#include "flutter/shell/platform/linux_embedded/window/elinux_window.h"
+#include "flutter/shell/platform/linux_embedded/window/native_window_headless.h"
+#include "flutter/shell/platform/linux_embedded/window_binding_handler.h"
+
+namespace flutter {
+
+// A window backend without any display server or display device, e.g. to run
+// automated tests and benchmarks on CI machines. The vsync is generated by a
+// timer at the rate set with FLUTTER_HEADLESS_FRAME_RATE (60 Hz by default),
+// and the input is injected with the FlutterDesktopViewInject* APIs.
+class ELinuxWindowHeadless : public ELinuxWindow, public WindowBindingHandler {
+ public:
+  ELinuxWindowHeadless(FlutterDesktopViewProperties view_properties);
+  ~ELinuxWindowHeadless();
+
+  // |ELinuxWindow|
+  bool IsValid() const override;
+
+  // |FlutterWindowBindingHandler|
+  bool DispatchEvent() override;
+
+  // |FlutterWindowBindingHandler|
+  int GetEventFd() const override;
+
+  // |FlutterWindowBindingHandler|
+  bool CreateRenderSurface(int32_t width,
+                           int32_t height,
+                           bool enable_impeller) override;
+
+  // |FlutterWindowBindingHandler|
+  void DestroyRenderSurface() override;
+
+  // |FlutterWindowBindingHandler|
+  void SetView(WindowBindingHandlerDelegate* view) override;
+
+  // |FlutterWindowBindingHandler|
+  ELinuxRenderSurfaceTarget* GetRenderSurfaceTarget() const override;
+
+  // |FlutterWindowBindingHandler|
+  SurfaceSoftware* GetSoftwareSurfaceTarget() const override;
+
+#if defined(ENABLE_VULKAN)
+  // |FlutterWindowBindingHandler|
+  SurfaceVulkan* GetVulkanSurfaceTarget() const override;
+#endif
+
+  // |FlutterWindowBindingHandler|
+  uint16_t GetRotationDegree() const override;
+
+  // |FlutterWindowBindingHandler|
+  double GetDpiScale() override;
+
+  // |FlutterWindowBindingHandler|
+  PhysicalWindowBounds GetPhysicalWindowBounds() override;
+
+  // |FlutterWindowBindingHandler|
+  int32_t GetFrameRate() override;
+
+  // |FlutterWindowBindingHandler|
+  void UpdateFlutterCursor(const std::string& cursor_name) override;
+
+  // |FlutterWindowBindingHandler|
+  void UpdateVirtualKeyboardStatus(const bool show) override;
+
+  // |FlutterWindowBindingHandler|
+  void GetClipboardData(ClipboardCallback callback) override;
+
+  // |FlutterWindowBindingHandler|
+  void SetClipboardData(const std::string& data) override;
+
+ private:
+#if defined(ENABLE_VULKAN)
+  // Creates the window and the surface of the Vulkan renderer. Returns false
+  // if no Vulkan device is available.
+  bool CreateVulkanSurface(int32_t width, int32_t height);
+#endif
+
+  // Arms the vsync timer, whose expirations are the vsync events.
+  void StartVsyncTimer();
+
+  std::unique_ptr<NativeWindowHeadless> native_window_;
+  std::unique_ptr<SurfaceGl> render_surface_;
+  std::unique_ptr<SurfaceSoftware> software_surface_;
+#if defined(ENABLE_VULKAN)
+  std::unique_ptr<SurfaceVulkan> vulkan_surface_;
+#endif
+
+  // timerfd ticking at |frame_rate_|.
+  int vsync_timer_fd_ = -1;
+
+  // Time when the vsync timer was started in nanoseconds of CLOCK_MONOTONIC
+  // (the same clock as the engine), and the vsync events since then.
+  uint64_t vsync_base_time_nanos_ = 0;
+  uint64_t vsync_count_ = 0;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_ELINUX_WINDOW_HEADLESS_H_
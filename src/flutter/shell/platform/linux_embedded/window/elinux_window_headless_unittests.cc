@@ -0,0 +1,250 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/elinux_window_headless.h"
+
+#include <GLES2/gl2.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <string>
+
+#include "flutter/shell/platform/linux_embedded/window_binding_handler_delegate.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+constexpr uint64_t kNanosecondsPerSecond = 1000000000;
+
+// Records the vsync events of the window.
+class FakeWindowDelegate : public WindowBindingHandlerDelegate {
+ public:
+  void OnWindowSizeChanged(size_t width_px, size_t height_px) const override {}
+  void OnPointerMove(double x_px, double y_px) override {}
+  void OnPointerDown(double x_px,
+                     double y_px,
+                     FlutterPointerMouseButtons button) override {}
+  void OnPointerUp(double x_px,
+                   double y_px,
+                   FlutterPointerMouseButtons button) override {}
+  void OnPointerLeave() override {}
+  void OnTouchDown(uint32_t time, int32_t id, double x, double y) override {}
+  void OnTouchUp(uint32_t time, int32_t id) override {}
+  void OnTouchMotion(uint32_t time, int32_t id, double x, double y) override {}
+  void OnTouchCancel() override {}
+  void OnKeyMap(uint32_t format, int fd, uint32_t size) override {}
+  void OnKeyModifiers(uint32_t mods_depressed,
+                      uint32_t mods_latched,
+                      uint32_t mods_locked,
+                      uint32_t group) override {}
+  void OnKey(uint32_t key, bool pressed) override {}
+  void OnVirtualKey(uint32_t code_point) override {}
+  void OnVirtualSpecialKey(uint32_t keycode) override {}
+  void OnScroll(double x,
+                double y,
+                double delta_x,
+                double delta_y,
+                int scroll_offset_multiplier) override {}
+  void OnWindowVisibilityChanged(bool visible) override {}
+  void OnVsync(uint64_t last_frame_time_nanos,
+               uint64_t vsync_interval_time_nanos) override {
+    vsync_count++;
+    last_frame_time = last_frame_time_nanos;
+    vsync_interval = vsync_interval_time_nanos;
+  }
+  void UpdateHighContrastEnabled(bool enabled) override {}
+  void UpdateTextScaleFactor(float factor) override {}
+  void UpdateDisplayInfo(double refresh_rate,
+                         size_t width_px,
+                         size_t height_px,
+                         double pixel_ratio) override {}
+
+  int vsync_count = 0;
+  uint64_t last_frame_time = 0;
+  uint64_t vsync_interval = 0;
+};
+
+FlutterDesktopViewProperties GetViewProperties(
+    FlutterDesktopRendererType renderer_type) {
+  FlutterDesktopViewProperties properties = {};
+  properties.width = 320;
+  properties.height = 240;
+  properties.view_rotation = FlutterDesktopViewRotation::kRotation_0;
+  properties.view_mode = FlutterDesktopViewMode::kNormalscreen;
+  properties.enable_vsync = true;
+  properties.renderer_type = renderer_type;
+  return properties;
+}
+
+uint64_t GetMonotonicTimeNanos() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * kNanosecondsPerSecond + now.tv_nsec;
+}
+}  // namespace
+
+TEST(ELinuxWindowHeadlessTest, FullscreenFillsTheVirtualDisplay) {
+  auto properties =
+      GetViewProperties(FlutterDesktopRendererType::kRendererSoftware);
+  properties.view_mode = FlutterDesktopViewMode::kFullscreen;
+  properties.force_scale_factor = true;
+  properties.scale_factor = 2.0;
+  ELinuxWindowHeadless window(properties);
+  const auto bounds = window.GetPhysicalWindowBounds();
+  EXPECT_EQ(bounds.width, 1920u);
+  EXPECT_EQ(bounds.height, 1080u);
+  EXPECT_EQ(window.GetDpiScale(), 2.0);
+}
+
+TEST(ELinuxWindowHeadlessTest, RendersWithTheSoftwareRenderer) {
+  ELinuxWindowHeadless window(
+      GetViewProperties(FlutterDesktopRendererType::kRendererSoftware));
+  EXPECT_FALSE(window.IsValid());
+  ASSERT_TRUE(window.CreateRenderSurface(320, 240, false));
+  EXPECT_TRUE(window.IsValid());
+  EXPECT_NE(window.GetSoftwareSurfaceTarget(), nullptr);
+  EXPECT_EQ(window.GetRenderSurfaceTarget(), nullptr);
+
+  window.DestroyRenderSurface();
+  EXPECT_FALSE(window.IsValid());
+}
+
+// Needs an EGL implementation which supports EGL_MESA_platform_surfaceless or
+// pbuffers without a display, e.g. Mesa with llvmpipe on CI machines.
+TEST(ELinuxWindowHeadlessTest, RendersWithOpenGLWithoutDisplay) {
+  ELinuxWindowHeadless window(
+      GetViewProperties(FlutterDesktopRendererType::kRendererOpenGL));
+  if (!window.CreateRenderSurface(320, 240, false)) {
+    GTEST_SKIP() << "No EGL device is available.";
+  }
+  EXPECT_TRUE(window.IsValid());
+
+  auto* surface = window.GetRenderSurfaceTarget();
+  ASSERT_NE(surface, nullptr);
+  ASSERT_TRUE(surface->GLContextMakeCurrent());
+  glClearColor(0.0f, 1.0f, 0.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+  uint8_t pixel[4] = {};
+  glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+  EXPECT_EQ(pixel[0], 0);
+  EXPECT_EQ(pixel[1], 255);
+  EXPECT_EQ(pixel[2], 0);
+  EXPECT_TRUE(surface->GLContextPresent(0));
+  EXPECT_TRUE(surface->GLContextClearCurrent());
+}
+
+// The compositor draws the frames of the additional views with the contexts
+// of their windows, which share the textures of the engine's context.
+TEST(ELinuxWindowHeadlessTest, SharesTheTexturesOfTheWindows) {
+  ELinuxWindowHeadless window(
+      GetViewProperties(FlutterDesktopRendererType::kRendererOpenGL));
+  ELinuxWindowHeadless other_window(
+      GetViewProperties(FlutterDesktopRendererType::kRendererOpenGL));
+  if (!window.CreateRenderSurface(320, 240, false) ||
+      !other_window.CreateRenderSurface(320, 240, false)) {
+    GTEST_SKIP() << "No EGL device is available.";
+  }
+  ASSERT_TRUE(window.IsValid());
+  ASSERT_TRUE(other_window.IsValid());
+  auto* surface = window.GetRenderSurfaceTarget();
+  auto* other_surface = other_window.GetRenderSurfaceTarget();
+  EXPECT_TRUE(surface->IsSharedWith(*other_surface));
+  EXPECT_TRUE(other_surface->IsSharedWith(*surface));
+
+  ASSERT_TRUE(surface->GLContextMakeCurrent());
+  const uint8_t green[4] = {0, 255, 0, 255};
+  GLuint texture = 0;
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_2D, texture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+               green);
+  glFinish();
+
+  ASSERT_TRUE(other_surface->GLContextMakeCurrent());
+  GLuint framebuffer = 0;
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         texture, 0);
+  ASSERT_EQ(glCheckFramebufferStatus(GL_FRAMEBUFFER),
+            static_cast<GLenum>(GL_FRAMEBUFFER_COMPLETE));
+  uint8_t pixel[4] = {};
+  glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+  EXPECT_EQ(pixel[1], 255);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glDeleteFramebuffers(1, &framebuffer);
+  glDeleteTextures(1, &texture);
+  EXPECT_TRUE(other_surface->GLContextClearCurrent());
+}
+
+#if defined(ENABLE_VULKAN)
+// Needs a Vulkan driver which supports VK_EXT_headless_surface, e.g. lavapipe
+// on CI machines.
+TEST(ELinuxWindowHeadlessTest, RendersWithVulkanWithoutDisplay) {
+  ELinuxWindowHeadless window(
+      GetViewProperties(FlutterDesktopRendererType::kRendererVulkan));
+  // Falls back to OpenGL ES, which may not be available either.
+  const bool created = window.CreateRenderSurface(320, 240, false);
+  auto* surface = window.GetVulkanSurfaceTarget();
+  if (!created || !surface) {
+    GTEST_SKIP() << "No Vulkan device is available.";
+  }
+  EXPECT_TRUE(window.IsValid());
+
+  auto image = surface->AcquireImage(320, 240);
+  EXPECT_NE(image.image, 0u);
+  EXPECT_EQ(surface->GetExtent().width, 320u);
+  EXPECT_EQ(surface->GetExtent().height, 240u);
+
+  // The swapchain follows the size of the frames.
+  image = surface->AcquireImage(640, 480);
+  EXPECT_NE(image.image, 0u);
+  EXPECT_EQ(surface->GetExtent().width, 640u);
+  EXPECT_EQ(surface->GetExtent().height, 480u);
+}
+#endif
+
+TEST(ELinuxWindowHeadlessTest, TimerDeliversTheVsync) {
+  setenv("FLUTTER_HEADLESS_FRAME_RATE", "500", 1);
+  ELinuxWindowHeadless window(
+      GetViewProperties(FlutterDesktopRendererType::kRendererSoftware));
+  unsetenv("FLUTTER_HEADLESS_FRAME_RATE");
+  EXPECT_EQ(window.GetFrameRate(), 500000);
+
+  FakeWindowDelegate delegate;
+  window.SetView(&delegate);
+  const auto start_time = GetMonotonicTimeNanos();
+  ASSERT_TRUE(window.CreateRenderSurface(320, 240, false));
+  ASSERT_NE(window.GetEventFd(), -1);
+
+  pollfd fd = {window.GetEventFd(), POLLIN, 0};
+  ASSERT_EQ(poll(&fd, 1, 1000), 1);
+  EXPECT_TRUE(window.DispatchEvent());
+  EXPECT_EQ(delegate.vsync_count, 1);
+  EXPECT_EQ(delegate.vsync_interval, kNanosecondsPerSecond / 500);
+  EXPECT_GT(delegate.last_frame_time, start_time);
+  EXPECT_LE(delegate.last_frame_time, GetMonotonicTimeNanos());
+
+  // No vsync is delivered without a timer expiration.
+  const auto last_frame_time = delegate.last_frame_time;
+  window.DestroyRenderSurface();
+  EXPECT_TRUE(window.DispatchEvent());
+  EXPECT_EQ(delegate.vsync_count, 1);
+  EXPECT_EQ(delegate.last_frame_time, last_frame_time);
+}
+
+TEST(ELinuxWindowHeadlessTest, KeepsTheClipboardData) {
+  ELinuxWindowHeadless window(
+      GetViewProperties(FlutterDesktopRendererType::kRendererSoftware));
+  window.SetClipboardData("hello");
+  std::string data;
+  window.GetClipboardData([&data](const std::string& value) { data = value; });
+  EXPECT_EQ(data, "hello");
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -7,18 +7,26 @@
 #include <fcntl.h>
 #include <linux/input-event-codes.h>
 #include <poll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <xkbcommon/xkbcommon-keysyms.h>
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <chrono>
 #include <cmath>
-#include <codecvt>
-#include <locale>
+#include <cstring>
+#include <ctime>
 #include <unordered_map>
 
+#include "flutter/shell/platform/common/utf_conversion.h"
 #include "flutter/shell/platform/linux_embedded/logger.h"
 #include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland_shm.h"
+#if defined(ENABLE_VULKAN)
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland_vulkan.h"
+#endif
 
 namespace flutter {
 
@@ -27,6 +35,20 @@ constexpr char kZwpTextInputManagerV1[] = "zwp_text_input_manager_v1";
 constexpr char kZwpTextInputManagerV3[] = "zwp_text_input_manager_v3";
 constexpr char kZxdgDecorationManagerV1[] = "zxdg_decoration_manager_v1";
 
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+// The preferred scale of wp_fractional_scale_v1 is the numerator of a
+// fraction with this denominator.
+constexpr double kFractionalScaleDenominator = 120.0;
+#endif
+
+// The suspended state of xdg_toplevel, which is new in xdg-shell version 6
+// (wayland-protocols 1.32). Older protocols don't define it.
+#if defined(XDG_TOPLEVEL_STATE_SUSPENDED_SINCE_VERSION)
+constexpr uint32_t kXdgToplevelStateSuspended = XDG_TOPLEVEL_STATE_SUSPENDED;
+#else
+constexpr uint32_t kXdgToplevelStateSuspended = 9;
+#endif
+
 constexpr char kWlCursorThemeBottomLeftCorner[] = "bottom_left_corner";
 constexpr char kWlCursorThemeBottomRightCorner[] = "bottom_right_corner";
 constexpr char kWlCursorThemeBottomSide[] = "bottom_side";
@@ -80,30 +102,15 @@ const xdg_surface_listener ELinuxWindowWayland::kXdgSurfaceListener = {
           ELINUX_LOG(TRACE) << "xdg_surface_listener.configure";
 
           auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
-          constexpr int32_t x = 0;
-          int32_t y = 0;
-          auto width = self->view_properties_.width;
-          auto height = self->view_properties_.height;
-
-          if (self->window_decorations_) {
-            // Shift the window position to the bottom to show decoration
-            // even when the window is displayed in the upper left corner
-            // of the screen
-            y = -self->window_decorations_->Height();
-            if (!self->maximised_) {
-              height -= y;
-            }
-
-            // clip
-            if (self->display_max_height_ > 0) {
-              height = std::min(height, self->display_max_height_);
-            }
-          }
-          xdg_surface_set_window_geometry(xdg_surface, x, y, width, height);
-
-          xdg_surface_ack_configure(xdg_surface, serial);
           if (self->wait_for_configure_) {
+            // The initial configure must be acked before the first commit.
             self->wait_for_configure_ = false;
+            self->AckConfigure(serial);
+          } else {
+            // Acked at the next DispatchEvent() together with the resize, so
+            // that a storm of configures results in a single resize.
+            self->pending_configure_serial_ = serial;
+            self->has_pending_configure_ = true;
           }
           self->request_redraw_ = true;
         },
@@ -120,6 +127,15 @@ const xdg_toplevel_listener ELinuxWindowWayland::kXdgToplevelListener = {
               << "xdg_toplevel_listener.configure: " << width << ", " << height;
 
           auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
+          bool suspended = false;
+          const auto* state = static_cast<const uint32_t*>(states->data);
+          for (size_t i = 0; i < states->size / sizeof(uint32_t); i++) {
+            if (state[i] == kXdgToplevelStateSuspended) {
+              suspended = true;
+            }
+          }
+          self->UpdateSuspended(suspended);
+
           if (self->current_rotation_ == 90 || self->current_rotation_ == 270) {
             std::swap(width, height);
           }
@@ -150,6 +166,18 @@ const xdg_toplevel_listener ELinuxWindowWayland::kXdgToplevelListener = {
 
           auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
           self->running_ = false;
+        },
+    .configure_bounds =
+        [](void* data,
+           xdg_toplevel* xdg_toplevel,
+           int32_t width,
+           int32_t height) {
+          ELINUX_LOG(TRACE) << "xdg_toplevel_listener.configure_bounds: "
+                            << width << ", " << height;
+        },
+    .wm_capabilities =
+        [](void* data, xdg_toplevel* xdg_toplevel, wl_array* capabilities) {
+          ELINUX_LOG(TRACE) << "xdg_toplevel_listener.wm_capabilities";
         }};
 
 const wl_surface_listener ELinuxWindowWayland::kWlSurfaceListener = {
@@ -228,18 +256,21 @@ const wp_presentation_feedback_listener
                   (((static_cast<uint64_t>(tv_sec_hi) << 32) + tv_sec_lo) *
                    1000000000) +
                   tv_nsec;
-              self->frame_rate_ =
-                  static_cast<int32_t>(std::round(1000000000000.0 / refresh));
-
-              if (self->window_decorations_) {
-                self->window_decorations_->Draw();
+              if (refresh != 0) {
+                self->vsync_frame_rate_ = static_cast<int32_t>(
+                    std::round(1000000000000.0 / refresh));
               }
+              self->request_draw_decorations_ = true;
 
               wp_presentation_feedback_destroy(wp_presentation_feedback);
+              self->wp_presentation_feedback_ = ::wp_presentation_feedback(
+                  self->wp_presentation_wrapper_,
+                  self->native_window_->Surface());
               wp_presentation_feedback_add_listener(
-                  ::wp_presentation_feedback(self->wp_presentation_,
-                                             self->native_window_->Surface()),
+                  self->wp_presentation_feedback_,
                   &kWpPresentationFeedbackListener, data);
+
+              self->NotifyVsync();
             },
         .discarded =
             [](void* data,
@@ -248,14 +279,14 @@ const wp_presentation_feedback_listener
                   << "wp_presentation_feedback_listener.discarded";
 
               auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
-              if (self->window_decorations_) {
-                self->window_decorations_->Draw();
-              }
+              self->request_draw_decorations_ = true;
 
               wp_presentation_feedback_destroy(wp_presentation_feedback);
+              self->wp_presentation_feedback_ = ::wp_presentation_feedback(
+                  self->wp_presentation_wrapper_,
+                  self->native_window_->Surface());
               wp_presentation_feedback_add_listener(
-                  ::wp_presentation_feedback(self->wp_presentation_,
-                                             self->native_window_->Surface()),
+                  self->wp_presentation_feedback_,
                   &kWpPresentationFeedbackListener, data);
             },
 };
@@ -268,19 +299,21 @@ const wl_callback_listener ELinuxWindowWayland::kWlSurfaceFrameListener = {
           // The presentation-time is an extended protocol and isn't supported
           // by all compositors. This path is for when it wasn't supported.
           auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
+          wl_callback_destroy(wl_callback);
+          self->wl_frame_callback_ = nullptr;
           if (self->wp_presentation_clk_id_ != UINT32_MAX) {
             return;
           }
 
-          if (self->window_decorations_) {
-            self->window_decorations_->Draw();
-          }
-
+          self->request_draw_decorations_ = true;
           self->last_frame_time_nanos_ = static_cast<uint64_t>(time) * 1000000;
 
-          auto callback = wl_surface_frame(self->native_window_->Surface());
-          wl_callback_destroy(wl_callback);
-          wl_callback_add_listener(callback, &kWlSurfaceFrameListener, data);
+          self->wl_frame_callback_ =
+              wl_surface_frame(self->wl_vsync_surface_wrapper_);
+          wl_callback_add_listener(self->wl_frame_callback_,
+                                   &kWlSurfaceFrameListener, data);
+
+          self->NotifyVsync();
         },
 };
 
@@ -678,6 +711,7 @@ const wl_output_listener ELinuxWindowWayland::kWlOutputListener = {
         // Some composers send 0 for the refresh value.
         if (refresh != 0) {
           self->frame_rate_ = refresh;
+          self->vsync_frame_rate_ = refresh;
         }
 
         if (self->view_properties_.view_mode ==
@@ -768,10 +802,8 @@ const zwp_text_input_v1_listener ELinuxWindowWayland::kZwpTextInputV1Listener =
 
           auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
           if (self->binding_handler_delegate_ && strlen(text)) {
-            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-                utf8_converter;
-            std::u16string utf16_text = utf8_converter.from_bytes(text);
-            self->binding_handler_delegate_->OnVirtualKey(utf16_text[0]);
+            self->binding_handler_delegate_->OnVirtualKey(
+                FirstCodePointOfUtf8(text));
           }
           if (self->zwp_text_input_v1_) {
             zwp_text_input_v1_reset(self->zwp_text_input_v1_);
@@ -802,10 +834,8 @@ const zwp_text_input_v1_listener ELinuxWindowWayland::kZwpTextInputV1Listener =
           // commit_string is notified only when the space key is pressed.
           auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
           if (self->binding_handler_delegate_ && strlen(text)) {
-            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-                utf8_converter;
-            std::u16string utf16_text = utf8_converter.from_bytes(text);
-            self->binding_handler_delegate_->OnVirtualKey(utf16_text[0]);
+            self->binding_handler_delegate_->OnVirtualKey(
+                FirstCodePointOfUtf8(text));
           }
           // If there is no input data, the backspace key cannot be used,
           // so set dummy data.
@@ -921,10 +951,8 @@ const zwp_text_input_v3_listener ELinuxWindowWayland::kZwpTextInputV3Listener =
 
           auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
           if (self->binding_handler_delegate_ && strlen(text)) {
-            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>
-                utf8_converter;
-            std::u16string utf16_text = utf8_converter.from_bytes(text);
-            self->binding_handler_delegate_->OnVirtualKey(utf16_text[0]);
+            self->binding_handler_delegate_->OnVirtualKey(
+                FirstCodePointOfUtf8(text));
           }
         },
         .delete_surrounding_text = [](void* data,
@@ -1050,6 +1078,33 @@ const zxdg_toplevel_decoration_v1_listener
         },
 };
 
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+const wp_fractional_scale_v1_listener
+    ELinuxWindowWayland::kWpFractionalScaleV1Listener = {
+        .preferred_scale =
+            [](void* data,
+               struct wp_fractional_scale_v1* wp_fractional_scale_v1,
+               uint32_t scale) -> void {
+          ELINUX_LOG(TRACE)
+              << "wp_fractional_scale_v1_listener.preferred_scale: " << scale;
+
+          auto self = reinterpret_cast<ELinuxWindowWayland*>(data);
+          if (self->view_properties_.force_scale_factor) {
+            return;
+          }
+
+          const double scale_factor = scale / kFractionalScaleDenominator;
+          if (scale_factor <= 0 || self->current_scale_ == scale_factor) {
+            return;
+          }
+
+          ELINUX_LOG(TRACE) << "Window scale has changed: " << scale_factor;
+          self->current_scale_ = scale_factor;
+          self->request_redraw_ = true;
+        },
+};
+#endif
+
 ELinuxWindowWayland::ELinuxWindowWayland(
     FlutterDesktopViewProperties view_properties)
     : cursor_info_({"", 0, nullptr}),
@@ -1075,7 +1130,7 @@ ELinuxWindowWayland::ELinuxWindowWayland(
       wp_presentation_(nullptr),
       wp_presentation_clk_id_(UINT32_MAX),
       window_decorations_(nullptr) {
-  view_properties_ = view_properties;
+  SetViewProperties(view_properties);
   current_scale_ =
       view_properties.force_scale_factor ? view_properties.scale_factor : 1.0;
   SetRotation(view_properties_.view_rotation);
@@ -1144,6 +1199,8 @@ ELinuxWindowWayland::~ELinuxWindowWayland() {
   display_valid_ = false;
   running_ = false;
 
+  StopVsyncThread();
+
   for (auto theme : wl_cursor_themes_) {
     wl_cursor_theme_destroy(theme.second);
   }
@@ -1183,6 +1240,49 @@ ELinuxWindowWayland::~ELinuxWindowWayland() {
     }
   }
 
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+  if (wp_fractional_scale_manager_v1_) {
+    wp_fractional_scale_manager_v1_destroy(wp_fractional_scale_manager_v1_);
+    wp_fractional_scale_manager_v1_ = nullptr;
+  }
+#endif
+
+  if (wp_viewporter_) {
+    wp_viewporter_destroy(wp_viewporter_);
+    wp_viewporter_ = nullptr;
+  }
+
+#if defined(USE_WAYLAND_TEARING_CONTROL)
+  if (wp_tearing_control_manager_v1_) {
+    wp_tearing_control_manager_v1_destroy(wp_tearing_control_manager_v1_);
+    wp_tearing_control_manager_v1_ = nullptr;
+  }
+#endif
+
+#if defined(USE_WAYLAND_DMABUF_SWAPCHAIN)
+  if (zwp_linux_dmabuf_v1_) {
+    zwp_linux_dmabuf_v1_destroy(zwp_linux_dmabuf_v1_);
+    zwp_linux_dmabuf_v1_ = nullptr;
+  }
+#endif
+
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+  if (wp_commit_timing_manager_v1_) {
+    wp_commit_timing_manager_v1_destroy(wp_commit_timing_manager_v1_);
+    wp_commit_timing_manager_v1_ = nullptr;
+  }
+
+  if (wp_fifo_manager_v1_) {
+    wp_fifo_manager_v1_destroy(wp_fifo_manager_v1_);
+    wp_fifo_manager_v1_ = nullptr;
+  }
+#endif
+
+  if (clipboard_read_fd_ != -1) {
+    close(clipboard_read_fd_);
+    clipboard_read_fd_ = -1;
+  }
+
   if (wl_data_offer_) {
     wl_data_offer_destroy(wl_data_offer_);
     wl_data_offer_ = nullptr;
@@ -1281,10 +1381,24 @@ ELinuxRenderSurfaceTarget* ELinuxWindowWayland::GetRenderSurfaceTarget() const {
   return render_surface_.get();
 }
 
+SurfaceSoftware* ELinuxWindowWayland::GetSoftwareSurfaceTarget() const {
+  return software_surface_.get();
+}
+
+#if defined(ENABLE_VULKAN)
+SurfaceVulkan* ELinuxWindowWayland::GetVulkanSurfaceTarget() const {
+  return vulkan_surface_.get();
+}
+#endif
+
 uint16_t ELinuxWindowWayland::GetRotationDegree() const {
   return current_rotation_;
 }
 
+bool ELinuxWindowWayland::IsRotationOffloaded() const {
+  return rotation_offloaded_;
+}
+
 double ELinuxWindowWayland::GetDpiScale() {
   return current_scale_;
 }
@@ -1307,18 +1421,40 @@ bool ELinuxWindowWayland::DispatchEvent() {
     return false;
   }
 
-  if (request_redraw_) {
+  // Apply at most one resize per frame. The flag is cleared at the next
+  // vsync, i.e. after the compositor had a chance to show the resized frame.
+  if (request_redraw_ && !resize_throttled_) {
     request_redraw_ = false;
-    if (window_decorations_) {
-      window_decorations_->Resize(view_properties_.width,
-                                  view_properties_.height, current_scale_);
+    if (has_pending_configure_) {
+      has_pending_configure_ = false;
+      AckConfigure(pending_configure_serial_);
     }
 
-    if (binding_handler_delegate_) {
-      binding_handler_delegate_->OnWindowSizeChanged(
-          view_properties_.width * current_scale_,
-          view_properties_.height * current_scale_ -
-              WindowDecorationsPhysicalHeight());
+    // Configures often only change states such as activated. Don't resize
+    // the surface nor send window metrics in that case.
+    const int32_t width_px = GetCurrentWidth();
+    const int32_t height_px =
+        GetCurrentHeight() - WindowDecorationsPhysicalHeight();
+    if (width_px != applied_width_px_ || height_px != applied_height_px_ ||
+        current_scale_ != applied_scale_) {
+      applied_width_px_ = width_px;
+      applied_height_px_ = height_px;
+      applied_scale_ = current_scale_;
+      resize_throttled_ = true;
+
+      if (window_decorations_) {
+        window_decorations_->Resize(view_properties_.width,
+                                    view_properties_.height,
+                                    IntegerBufferScale());
+      }
+
+      // The EGL window is resized in place. The new size is used from the
+      // next frame, which is committed after the ack above.
+      if (binding_handler_delegate_) {
+        binding_handler_delegate_->OnWindowSizeChanged(width_px, height_px);
+      }
+      UpdateViewportDestination();
+      UpdateOpaqueRegion();
     }
     NotifyDisplayInfoUpdates();
   }
@@ -1333,18 +1469,21 @@ bool ELinuxWindowWayland::DispatchEvent() {
   }
   wl_display_flush(wl_display_);
 
-  // Handle Vsync.
-  if (binding_handler_delegate_) {
-    const uint64_t vsync_interval_time_nanos = 1000000000000 / frame_rate_;
-    binding_handler_delegate_->OnVsync(last_frame_time_nanos_,
-                                       vsync_interval_time_nanos);
+  // Vsync is handled by the vsync thread. Draw the window decorations for
+  // the frames presented since the last call.
+  frame_rate_ = vsync_frame_rate_;
+  if (request_draw_decorations_.exchange(false) && window_decorations_) {
+    window_decorations_->Draw();
   }
 
-  // Handle Wayland events.
+  // Handle Wayland events and the clipboard transfer. poll() ignores a
+  // negative fd, i.e. when no transfer is running.
   pollfd fds[] = {
       {wl_display_get_fd(wl_display_), POLLIN},
+      {clipboard_read_fd_, POLLIN},
   };
-  if (poll(fds, 1, 0) > 0) {
+  poll(fds, 2, 0);
+  if (fds[0].revents & POLLIN) {
     auto result = wl_display_read_events(wl_display_);
     if (result == -1) {
       return false;
@@ -1358,6 +1497,10 @@ bool ELinuxWindowWayland::DispatchEvent() {
     wl_display_cancel_read(wl_display_);
   }
 
+  if (clipboard_read_fd_ != -1 && fds[1].revents) {
+    ReadClipboardData();
+  }
+
   return true;
 }
 
@@ -1382,8 +1525,8 @@ bool ELinuxWindowWayland::CreateRenderSurface(int32_t width_px,
   }
 
   if (view_properties_.view_mode == FlutterDesktopViewMode::kFullscreen) {
-    width_px = view_properties_.width * current_scale_;
-    height_px = view_properties_.height * current_scale_;
+    width_px = GetCurrentWidth();
+    height_px = GetCurrentHeight();
   }
 
   ELINUX_LOG(TRACE) << "Created the Wayland surface: " << width_px << "x"
@@ -1397,14 +1540,131 @@ bool ELinuxWindowWayland::CreateRenderSurface(int32_t width_px,
     }
   }
 
-  if (current_rotation_ == 90 || current_rotation_ == 270) {
+  // Let the compositor rotate the buffers, which then have the size of the
+  // view. It may scan them out to a rotated output as they are.
+  rotation_offloaded_ =
+      current_rotation_ != 0 &&
+      wl_compositor_get_version(wl_compositor_) >=
+          WL_SURFACE_SET_BUFFER_TRANSFORM_SINCE_VERSION;
+  if (!rotation_offloaded_ && current_rotation_ != 0 &&
+      view_properties_.renderer_type ==
+          FlutterDesktopRendererType::kRendererSoftware) {
+    ELINUX_LOG(WARNING) << "The software renderer can't rotate the frames. "
+                           "The view rotation is ignored.";
+    SetRotation(FlutterDesktopViewRotation::kRotation_0);
+  }
+#if defined(ENABLE_VULKAN)
+  if (!rotation_offloaded_ && current_rotation_ != 0 &&
+      view_properties_.renderer_type ==
+          FlutterDesktopRendererType::kRendererVulkan) {
+    ELINUX_LOG(WARNING) << "The Vulkan renderer can't rotate the frames. The "
+                           "view rotation is ignored.";
+    SetRotation(FlutterDesktopViewRotation::kRotation_0);
+  }
+#endif
+  if (!rotation_offloaded_ &&
+      (current_rotation_ == 90 || current_rotation_ == 270)) {
     std::swap(width_px, height_px);
   }
-  native_window_ = std::make_unique<NativeWindowWayland>(
-      wl_compositor_, width_px, height_px, view_properties_.enable_vsync);
+
+  // Tearing is only acceptable (and only helps) when the surface is scanned
+  // out directly, i.e. in fullscreen.
+  const bool low_latency =
+      view_properties_.enable_low_latency &&
+      view_properties_.view_mode == FlutterDesktopViewMode::kFullscreen;
+  if (view_properties_.enable_low_latency && !low_latency) {
+    ELINUX_LOG(WARNING) << "Low-latency mode is only supported in fullscreen.";
+  }
+  const bool enable_vsync = view_properties_.enable_vsync && !low_latency;
+
+  const bool software_rendering =
+      view_properties_.renderer_type ==
+      FlutterDesktopRendererType::kRendererSoftware;
+  if (software_rendering) {
+    native_window_ = std::make_unique<NativeWindowWaylandShm>(
+        wl_display_, wl_compositor_, wl_shm_, width_px, height_px,
+        enable_vsync, GetEglConfigAttributes().alpha_size == 0);
+  }
+#if defined(ENABLE_VULKAN)
+  if (view_properties_.renderer_type ==
+          FlutterDesktopRendererType::kRendererVulkan &&
+      !CreateVulkanSurface(width_px, height_px, enable_vsync)) {
+    ELINUX_LOG(WARNING) << "Vulkan isn't available, use OpenGL ES.";
+    view_properties_.renderer_type =
+        FlutterDesktopRendererType::kRendererOpenGL;
+  }
+  // The Vulkan driver presents the frames with its own tearing control and
+  // fifo objects, which can't coexist with ours on the same surface.
+  const bool vulkan_rendering = vulkan_surface_ != nullptr;
+#else
+  const bool vulkan_rendering = false;
+#endif
+#if defined(USE_WAYLAND_DMABUF_SWAPCHAIN)
+  if (!native_window_ && zwp_linux_dmabuf_v1_) {
+    auto native_window = std::make_unique<NativeWindowWaylandGbm>(
+        wl_display_, wl_compositor_, zwp_linux_dmabuf_v1_, width_px,
+        height_px, enable_vsync, GetEglConfigAttributes());
+    if (native_window->IsValid()) {
+      native_window_ = std::move(native_window);
+    } else {
+      ELINUX_LOG(WARNING) << "Failed to set up the GBM swapchain. Fall back "
+                             "to the EGL Wayland platform.";
+    }
+  }
+#endif
+  if (!native_window_) {
+    native_window_ = std::make_unique<NativeWindowWayland>(
+        wl_display_, wl_compositor_, width_px, height_px, enable_vsync,
+        GetEglConfigAttributes());
+  }
 
   wl_surface_add_listener(native_window_->Surface(), &kWlSurfaceListener, this);
 
+  if (rotation_offloaded_) {
+    // The compositor rotates the buffers by the inverse of the transform,
+    // i.e. clockwise like the view rotation.
+    auto transform = WL_OUTPUT_TRANSFORM_90;
+    if (current_rotation_ == 180) {
+      transform = WL_OUTPUT_TRANSFORM_180;
+    } else if (current_rotation_ == 270) {
+      transform = WL_OUTPUT_TRANSFORM_270;
+    }
+    wl_surface_set_buffer_transform(native_window_->Surface(), transform);
+  }
+
+  if (low_latency && !vulkan_rendering) {
+#if defined(USE_WAYLAND_TEARING_CONTROL)
+    if (wp_tearing_control_manager_v1_) {
+      ELINUX_LOG(INFO) << "Use low-latency mode (async presentation)";
+      wp_tearing_control_v1_ =
+          wp_tearing_control_manager_v1_get_tearing_control(
+              wp_tearing_control_manager_v1_, native_window_->Surface());
+      wp_tearing_control_v1_set_presentation_hint(
+          wp_tearing_control_v1_,
+          WP_TEARING_CONTROL_V1_PRESENTATION_HINT_ASYNC);
+    } else {
+      ELINUX_LOG(WARNING) << "wp_tearing_control_manager_v1 isn't supported. "
+                             "Frames are presented at the next v-blank.";
+    }
+#else
+    ELINUX_LOG(WARNING) << "Built without tearing-control-v1. Frames are "
+                           "presented at the next v-blank.";
+#endif
+  }
+
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+  // Swapping with vsync blocks the raster thread until the frame callback.
+  // Let the compositor hold back the commits instead.
+  if (enable_vsync && wp_fifo_manager_v1_ && !vulkan_rendering) {
+    ELINUX_LOG(INFO) << "Use fifo-v1 for frame pacing"
+                     << (wp_commit_timing_manager_v1_ ? " with commit-timing-v1"
+                                                      : "");
+    native_window_->EnableFramePacing(
+        wp_fifo_manager_v1_, wp_commit_timing_manager_v1_,
+        [this]() { return NextPresentationTime(); });
+  }
+#endif
+
   xdg_surface_ =
       xdg_wm_base_get_xdg_surface(xdg_wm_base_, native_window_->Surface());
   if (!xdg_surface_) {
@@ -1421,19 +1681,30 @@ bool ELinuxWindowWayland::CreateRenderSurface(int32_t width_px,
     xdg_toplevel_set_app_id(xdg_toplevel_, view_properties_.app_id);
   }
   xdg_toplevel_add_listener(xdg_toplevel_, &kXdgToplevelListener, this);
-  wl_surface_set_buffer_scale(native_window_->Surface(), current_scale_);
 
-  {
-    auto* callback = wl_surface_frame(native_window_->Surface());
-    wl_callback_add_listener(callback, &kWlSurfaceFrameListener, this);
-
-    if (wp_presentation_) {
-      wp_presentation_feedback_add_listener(
-          ::wp_presentation_feedback(wp_presentation_,
-                                     native_window_->Surface()),
-          &kWpPresentationFeedbackListener, this);
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+  // Prefer the viewporter to the integer buffer scale so that the buffer can
+  // be sized to the exact number of physical pixels on fractional outputs.
+  if (wp_viewporter_) {
+    wp_viewport_ =
+        wp_viewporter_get_viewport(wp_viewporter_, native_window_->Surface());
+    if (wp_fractional_scale_manager_v1_) {
+      wp_fractional_scale_v1_ =
+          wp_fractional_scale_manager_v1_get_fractional_scale(
+              wp_fractional_scale_manager_v1_, native_window_->Surface());
+      wp_fractional_scale_v1_add_listener(wp_fractional_scale_v1_,
+                                          &kWpFractionalScaleV1Listener, this);
     }
+    UpdateViewportDestination();
+  } else {
+    wl_surface_set_buffer_scale(native_window_->Surface(), current_scale_);
   }
+#else
+  wl_surface_set_buffer_scale(native_window_->Surface(), current_scale_);
+#endif
+  UpdateOpaqueRegion();
+
+  StartVsyncThread();
 
   if (view_properties_.view_mode == FlutterDesktopViewMode::kFullscreen) {
     xdg_toplevel_set_fullscreen(xdg_toplevel_, NULL);
@@ -1442,11 +1713,21 @@ bool ELinuxWindowWayland::CreateRenderSurface(int32_t width_px,
   wait_for_configure_ = true;
   wl_surface_commit(native_window_->Surface());
 
-  render_surface_ = std::make_unique<SurfaceGl>(std::make_unique<ContextEgl>(
-      std::make_unique<EnvironmentEgl>(wl_display_), enable_impeller));
-  render_surface_->SetNativeWindow(native_window_.get());
-
-  if (view_properties_.use_window_decoration) {
+  if (software_rendering) {
+    software_surface_ = std::make_unique<SurfaceSoftware>();
+    software_surface_->SetNativeWindow(native_window_.get());
+  } else if (!vulkan_rendering) {
+    render_surface_ = native_window_->CreateRenderSurface(enable_impeller);
+    render_surface_->SetNativeWindow(native_window_.get());
+  }
+
+  if (view_properties_.use_window_decoration && software_rendering) {
+    ELINUX_LOG(WARNING)
+        << "Window decorations are not supported by the software renderer.";
+  } else if (view_properties_.use_window_decoration && vulkan_rendering) {
+    ELINUX_LOG(WARNING)
+        << "Window decorations are not supported by the Vulkan renderer.";
+  } else if (view_properties_.use_window_decoration) {
     if (zxdg_decoration_manager_v1_) {
       ELINUX_LOG(INFO) << "Use server-side xdg-decoration mode";
       zxdg_toplevel_decoration_v1_ =
@@ -1473,6 +1754,32 @@ bool ELinuxWindowWayland::CreateRenderSurface(int32_t width_px,
   return true;
 }
 
+#if defined(ENABLE_VULKAN)
+bool ELinuxWindowWayland::CreateVulkanSurface(int32_t width_px,
+                                              int32_t height_px,
+                                              bool enable_vsync) {
+  native_window_ = std::make_unique<NativeWindowWaylandVulkan>(
+      wl_display_, wl_compositor_, width_px, height_px, enable_vsync);
+  if (!native_window_->IsValid()) {
+    native_window_ = nullptr;
+    return false;
+  }
+
+  auto context = std::make_unique<ContextVulkan>(native_window_.get());
+  if (!context->IsValid()) {
+    native_window_ = nullptr;
+    return false;
+  }
+  vulkan_surface_ = std::make_unique<SurfaceVulkan>(std::move(context));
+  if (!vulkan_surface_->SetNativeWindow(native_window_.get())) {
+    vulkan_surface_ = nullptr;
+    native_window_ = nullptr;
+    return false;
+  }
+  return true;
+}
+#endif
+
 void ELinuxWindowWayland::CreateDecoration(int32_t width_dip,
                                            int32_t height_dip) {
   if (window_decorations_) {
@@ -1482,16 +1789,44 @@ void ELinuxWindowWayland::CreateDecoration(int32_t width_dip,
 
   window_decorations_ = std::make_unique<WindowDecorationsWayland>(
       wl_display_, wl_compositor_, wl_subcompositor_, native_window_->Surface(),
-      width_dip, height_dip, current_scale_, enable_impeller_,
+      width_dip, height_dip, IntegerBufferScale(), enable_impeller_,
       view_properties_.enable_vsync);
 }
 
 void ELinuxWindowWayland::DestroyRenderSurface() {
+  StopVsyncThread();
+  resize_throttled_ = false;
+  applied_width_px_ = 0;
+  applied_height_px_ = 0;
+
   // destroy the main surface before destroying the client window on Wayland.
   if (window_decorations_) {
     window_decorations_ = nullptr;
   }
   render_surface_ = nullptr;
+  software_surface_ = nullptr;
+#if defined(ENABLE_VULKAN)
+  vulkan_surface_ = nullptr;
+#endif
+
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+  if (wp_fractional_scale_v1_) {
+    wp_fractional_scale_v1_destroy(wp_fractional_scale_v1_);
+    wp_fractional_scale_v1_ = nullptr;
+  }
+#endif
+
+  if (wp_viewport_) {
+    wp_viewport_destroy(wp_viewport_);
+    wp_viewport_ = nullptr;
+  }
+
+#if defined(USE_WAYLAND_TEARING_CONTROL)
+  if (wp_tearing_control_v1_) {
+    wp_tearing_control_v1_destroy(wp_tearing_control_v1_);
+    wp_tearing_control_v1_ = nullptr;
+  }
+#endif
   native_window_ = nullptr;
 
   if (xdg_surface_) {
@@ -1536,7 +1871,8 @@ void ELinuxWindowWayland::UpdateFlutterCursor(const std::string& cursor_name) {
       return;
     }
 
-    auto wl_cursor = GetWlCursor(cursor_name, cursor_size_ * current_scale_);
+    const auto buffer_scale = IntegerBufferScale();
+    auto wl_cursor = GetWlCursor(cursor_name, cursor_size_ * buffer_scale);
     if (!wl_cursor) {
       return;
     }
@@ -1545,39 +1881,77 @@ void ELinuxWindowWayland::UpdateFlutterCursor(const std::string& cursor_name) {
     if (buffer) {
       wl_pointer_set_cursor(
           cursor_info_.pointer, cursor_info_.serial, wl_cursor_surface_,
-          image->hotspot_x / current_scale_, image->hotspot_y / current_scale_);
+          image->hotspot_x / buffer_scale, image->hotspot_y / buffer_scale);
       wl_surface_attach(wl_cursor_surface_, buffer, 0, 0);
       wl_surface_damage(wl_cursor_surface_, 0, 0, image->width, image->height);
-      wl_surface_set_buffer_scale(wl_cursor_surface_, current_scale_);
+      wl_surface_set_buffer_scale(wl_cursor_surface_, buffer_scale);
       wl_surface_commit(wl_cursor_surface_);
     }
   }
 }
 
-std::string ELinuxWindowWayland::GetClipboardData() {
-  std::string str = "";
+void ELinuxWindowWayland::GetClipboardData(ClipboardCallback callback) {
+  // The selection is owned by this client. Reading it through the pipe would
+  // wait on our own data source, so use the local copy.
+  if (wl_data_source_ || !wl_data_offer_) {
+    callback(wl_data_source_ ? clipboard_data_ : "");
+    return;
+  }
 
-  if (wl_data_offer_) {
-    int fd[2];
-    if (pipe2(fd, O_CLOEXEC) == -1) {
-      return str;
-    }
+  if (clipboard_read_fd_ != -1) {
+    // A transfer is already running.
+    clipboard_read_callbacks_.push_back(std::move(callback));
+    return;
+  }
 
-    wl_data_offer_receive(wl_data_offer_, kClipboardMimeTypeText, fd[1]);
-    close(fd[1]);
-    wl_display_dispatch(wl_display_);
+  int fd[2];
+  if (pipe2(fd, O_CLOEXEC | O_NONBLOCK) == -1) {
+    ELINUX_LOG(ERROR) << "Failed to create a pipe for the clipboard.";
+    callback("");
+    return;
+  }
 
-    char buf[256];
-    int len;
-    // Read data form the clipboard.
-    while ((len = read(fd[0], buf, sizeof(buf))) > 0) {
-      str.append(buf, len);
+  wl_data_offer_receive(wl_data_offer_, kClipboardMimeTypeText, fd[1]);
+  close(fd[1]);
+  wl_display_flush(wl_display_);
+  clipboard_read_fd_ = fd[0];
+  clipboard_read_data_.clear();
+  clipboard_read_callbacks_.push_back(std::move(callback));
+}
+
+void ELinuxWindowWayland::ReadClipboardData() {
+  char buf[4096];
+  while (true) {
+    auto len = read(clipboard_read_fd_, buf, sizeof(buf));
+    if (len > 0) {
+      clipboard_read_data_.append(buf, len);
+      continue;
+    }
+    if (len == -1 && errno == EINTR) {
+      continue;
+    }
+    if (len == -1 && errno == EAGAIN) {
+      // Wait for more data.
+      return;
     }
-    close(fd[0]);
-    return str;
+    if (len == -1) {
+      ELINUX_LOG(ERROR) << "Failed to read the clipboard: "
+                        << std::strerror(errno);
+    }
+    break;
   }
 
-  return str;
+  // Reached the end of the data. The callbacks may request another read, so
+  // reset the state before calling them.
+  close(clipboard_read_fd_);
+  clipboard_read_fd_ = -1;
+  auto data = std::move(clipboard_read_data_);
+  clipboard_read_data_.clear();
+  auto callbacks = std::move(clipboard_read_callbacks_);
+  clipboard_read_callbacks_.clear();
+  for (const auto& callback : callbacks) {
+    callback(data);
+  }
 }
 
 void ELinuxWindowWayland::SetClipboardData(const std::string& data) {
@@ -1601,11 +1975,18 @@ void ELinuxWindowWayland::SetClipboardData(const std::string& data) {
 }
 
 bool ELinuxWindowWayland::IsValid() const {
-  if (!display_valid_ || !native_window_ || !render_surface_ ||
-      !native_window_->IsValid() || !render_surface_->IsValid()) {
+  if (!display_valid_ || !native_window_ || !native_window_->IsValid()) {
     return false;
   }
-  return true;
+  if (software_surface_) {
+    return software_surface_->IsValid();
+  }
+#if defined(ENABLE_VULKAN)
+  if (vulkan_surface_) {
+    return vulkan_surface_->IsValid();
+  }
+#endif
+  return render_surface_ && render_surface_->IsValid();
 }
 
 void ELinuxWindowWayland::WlRegistryHandler(wl_registry* wl_registry,
@@ -1627,7 +2008,8 @@ void ELinuxWindowWayland::WlRegistryHandler(wl_registry* wl_registry,
   }
 
   if (!strcmp(interface, xdg_wm_base_interface.name)) {
-    constexpr uint32_t kMaxVersion = 3;
+    // Version 6 is required for the suspended state.
+    constexpr uint32_t kMaxVersion = 6;
     xdg_wm_base_ = static_cast<decltype(xdg_wm_base_)>(
         wl_registry_bind(wl_registry, name, &xdg_wm_base_interface,
                          std::min(kMaxVersion, version)));
@@ -1716,6 +2098,72 @@ void ELinuxWindowWayland::WlRegistryHandler(wl_registry* wl_registry,
             std::min(kMaxVersion, version)));
     return;
   }
+
+#if defined(USE_WAYLAND_DMABUF_SWAPCHAIN)
+  if (!strcmp(interface, zwp_linux_dmabuf_v1_interface.name)) {
+    // Version 4 is required for the per-surface feedback.
+    constexpr uint32_t kMinVersion = 4;
+    constexpr uint32_t kMaxVersion = 4;
+    if (version >= kMinVersion) {
+      zwp_linux_dmabuf_v1_ = static_cast<decltype(zwp_linux_dmabuf_v1_)>(
+          wl_registry_bind(wl_registry, name, &zwp_linux_dmabuf_v1_interface,
+                           std::min(kMaxVersion, version)));
+    }
+    return;
+  }
+#endif
+
+#if defined(USE_WAYLAND_TEARING_CONTROL)
+  if (!strcmp(interface, wp_tearing_control_manager_v1_interface.name)) {
+    constexpr uint32_t kMaxVersion = 1;
+    wp_tearing_control_manager_v1_ =
+        static_cast<decltype(wp_tearing_control_manager_v1_)>(
+            wl_registry_bind(wl_registry, name,
+                             &wp_tearing_control_manager_v1_interface,
+                             std::min(kMaxVersion, version)));
+    return;
+  }
+#endif
+
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+  if (!strcmp(interface, wp_fifo_manager_v1_interface.name)) {
+    constexpr uint32_t kMaxVersion = 1;
+    wp_fifo_manager_v1_ =
+        static_cast<decltype(wp_fifo_manager_v1_)>(wl_registry_bind(
+            wl_registry, name, &wp_fifo_manager_v1_interface,
+            std::min(kMaxVersion, version)));
+    return;
+  }
+
+  if (!strcmp(interface, wp_commit_timing_manager_v1_interface.name)) {
+    constexpr uint32_t kMaxVersion = 1;
+    wp_commit_timing_manager_v1_ =
+        static_cast<decltype(wp_commit_timing_manager_v1_)>(wl_registry_bind(
+            wl_registry, name, &wp_commit_timing_manager_v1_interface,
+            std::min(kMaxVersion, version)));
+    return;
+  }
+#endif
+
+  if (!strcmp(interface, wp_viewporter_interface.name)) {
+    constexpr uint32_t kMaxVersion = 1;
+    wp_viewporter_ = static_cast<decltype(wp_viewporter_)>(wl_registry_bind(
+        wl_registry, name, &wp_viewporter_interface,
+        std::min(kMaxVersion, version)));
+    return;
+  }
+
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+  if (!strcmp(interface, wp_fractional_scale_manager_v1_interface.name)) {
+    constexpr uint32_t kMaxVersion = 1;
+    wp_fractional_scale_manager_v1_ =
+        static_cast<decltype(wp_fractional_scale_manager_v1_)>(
+            wl_registry_bind(wl_registry, name,
+                             &wp_fractional_scale_manager_v1_interface,
+                             std::min(kMaxVersion, version)));
+    return;
+  }
+#endif
 }
 
 void ELinuxWindowWayland::WlUnRegistryHandler(wl_registry* wl_registry,
@@ -1897,6 +2345,13 @@ void ELinuxWindowWayland::UpdateWindowScale() {
   if (view_properties_.force_scale_factor) {
     return;
   }
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+  // The preferred scale of wp_fractional_scale_v1 takes precedence over the
+  // integer scale of the outputs.
+  if (wp_fractional_scale_v1_) {
+    return;
+  }
+#endif
 
   double scale_factor = 1.0;
   for (auto output_id : entered_outputs_) {
@@ -1916,16 +2371,286 @@ void ELinuxWindowWayland::UpdateWindowScale() {
   ELINUX_LOG(TRACE) << "Window scale has changed: " << scale_factor;
   current_scale_ = scale_factor;
 
-  wl_surface_set_buffer_scale(native_window_->Surface(), current_scale_);
+  if (!wp_viewport_) {
+    wl_surface_set_buffer_scale(native_window_->Surface(), current_scale_);
+  }
   request_redraw_ = true;
 }
 
+void ELinuxWindowWayland::UpdateViewportDestination() {
+  if (!wp_viewport_ || !native_window_) {
+    return;
+  }
+
+  int32_t width_dip;
+  int32_t height_dip;
+  GetSurfaceSizeDip(width_dip, height_dip);
+  if (width_dip <= 0 || height_dip <= 0) {
+    return;
+  }
+  wp_viewport_set_destination(wp_viewport_, width_dip, height_dip);
+}
+
+void ELinuxWindowWayland::UpdateOpaqueRegion() {
+  if (!view_properties_.opaque || !native_window_) {
+    return;
+  }
+
+  // The region is in surface-local coordinates, i.e. the viewport
+  // destination or the buffer size divided by the buffer scale.
+  int32_t width_dip;
+  int32_t height_dip;
+  GetSurfaceSizeDip(width_dip, height_dip);
+  auto* region = wl_compositor_create_region(wl_compositor_);
+  wl_region_add(region, 0, 0, width_dip, height_dip);
+  wl_surface_set_opaque_region(native_window_->Surface(), region);
+  wl_region_destroy(region);
+}
+
+int32_t ELinuxWindowWayland::IntegerBufferScale() const {
+  return std::max(1, static_cast<int32_t>(std::ceil(current_scale_)));
+}
+
+void ELinuxWindowWayland::GetSurfaceSizeDip(int32_t& width_dip,
+                                            int32_t& height_dip) const {
+  width_dip = std::round(native_window_->Width() / current_scale_);
+  height_dip = std::round(native_window_->Height() / current_scale_);
+  if (rotation_offloaded_ &&
+      (current_rotation_ == 90 || current_rotation_ == 270)) {
+    std::swap(width_dip, height_dip);
+  }
+}
+
+void ELinuxWindowWayland::StartVsyncThread() {
+  wl_vsync_queue_ = wl_display_create_queue(wl_display_);
+  wl_vsync_surface_wrapper_ = static_cast<wl_surface*>(
+      wl_proxy_create_wrapper(native_window_->Surface()));
+  wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(wl_vsync_surface_wrapper_),
+                     wl_vsync_queue_);
+
+  wl_frame_callback_ = wl_surface_frame(wl_vsync_surface_wrapper_);
+  wl_callback_add_listener(wl_frame_callback_, &kWlSurfaceFrameListener, this);
+
+  if (wp_presentation_) {
+    wp_presentation_wrapper_ = static_cast<wp_presentation*>(
+        wl_proxy_create_wrapper(wp_presentation_));
+    wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(wp_presentation_wrapper_),
+                       wl_vsync_queue_);
+    wp_presentation_feedback_ = ::wp_presentation_feedback(
+        wp_presentation_wrapper_, native_window_->Surface());
+    wp_presentation_feedback_add_listener(wp_presentation_feedback_,
+                                          &kWpPresentationFeedbackListener,
+                                          this);
+  }
+
+  last_frame_time_nanos_ = 0;
+  vsync_frame_rate_ = frame_rate_;
+  vsync_thread_event_fd_ = eventfd(0, EFD_CLOEXEC);
+  if (vsync_thread_event_fd_ == -1) {
+    ELINUX_LOG(ERROR) << "Failed to create the eventfd for the vsync thread.";
+    return;
+  }
+  vsync_thread_running_ = true;
+  vsync_thread_ = std::thread(&ELinuxWindowWayland::VsyncThreadLoop, this);
+}
+
+void ELinuxWindowWayland::WakeUpVsyncThread() {
+  if (vsync_thread_event_fd_ == -1) {
+    return;
+  }
+  const uint64_t value = 1;
+  if (write(vsync_thread_event_fd_, &value, sizeof(value)) == -1) {
+    ELINUX_LOG(ERROR) << "Failed to wake up the vsync thread.";
+  }
+}
+
+void ELinuxWindowWayland::StopVsyncThread() {
+  if (vsync_thread_.joinable()) {
+    vsync_thread_running_ = false;
+    WakeUpVsyncThread();
+    vsync_thread_.join();
+  }
+
+  if (vsync_thread_event_fd_ != -1) {
+    close(vsync_thread_event_fd_);
+    vsync_thread_event_fd_ = -1;
+  }
+
+  if (wl_frame_callback_) {
+    wl_callback_destroy(wl_frame_callback_);
+    wl_frame_callback_ = nullptr;
+  }
+
+  if (wp_presentation_feedback_) {
+    wp_presentation_feedback_destroy(wp_presentation_feedback_);
+    wp_presentation_feedback_ = nullptr;
+  }
+
+  if (wp_presentation_wrapper_) {
+    wl_proxy_wrapper_destroy(wp_presentation_wrapper_);
+    wp_presentation_wrapper_ = nullptr;
+  }
+
+  if (wl_vsync_surface_wrapper_) {
+    wl_proxy_wrapper_destroy(wl_vsync_surface_wrapper_);
+    wl_vsync_surface_wrapper_ = nullptr;
+  }
+
+  if (wl_vsync_queue_) {
+    wl_event_queue_destroy(wl_vsync_queue_);
+    wl_vsync_queue_ = nullptr;
+  }
+}
+
+void ELinuxWindowWayland::VsyncThreadLoop() {
+  pollfd fds[] = {
+      {wl_display_get_fd(wl_display_), POLLIN},
+      {vsync_thread_event_fd_, POLLIN},
+  };
+
+  while (true) {
+    while (wl_display_prepare_read_queue(wl_display_, wl_vsync_queue_) != 0) {
+      if (wl_display_dispatch_queue_pending(wl_display_, wl_vsync_queue_) ==
+          -1) {
+        ELINUX_LOG(ERROR) << "Failed to dispatch the vsync events.";
+        return;
+      }
+    }
+    wl_display_flush(wl_display_);
+
+    // Frame events don't arrive while nothing is drawn, so also wake up at the
+    // next vsync predicted from the last presented frame. While the window is
+    // suspended, sleep until it's resumed.
+    const int64_t interval_nanos = 1000000000000 / vsync_frame_rate_;
+    const int64_t now_nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    int64_t elapsed_nanos = (now_nanos - static_cast<int64_t>(
+                                             last_frame_time_nanos_)) %
+                            interval_nanos;
+    if (elapsed_nanos < 0) {
+      elapsed_nanos += interval_nanos;
+    }
+    const int timeout_ms =
+        suspended_ ? -1 : (interval_nanos - elapsed_nanos + 999999) / 1000000;
+
+    auto result = poll(fds, 2, timeout_ms);
+    if (result > 0 && (fds[1].revents & POLLIN)) {
+      wl_display_cancel_read(wl_display_);
+      if (!vsync_thread_running_) {
+        return;
+      }
+      uint64_t value;
+      if (read(vsync_thread_event_fd_, &value, sizeof(value)) == -1) {
+        ELINUX_LOG(ERROR) << "Failed to read the eventfd of the vsync thread.";
+      }
+      // Resumed. Serve the vsync requested while suspended, if any.
+      NotifyVsync();
+      continue;
+    }
+    if (result <= 0) {
+      wl_display_cancel_read(wl_display_);
+      if (result == 0) {
+        NotifyVsync();
+      }
+      continue;
+    }
+
+    if (wl_display_read_events(wl_display_) == -1 ||
+        wl_display_dispatch_queue_pending(wl_display_, wl_vsync_queue_) ==
+            -1) {
+      ELINUX_LOG(ERROR) << "Failed to dispatch the vsync events.";
+      return;
+    }
+  }
+}
+
+void ELinuxWindowWayland::NotifyVsync() {
+  resize_throttled_ = false;
+  if (suspended_) {
+    return;
+  }
+  if (binding_handler_delegate_) {
+    const uint64_t vsync_interval_time_nanos =
+        1000000000000 / vsync_frame_rate_;
+    binding_handler_delegate_->OnVsync(last_frame_time_nanos_,
+                                       vsync_interval_time_nanos);
+  }
+}
+
+void ELinuxWindowWayland::AckConfigure(uint32_t serial) {
+  constexpr int32_t x = 0;
+  int32_t y = 0;
+  auto width = view_properties_.width;
+  auto height = view_properties_.height;
+
+  if (window_decorations_) {
+    // Shift the window position to the bottom to show decoration
+    // even when the window is displayed in the upper left corner
+    // of the screen
+    y = -window_decorations_->Height();
+    if (!maximised_) {
+      height -= y;
+    }
+
+    // clip
+    if (display_max_height_ > 0) {
+      height = std::min(height, display_max_height_);
+    }
+  }
+  xdg_surface_set_window_geometry(xdg_surface_, x, y, width, height);
+  xdg_surface_ack_configure(xdg_surface_, serial);
+}
+
+void ELinuxWindowWayland::UpdateSuspended(bool suspended) {
+  if (suspended_ == suspended) {
+    return;
+  }
+
+  ELINUX_LOG(INFO) << "The window is " << (suspended ? "suspended" : "resumed");
+  suspended_ = suspended;
+  // No vsync comes while suspended. Don't hold back the pending configure.
+  resize_throttled_ = false;
+  if (binding_handler_delegate_) {
+    binding_handler_delegate_->OnWindowVisibilityChanged(!suspended);
+  }
+  if (!suspended) {
+    WakeUpVsyncThread();
+  }
+}
+
+uint64_t ELinuxWindowWayland::NextPresentationTime() const {
+  // The vsync thread predicts the vsync with std::chrono::steady_clock.
+  const uint64_t last_frame_time_nanos = last_frame_time_nanos_;
+  if (wp_presentation_clk_id_ != CLOCK_MONOTONIC ||
+      last_frame_time_nanos == 0) {
+    return 0;
+  }
+
+  const uint64_t interval_nanos = 1000000000000 / vsync_frame_rate_;
+  const uint64_t now_nanos =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  if (now_nanos < last_frame_time_nanos) {
+    return 0;
+  }
+  const uint64_t next_vsync_nanos =
+      now_nanos + interval_nanos -
+      (now_nanos - last_frame_time_nanos) % interval_nanos;
+
+  // Allow half an interval of error in the prediction, so that the frame is
+  // not deferred to the vsync after the next.
+  return next_vsync_nanos - interval_nanos / 2;
+}
+
 uint32_t ELinuxWindowWayland::WindowDecorationsPhysicalHeight() const {
   if (!window_decorations_) {
     return 0;
   }
 
-  return window_decorations_->Height() * current_scale_;
+  return std::round(window_decorations_->Height() * current_scale_);
 }
 
 }  // namespace flutter
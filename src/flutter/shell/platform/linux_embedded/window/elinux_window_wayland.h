@@ -8,13 +8,23 @@
 #include <wayland-client.h>
 #include <wayland-cursor.h>
 
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "flutter/shell/platform/linux_embedded/surface/surface_gl.h"
+#include "flutter/shell/platform/linux_embedded/surface/surface_software.h"
+#if defined(ENABLE_VULKAN)
+#include "flutter/shell/platform/linux_embedded/surface/surface_vulkan.h"
+#endif
 #include "flutter/shell/platform/linux_embedded/window/elinux_window.h"
 #include "flutter/shell/platform/linux_embedded/window/native_window_wayland.h"
+#if defined(USE_WAYLAND_DMABUF_SWAPCHAIN)
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland_gbm.h"
+#endif
 #include "flutter/shell/platform/linux_embedded/window/renderer/window_decorations_wayland.h"
 #include "flutter/shell/platform/linux_embedded/window_binding_handler.h"
 
@@ -24,10 +34,23 @@ extern "C" {
 #include "wayland/protocols/presentation-time-protocol.h"
 #include "wayland/protocols/text-input-unstable-v1-client-protocol.h"
 #include "wayland/protocols/text-input-unstable-v3-client-protocol.h"
+#include "wayland/protocols/viewporter-client-protocol.h"
 #include "wayland/protocols/xdg-decoration-unstable-v1-protocol.h"
 #include "wayland/protocols/xdg-shell-client-protocol.h"
 }
 
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+extern "C" {
+#include "wayland/protocols/fractional-scale-v1-client-protocol.h"
+}
+#endif
+
+#if defined(USE_WAYLAND_TEARING_CONTROL)
+extern "C" {
+#include "wayland/protocols/tearing-control-v1-client-protocol.h"
+}
+#endif
+
 namespace flutter {
 
 namespace {
@@ -66,9 +89,20 @@ class ELinuxWindowWayland : public ELinuxWindow, public WindowBindingHandler {
   // |FlutterWindowBindingHandler|
   ELinuxRenderSurfaceTarget* GetRenderSurfaceTarget() const override;
 
+  // |FlutterWindowBindingHandler|
+  SurfaceSoftware* GetSoftwareSurfaceTarget() const override;
+
+#if defined(ENABLE_VULKAN)
+  // |FlutterWindowBindingHandler|
+  SurfaceVulkan* GetVulkanSurfaceTarget() const override;
+#endif
+
   // |FlutterWindowBindingHandler|
   uint16_t GetRotationDegree() const override;
 
+  // |FlutterWindowBindingHandler|
+  bool IsRotationOffloaded() const override;
+
   // |FlutterWindowBindingHandler|
   double GetDpiScale() override;
 
@@ -85,7 +119,7 @@ class ELinuxWindowWayland : public ELinuxWindow, public WindowBindingHandler {
   void UpdateVirtualKeyboardStatus(const bool show) override;
 
   // |FlutterWindowBindingHandler|
-  std::string GetClipboardData() override;
+  void GetClipboardData(ClipboardCallback callback) override;
 
   // |FlutterWindowBindingHandler|
   void SetClipboardData(const std::string& data) override;
@@ -115,8 +149,62 @@ class ELinuxWindowWayland : public ELinuxWindow, public WindowBindingHandler {
   // Updates the surface scale of the window from the list of entered outputs.
   void UpdateWindowScale();
 
+  // Maps the main surface's buffer to its size in surface-local coordinates
+  // when the viewporter is used instead of the integer buffer scale.
+  void UpdateViewportDestination();
+
+  // Marks the whole main surface as opaque when the view is declared opaque,
+  // so that the compositor can skip blending it.
+  void UpdateOpaqueRegion();
+
+  // Get the integer buffer scale for surfaces that aren't covered by the
+  // viewporter (e.g. cursor and window decorations).
+  int32_t IntegerBufferScale() const;
+
+  // Gets the size of the main surface in surface-local coordinates, i.e. the
+  // buffer size divided by the scale and rotated by the buffer transform.
+  void GetSurfaceSizeDip(int32_t& width_dip, int32_t& height_dip) const;
+
   void CreateDecoration(int32_t width_dip, int32_t height_dip);
 
+#if defined(ENABLE_VULKAN)
+  // Creates the native window and the surface of the Vulkan renderer. Returns
+  // false if no Vulkan device can present to the window.
+  bool CreateVulkanSurface(int32_t width_px,
+                           int32_t height_px,
+                           bool enable_vsync);
+#endif
+
+  // Starts the thread which dispatches the frame and presentation events of
+  // the main surface and notifies the engine of vsync.
+  void StartVsyncThread();
+
+  void StopVsyncThread();
+
+  // Wakes up the vsync thread to stop it or to resume vsync.
+  void WakeUpVsyncThread();
+
+  void VsyncThreadLoop();
+
+  // Notifies the engine of vsync timing derived from the last presented frame.
+  // Called on the vsync thread.
+  void NotifyVsync();
+
+  // Sets the window geometry and acks the xdg_surface configure of |serial|.
+  void AckConfigure(uint32_t serial);
+
+  // Stops requesting vsync while the compositor has suspended the window (e.g.
+  // minimized or fully occluded), and notifies the lifecycle change.
+  void UpdateSuspended(bool suspended);
+
+  // Predicts the earliest presentation time of the next frame from the last
+  // presented frame. Called on the raster thread.
+  uint64_t NextPresentationTime() const;
+
+  // Reads the available clipboard data from |clipboard_read_fd_| without
+  // blocking, and completes the pending reads at the end of the data.
+  void ReadClipboardData();
+
   // Get window decorations height in physical pixels.
   uint32_t WindowDecorationsPhysicalHeight() const;
 
@@ -140,10 +228,17 @@ class ELinuxWindowWayland : public ELinuxWindow, public WindowBindingHandler {
       kWpPresentationFeedbackListener;
   static const zxdg_toplevel_decoration_v1_listener
       kZxdgToplevelDecorationV1Listener;
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+  static const wp_fractional_scale_v1_listener kWpFractionalScaleV1Listener;
+#endif
   static constexpr size_t kDefaultPointerSize = 24;
 
   std::unique_ptr<NativeWindowWayland> native_window_;
   std::unique_ptr<SurfaceGl> render_surface_;
+  std::unique_ptr<SurfaceSoftware> software_surface_;
+#if defined(ENABLE_VULKAN)
+  std::unique_ptr<SurfaceVulkan> vulkan_surface_;
+#endif
 
   // decorations.
   std::unique_ptr<WindowDecorationsWayland> window_decorations_;
@@ -157,10 +252,22 @@ class ELinuxWindowWayland : public ELinuxWindow, public WindowBindingHandler {
   bool running_;
   bool wait_for_configure_ = false;
   bool request_redraw_ = false;
+  // The latest xdg_surface configure which hasn't been acked yet.
+  bool has_pending_configure_ = false;
+  uint32_t pending_configure_serial_ = 0;
+  // The window size and scale last sent to the view.
+  int32_t applied_width_px_ = 0;
+  int32_t applied_height_px_ = 0;
+  double applied_scale_ = 0;
+  // Set when the window has been resized, until the next vsync.
+  std::atomic<bool> resize_throttled_{false};
   bool maximised_;
   uint32_t last_frame_time_;
   bool enable_impeller_ = false;
   int32_t transform_ = WL_OUTPUT_TRANSFORM_NORMAL;
+  // Set when the compositor rotates the buffers of the main surface with
+  // wl_surface.set_buffer_transform.
+  bool rotation_offloaded_ = false;
 
   // Indicates that exists a keyboard show request from Flutter Engine.
   bool is_requested_show_virtual_keyboard_;
@@ -187,10 +294,56 @@ class ELinuxWindowWayland : public ELinuxWindow, public WindowBindingHandler {
   zxdg_decoration_manager_v1* zxdg_decoration_manager_v1_ = nullptr;
   zxdg_toplevel_decoration_v1* zxdg_toplevel_decoration_v1_ = nullptr;
 
+  // viewporter and fractional-scale protocols for fractional scale factors.
+  // Without fractional-scale, the integer buffer scale is used instead.
+  wp_viewporter* wp_viewporter_ = nullptr;
+  wp_viewport* wp_viewport_ = nullptr;
+#if defined(USE_WAYLAND_FRACTIONAL_SCALE)
+  wp_fractional_scale_manager_v1* wp_fractional_scale_manager_v1_ = nullptr;
+  wp_fractional_scale_v1* wp_fractional_scale_v1_ = nullptr;
+#endif
+
+#if defined(USE_WAYLAND_TEARING_CONTROL)
+  // tearing-control protocol for the low-latency mode.
+  wp_tearing_control_manager_v1* wp_tearing_control_manager_v1_ = nullptr;
+  wp_tearing_control_v1* wp_tearing_control_v1_ = nullptr;
+#endif
+
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+  // fifo and commit-timing protocols for pacing the frames without blocking
+  // the raster thread.
+  wp_fifo_manager_v1* wp_fifo_manager_v1_ = nullptr;
+  wp_commit_timing_manager_v1* wp_commit_timing_manager_v1_ = nullptr;
+#endif
+
+#if defined(USE_WAYLAND_DMABUF_SWAPCHAIN)
+  // linux-dmabuf protocol for allocating the surface buffers by ourselves.
+  zwp_linux_dmabuf_v1* zwp_linux_dmabuf_v1_ = nullptr;
+#endif
+
   // Frame information for Vsync events.
   wp_presentation* wp_presentation_;
-  uint32_t wp_presentation_clk_id_;
-  uint64_t last_frame_time_nanos_;
+  std::atomic<uint32_t> wp_presentation_clk_id_;
+  std::atomic<uint64_t> last_frame_time_nanos_;
+
+  // Frame callbacks and presentation feedback are dispatched on a dedicated
+  // queue by the vsync thread, so that frame pacing doesn't depend on the load
+  // of the platform thread.
+  wl_event_queue* wl_vsync_queue_ = nullptr;
+  wl_surface* wl_vsync_surface_wrapper_ = nullptr;
+  wp_presentation* wp_presentation_wrapper_ = nullptr;
+  wl_callback* wl_frame_callback_ = nullptr;
+  wp_presentation_feedback* wp_presentation_feedback_ = nullptr;
+  std::thread vsync_thread_;
+  int vsync_thread_event_fd_ = -1;
+  std::atomic<bool> vsync_thread_running_{false};
+  // Set while xdg_toplevel is in the suspended state.
+  std::atomic<bool> suspended_{false};
+  // The refresh rate in mHz used by the vsync thread.
+  std::atomic<int32_t> vsync_frame_rate_{60000};
+  // Window decorations are drawn on the platform thread at the next
+  // DispatchEvent() after a frame was presented.
+  std::atomic<bool> request_draw_decorations_{false};
 
   CursorInfo cursor_info_;
   size_t cursor_size_;
@@ -215,6 +368,13 @@ class ELinuxWindowWayland : public ELinuxWindow, public WindowBindingHandler {
   wl_data_source* wl_data_source_;
   uint32_t wl_data_device_manager_version_;
   uint32_t serial_;
+
+  // The clipboard data of another client is streamed through a pipe watched
+  // by DispatchEvent(), so that a slow source doesn't block the platform
+  // thread. Reads requested while a transfer is running share its result.
+  int clipboard_read_fd_ = -1;
+  std::string clipboard_read_data_;
+  std::vector<ClipboardCallback> clipboard_read_callbacks_;
 };
 
 }  // namespace flutter
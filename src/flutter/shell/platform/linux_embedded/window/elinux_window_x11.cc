@@ -7,93 +7,201 @@
 #include <fcntl.h>
 #include <linux/input-event-codes.h>
 #include <unistd.h>
+#include <xcb/present.h>
 
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "flutter/shell/platform/common/utf_conversion.h"
 #include "flutter/shell/platform/linux_embedded/logger.h"
 #include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
+#include "flutter/shell/platform/linux_embedded/window/native_window_x11_shm.h"
+#if defined(ENABLE_VULKAN)
+#include "flutter/shell/platform/linux_embedded/window/native_window_x11_vulkan.h"
+#endif
 
 namespace flutter {
 
 namespace {
-// Only Button1 - Button5 are defined in X11/X.h
+// Only XCB_BUTTON_INDEX_1 - XCB_BUTTON_INDEX_5 are defined in xcb/xproto.h
 constexpr int kButton6 = 6;
 constexpr int kButton7 = 7;
 constexpr int kButton8 = 8;
 constexpr int kButton9 = 9;
+
+constexpr char kClipboard[] = "CLIPBOARD";
+// The property of our window to which the selection owner stores the data.
+constexpr char kClipboardProperty[] = "FLUTTER_CLIPBOARD";
+constexpr char kTargets[] = "TARGETS";
+constexpr char kUtf8String[] = "UTF8_STRING";
+
+// Converts |utf8| to Latin-1, the encoding of the STRING target. The
+// characters which Latin-1 can't represent are replaced with '?'.
+std::string Latin1FromUtf8(const std::string& utf8) {
+  std::string latin1;
+  for (const auto c : Utf16FromUtf8(utf8)) {
+    if (c <= 0xff) {
+      latin1.push_back(static_cast<char>(c));
+    } else if (c < 0xdc00 || c > 0xdfff) {
+      // A low surrogate follows the high one, which is already replaced.
+      latin1.push_back('?');
+    }
+  }
+  return latin1;
+}
+
+// Converts |latin1|, e.g. the data of the STRING target, to UTF-8.
+std::string Utf8FromLatin1(const std::string& latin1) {
+  std::u16string utf16;
+  for (const auto c : latin1) {
+    utf16.push_back(static_cast<unsigned char>(c));
+  }
+  return Utf8FromUtf16(utf16);
+}
+
+xcb_atom_t InternAtom(xcb_connection_t* connection, const char* name) {
+  auto reply = xcb_intern_atom_reply(
+      connection, xcb_intern_atom(connection, false, std::strlen(name), name),
+      nullptr);
+  if (!reply) {
+    return XCB_ATOM_NONE;
+  }
+  auto atom = reply->atom;
+  free(reply);
+  return atom;
+}
 }  // namespace
 
 ELinuxWindowX11::ELinuxWindowX11(FlutterDesktopViewProperties view_properties) {
-  view_properties_ = view_properties;
+  SetViewProperties(view_properties);
   current_scale_ =
       view_properties.force_scale_factor ? view_properties.scale_factor : 1.0;
   SetRotation(view_properties_.view_rotation);
 
-  display_ = XOpenDisplay(NULL);
-  if (!display_) {
-    ELINUX_LOG(ERROR) << "Failed to open display.";
+  x11_display_ = X11Display::Get();
+  if (!x11_display_) {
     return;
   }
+  display_ = x11_display_->display();
+  connection_ = x11_display_->connection();
+  screen_ = x11_display_->screen();
+
+  clipboard_atom_ = InternAtom(connection_, kClipboard);
+  clipboard_property_atom_ = InternAtom(connection_, kClipboardProperty);
+  targets_atom_ = InternAtom(connection_, kTargets);
+  utf8_string_atom_ = InternAtom(connection_, kUtf8String);
+
+  auto present = xcb_get_extension_data(connection_, &xcb_present_id);
+  if (present && present->present) {
+    auto reply = xcb_present_query_version_reply(
+        connection_,
+        xcb_present_query_version(connection_, XCB_PRESENT_MAJOR_VERSION,
+                                  XCB_PRESENT_MINOR_VERSION),
+        nullptr);
+    if (reply) {
+      present_available_ = true;
+      present_opcode_ = present->major_opcode;
+      free(reply);
+    }
+  }
+  if (!present_available_) {
+    ELINUX_LOG(WARNING) << "The Present extension isn't supported. Vsync "
+                           "events won't be delivered.";
+  }
 
   display_valid_ = true;
 }
 
 ELinuxWindowX11::~ELinuxWindowX11() {
+  DestroyRenderSurface();
   display_valid_ = false;
-  if (display_) {
-    XSetCloseDownMode(display_, DestroyAll);
-    XCloseDisplay(display_);
-  }
 }
 
 bool ELinuxWindowX11::IsValid() const {
-  if (!display_valid_ || !native_window_ || !render_surface_ ||
-      !native_window_->IsValid() || !render_surface_->IsValid()) {
+  if (!display_valid_ || !native_window_ || !native_window_->IsValid()) {
     return false;
   }
-  return true;
+  if (software_surface_) {
+    return software_surface_->IsValid();
+  }
+#if defined(ENABLE_VULKAN)
+  if (vulkan_surface_) {
+    return vulkan_surface_->IsValid();
+  }
+#endif
+  return render_surface_ && render_surface_->IsValid();
 }
 
 bool ELinuxWindowX11::DispatchEvent() {
-  while (XPending(display_)) {
-    XEvent event;
-    XNextEvent(display_, &event);
-    switch (event.type) {
-      case EnterNotify:
-      case MotionNotify:
+  if (xcb_connection_has_error(connection_)) {
+    ELINUX_LOG(ERROR) << "X11 connection is invalid.";
+    return false;
+  }
+
+  // Interactive resizes generate a ConfigureNotify per motion. Only the last
+  // size of this dispatch is applied.
+  bool resized = false;
+  bool destroyed = false;
+  xcb_generic_event_t* event = queued_event_;
+  queued_event_ = nullptr;
+  if (!event) {
+    event = x11_display_->PollForEvent(event_window_, false);
+  }
+  while (event) {
+    switch (event->response_type & ~0x80) {
+      case XCB_ENTER_NOTIFY:
         if (binding_handler_delegate_) {
-          binding_handler_delegate_->OnPointerMove(event.xbutton.x,
-                                                   event.xbutton.y);
+          auto* enter = reinterpret_cast<xcb_enter_notify_event_t*>(event);
+          binding_handler_delegate_->OnPointerMove(enter->event_x,
+                                                   enter->event_y);
         }
         break;
-      case LeaveNotify:
+      case XCB_MOTION_NOTIFY:
+        if (binding_handler_delegate_) {
+          auto* motion = reinterpret_cast<xcb_motion_notify_event_t*>(event);
+          binding_handler_delegate_->OnPointerMove(motion->event_x,
+                                                   motion->event_y);
+        }
+        break;
+      case XCB_LEAVE_NOTIFY:
         if (binding_handler_delegate_) {
           binding_handler_delegate_->OnPointerLeave();
         }
         break;
-      case ButtonPress: {
+      case XCB_BUTTON_PRESS: {
+        auto* button = reinterpret_cast<xcb_button_press_event_t*>(event);
         constexpr bool button_pressed = true;
-        HandlePointerButtonEvent(event.xbutton.button, button_pressed,
-                                 event.xbutton.x, event.xbutton.y);
+        HandlePointerButtonEvent(button->detail, button_pressed,
+                                 button->event_x, button->event_y);
       } break;
-      case ButtonRelease: {
+      case XCB_BUTTON_RELEASE: {
+        auto* button = reinterpret_cast<xcb_button_release_event_t*>(event);
         constexpr bool button_pressed = false;
-        HandlePointerButtonEvent(event.xbutton.button, button_pressed,
-                                 event.xbutton.x, event.xbutton.y);
+        HandlePointerButtonEvent(button->detail, button_pressed,
+                                 button->event_x, button->event_y);
       } break;
-      case KeyPress:
+      case XCB_KEY_PRESS:
         if (binding_handler_delegate_) {
+          auto* key = reinterpret_cast<xcb_key_press_event_t*>(event);
           constexpr bool pressed = true;
-          binding_handler_delegate_->OnKey(event.xkey.keycode - 8, pressed);
+          binding_handler_delegate_->OnKey(key->detail - 8, pressed);
         }
         break;
-      case KeyRelease:
+      case XCB_KEY_RELEASE:
         if (binding_handler_delegate_) {
+          auto* key = reinterpret_cast<xcb_key_release_event_t*>(event);
           constexpr bool pressed = false;
-          binding_handler_delegate_->OnKey(event.xkey.keycode - 8, pressed);
+          binding_handler_delegate_->OnKey(key->detail - 8, pressed);
         }
         break;
-      case ConfigureNotify: {
-        auto width = event.xconfigure.width;
-        auto height = event.xconfigure.height;
+      case XCB_CONFIGURE_NOTIFY: {
+        auto* configure =
+            reinterpret_cast<xcb_configure_notify_event_t*>(event);
+        int32_t width = configure->width;
+        int32_t height = configure->height;
         if (current_rotation_ == 90 || current_rotation_ == 270) {
           std::swap(width, height);
         }
@@ -102,36 +210,92 @@ bool ELinuxWindowX11::DispatchEvent() {
              (height != view_properties_.height))) {
           view_properties_.width = width;
           view_properties_.height = height;
-          if (binding_handler_delegate_) {
-            binding_handler_delegate_->OnWindowSizeChanged(
-                view_properties_.width, view_properties_.height);
-          }
+          resized = true;
         }
       } break;
-      case ClientMessage:
-        native_window_->Destroy(display_);
+      case XCB_SELECTION_NOTIFY:
+        HandleSelectionNotify(
+            *reinterpret_cast<xcb_selection_notify_event_t*>(event));
+        break;
+      case XCB_SELECTION_REQUEST:
+        HandleSelectionRequest(
+            *reinterpret_cast<xcb_selection_request_event_t*>(event));
         break;
-      case DestroyNotify:
+      case XCB_CLIENT_MESSAGE:
+        native_window_->Destroy(connection_);
+        break;
+      case XCB_DESTROY_NOTIFY:
         // Quit the main loop.
-        return false;
+        destroyed = true;
+        break;
+      case XCB_GE_GENERIC:
+        HandlePresentEvent(*reinterpret_cast<xcb_ge_generic_event_t*>(event));
+        break;
       default:
         break;
     }
+    free(event);
+    if (destroyed) {
+      break;
+    }
+    event = x11_display_->PollForEvent(event_window_, false);
   }
+  if (destroyed) {
+    return false;
+  }
+
+  if (resized && binding_handler_delegate_) {
+    binding_handler_delegate_->OnWindowSizeChanged(view_properties_.width,
+                                                   view_properties_.height);
+  }
+  xcb_flush(connection_);
   return true;
 }
 
+int ELinuxWindowX11::GetEventFd() const {
+  if (!connection_) {
+    return -1;
+  }
+  return xcb_get_file_descriptor(connection_);
+}
+
+bool ELinuxWindowX11::HasPendingEvents() {
+  // EGL, the engine threads and the other windows also read from the
+  // connection, which queues the events without leaving the fd readable.
+  if (!queued_event_ && x11_display_) {
+    queued_event_ = x11_display_->PollForEvent(event_window_, true);
+  }
+  return queued_event_ != nullptr;
+}
+
 bool ELinuxWindowX11::CreateRenderSurface(int32_t width,
                                           int32_t height,
                                           bool enable_impeller) {
+  if (view_properties_.renderer_type ==
+      FlutterDesktopRendererType::kRendererSoftware) {
+    return CreateSoftwareSurface(width, height);
+  }
+#if defined(ENABLE_VULKAN)
+  if (view_properties_.renderer_type ==
+      FlutterDesktopRendererType::kRendererVulkan) {
+    if (CreateVulkanSurface(width, height)) {
+      return true;
+    }
+    ELINUX_LOG(WARNING) << "Vulkan isn't available, use OpenGL ES.";
+    view_properties_.renderer_type =
+        FlutterDesktopRendererType::kRendererOpenGL;
+  }
+#endif
+
   auto context_egl = std::make_unique<ContextEgl>(
-      std::make_unique<EnvironmentEgl>(display_), enable_impeller);
+      std::make_unique<EnvironmentEgl>(display_), enable_impeller,
+      EGL_WINDOW_BIT, GetEglConfigAttributes());
 
   if (current_rotation_ == 90 || current_rotation_ == 270) {
     std::swap(width, height);
   }
   native_window_ = std::make_unique<NativeWindowX11>(
-      display_, context_egl->GetAttrib(EGL_NATIVE_VISUAL_ID),
+      connection_, screen_, context_egl->GetAttrib(EGL_NATIVE_VISUAL_ID),
       view_properties_.title, width, height, view_properties_.enable_vsync,
       view_properties_.view_mode == FlutterDesktopViewMode::kFullscreen);
   if (!native_window_->IsValid()) {
@@ -142,13 +306,108 @@ bool ELinuxWindowX11::CreateRenderSurface(int32_t width,
   render_surface_ = std::make_unique<SurfaceGl>(std::move(context_egl));
   render_surface_->SetNativeWindow(native_window_.get());
 
+  StartEvents();
+  return true;
+}
+
+bool ELinuxWindowX11::CreateSoftwareSurface(int32_t width, int32_t height) {
+  if (current_rotation_ != 0) {
+    ELINUX_LOG(WARNING) << "The software renderer can't rotate the frames. "
+                           "The view rotation is ignored.";
+    SetRotation(FlutterDesktopViewRotation::kRotation_0);
+  }
+
+  native_window_ = std::make_unique<NativeWindowX11Shm>(
+      connection_, screen_, view_properties_.title, width, height,
+      view_properties_.enable_vsync,
+      view_properties_.view_mode == FlutterDesktopViewMode::kFullscreen);
+  if (!native_window_->IsValid()) {
+    ELINUX_LOG(ERROR) << "Failed to create the native window";
+    return false;
+  }
+
+  software_surface_ = std::make_unique<SurfaceSoftware>();
+  software_surface_->SetNativeWindow(native_window_.get());
+
+  StartEvents();
+  return true;
+}
+
+#if defined(ENABLE_VULKAN)
+bool ELinuxWindowX11::CreateVulkanSurface(int32_t width, int32_t height) {
+  native_window_ = std::make_unique<NativeWindowX11Vulkan>(
+      connection_, screen_, view_properties_.title, width, height,
+      view_properties_.enable_vsync,
+      view_properties_.view_mode == FlutterDesktopViewMode::kFullscreen);
+  if (!native_window_->IsValid()) {
+    ELINUX_LOG(ERROR) << "Failed to create the native window";
+    native_window_ = nullptr;
+    return false;
+  }
+
+  auto context = std::make_unique<ContextVulkan>(native_window_.get());
+  if (!context->IsValid()) {
+    native_window_->Destroy(connection_);
+    native_window_ = nullptr;
+    return false;
+  }
+  vulkan_surface_ = std::make_unique<SurfaceVulkan>(std::move(context));
+  if (!vulkan_surface_->SetNativeWindow(native_window_.get())) {
+    vulkan_surface_ = nullptr;
+    native_window_->Destroy(connection_);
+    native_window_ = nullptr;
+    return false;
+  }
+
+  // There's no surface transformation with Vulkan.
+  if (current_rotation_ != 0) {
+    ELINUX_LOG(WARNING) << "The Vulkan renderer can't rotate the frames. The "
+                           "view rotation is ignored.";
+    SetRotation(FlutterDesktopViewRotation::kRotation_0);
+  }
+
+  StartEvents();
   return true;
 }
+#endif
+
+void ELinuxWindowX11::StartEvents() {
+  event_window_ = native_window_->Window();
+  x11_display_->AddWindow(event_window_);
+
+  if (present_available_) {
+    present_event_id_ = xcb_generate_id(connection_);
+    xcb_present_select_input(connection_, present_event_id_,
+                             native_window_->Window(),
+                             XCB_PRESENT_EVENT_MASK_COMPLETE_NOTIFY);
+    last_ust_ = 0;
+    last_msc_ = 0;
+    present_window_ = native_window_->Window();
+    // Sample the first UST and MSC to measure the refresh rate from.
+    RequestVsync();
+  }
+}
 
 void ELinuxWindowX11::DestroyRenderSurface() {
+  present_window_ = XCB_WINDOW_NONE;
+
   // destroy the main surface before destroying the client window on X11.
   render_surface_ = nullptr;
-  native_window_ = nullptr;
+  software_surface_ = nullptr;
+#if defined(ENABLE_VULKAN)
+  vulkan_surface_ = nullptr;
+#endif
+  if (native_window_) {
+    // The connection is shared, so the window isn't destroyed by closing it.
+    native_window_->Destroy(connection_);
+    native_window_ = nullptr;
+  }
+  if (event_window_ != XCB_WINDOW_NONE) {
+    x11_display_->RemoveWindow(event_window_);
+    event_window_ = XCB_WINDOW_NONE;
+  }
+  free(queued_event_);
+  queued_event_ = nullptr;
 }
 
 void ELinuxWindowX11::SetView(WindowBindingHandlerDelegate* window) {
@@ -159,6 +418,16 @@ ELinuxRenderSurfaceTarget* ELinuxWindowX11::GetRenderSurfaceTarget() const {
   return render_surface_.get();
 }
 
+SurfaceSoftware* ELinuxWindowX11::GetSoftwareSurfaceTarget() const {
+  return software_surface_.get();
+}
+
+#if defined(ENABLE_VULKAN)
+SurfaceVulkan* ELinuxWindowX11::GetVulkanSurfaceTarget() const {
+  return vulkan_surface_.get();
+}
+#endif
+
 uint16_t ELinuxWindowX11::GetRotationDegree() const {
   return current_rotation_;
 }
@@ -172,7 +441,7 @@ PhysicalWindowBounds ELinuxWindowX11::GetPhysicalWindowBounds() {
 }
 
 int32_t ELinuxWindowX11::GetFrameRate() {
-  return 60000;
+  return frame_rate_;
 }
 
 void ELinuxWindowX11::UpdateFlutterCursor(const std::string& cursor_name) {
@@ -183,12 +452,174 @@ void ELinuxWindowX11::UpdateVirtualKeyboardStatus(const bool show) {
   // currently not supported.
 }
 
-std::string ELinuxWindowX11::GetClipboardData() {
-  return clipboard_data_;
+void ELinuxWindowX11::GetClipboardData(ClipboardCallback callback) {
+  if (!native_window_) {
+    callback(clipboard_data_);
+    return;
+  }
+
+  // No other client owns the selection, so use the local copy.
+  xcb_window_t owner = XCB_NONE;
+  auto reply = xcb_get_selection_owner_reply(
+      connection_, xcb_get_selection_owner(connection_, clipboard_atom_),
+      nullptr);
+  if (reply) {
+    owner = reply->owner;
+    free(reply);
+  }
+  if (owner == XCB_NONE || owner == native_window_->Window()) {
+    callback(clipboard_data_);
+    return;
+  }
+
+  clipboard_read_callbacks_.push_back(std::move(callback));
+  if (clipboard_read_callbacks_.size() > 1) {
+    // A conversion is already running.
+    return;
+  }
+
+  // The result is delivered with SelectionNotify to DispatchEvent().
+  xcb_convert_selection(connection_, native_window_->Window(), clipboard_atom_,
+                        utf8_string_atom_, clipboard_property_atom_,
+                        XCB_CURRENT_TIME);
+  xcb_flush(connection_);
 }
 
 void ELinuxWindowX11::SetClipboardData(const std::string& data) {
   clipboard_data_ = data;
+  if (native_window_) {
+    xcb_set_selection_owner(connection_, native_window_->Window(),
+                            clipboard_atom_, XCB_CURRENT_TIME);
+    xcb_flush(connection_);
+  }
+}
+
+void ELinuxWindowX11::HandleSelectionNotify(
+    const xcb_selection_notify_event_t& event) {
+  if (event.selection != clipboard_atom_ || clipboard_read_callbacks_.empty()) {
+    return;
+  }
+
+  std::string data;
+  if (event.property != XCB_NONE) {
+    auto reply = xcb_get_property_reply(
+        connection_,
+        xcb_get_property(connection_, true, event.requestor, event.property,
+                         XCB_GET_PROPERTY_TYPE_ANY, 0, UINT32_MAX / 4),
+        nullptr);
+    if (reply) {
+      if (reply->type == utf8_string_atom_ || reply->type == XCB_ATOM_STRING) {
+        data.assign(static_cast<char*>(xcb_get_property_value(reply)),
+                    xcb_get_property_value_length(reply));
+        // Some owners answer with STRING, which is Latin-1.
+        if (reply->type == XCB_ATOM_STRING) {
+          data = Utf8FromLatin1(data);
+        }
+      } else {
+        // e.g. INCR for very large data, which isn't supported.
+        ELINUX_LOG(WARNING) << "Unsupported clipboard data type.";
+      }
+      free(reply);
+    }
+  }
+
+  auto callbacks = std::move(clipboard_read_callbacks_);
+  clipboard_read_callbacks_.clear();
+  for (const auto& callback : callbacks) {
+    callback(data);
+  }
+}
+
+void ELinuxWindowX11::HandleSelectionRequest(
+    const xcb_selection_request_event_t& event) {
+  // xcb_send_event() always sends 32 bytes.
+  char buffer[32] = {};
+  auto* reply = reinterpret_cast<xcb_selection_notify_event_t*>(buffer);
+  reply->response_type = XCB_SELECTION_NOTIFY;
+  reply->requestor = event.requestor;
+  reply->selection = event.selection;
+  reply->target = event.target;
+  reply->time = event.time;
+  // Obsolete clients may set the property to None.
+  reply->property = event.property != XCB_NONE ? event.property : event.target;
+
+  if (event.selection != clipboard_atom_) {
+    reply->property = XCB_NONE;
+  } else if (event.target == targets_atom_) {
+    xcb_atom_t targets[] = {targets_atom_, utf8_string_atom_, XCB_ATOM_STRING};
+    xcb_change_property(connection_, XCB_PROP_MODE_REPLACE, event.requestor,
+                        reply->property, XCB_ATOM_ATOM, 32,
+                        sizeof(targets) / sizeof(targets[0]), targets);
+  } else if (event.target == utf8_string_atom_) {
+    xcb_change_property(connection_, XCB_PROP_MODE_REPLACE, event.requestor,
+                        reply->property, event.target, 8,
+                        clipboard_data_.size(), clipboard_data_.c_str());
+  } else if (event.target == XCB_ATOM_STRING) {
+    const auto latin1 = Latin1FromUtf8(clipboard_data_);
+    xcb_change_property(connection_, XCB_PROP_MODE_REPLACE, event.requestor,
+                        reply->property, event.target, 8, latin1.size(),
+                        latin1.c_str());
+  } else {
+    reply->property = XCB_NONE;
+  }
+
+  xcb_send_event(connection_, false, event.requestor, XCB_EVENT_MASK_NO_EVENT,
+                 buffer);
+  xcb_flush(connection_);
+}
+
+void ELinuxWindowX11::HandlePresentEvent(const xcb_ge_generic_event_t& event) {
+  if (!present_available_ || event.extension != present_opcode_ ||
+      event.event_type != XCB_PRESENT_EVENT_COMPLETE_NOTIFY) {
+    return;
+  }
+
+  auto& complete =
+      reinterpret_cast<const xcb_present_complete_notify_event_t&>(event);
+  if (complete.event != present_event_id_ ||
+      complete.kind != XCB_PRESENT_COMPLETE_KIND_NOTIFY_MSC) {
+    return;
+  }
+
+  // UST is CLOCK_MONOTONIC in microseconds, the same clock as the engine.
+  if (last_ust_ != 0 && complete.msc > last_msc_ && complete.ust > last_ust_) {
+    const auto interval_us =
+        static_cast<double>(complete.ust - last_ust_) /
+        (complete.msc - last_msc_);
+    const auto frame_rate =
+        static_cast<int32_t>(std::round(1000000000.0 / interval_us));
+    // UST jitters a little. Only follow actual refresh rate changes.
+    if (std::abs(frame_rate - frame_rate_) > frame_rate_ / 100) {
+      frame_rate_ = frame_rate;
+      NotifyDisplayInfoUpdates();
+    }
+  }
+  last_ust_ = complete.ust;
+  last_msc_ = complete.msc;
+
+  // The next notification is requested by the engine when it waits for the
+  // vsync, so an idle app doesn't wake up on every vblank.
+  if (binding_handler_delegate_ && frame_rate_ > 0) {
+    binding_handler_delegate_->OnVsync(last_ust_ * 1000,
+                                       1000000000000 / frame_rate_);
+  }
+}
+
+void ELinuxWindowX11::RequestVsync() {
+  const xcb_window_t window = present_window_;
+  if (window == XCB_WINDOW_NONE) {
+    return;
+  }
+
+  // With a divisor of 1, the notification is sent at the next MSC. XCB is
+  // thread-safe, so this may be called on the UI thread of the engine.
+  constexpr uint32_t kSerial = 0;
+  constexpr uint64_t kTargetMsc = 0;
+  constexpr uint64_t kDivisor = 1;
+  constexpr uint64_t kRemainder = 0;
+  xcb_present_notify_msc(connection_, window, kSerial, kTargetMsc, kDivisor,
+                         kRemainder);
+  xcb_flush(connection_);
 }
 
 void ELinuxWindowX11::HandlePointerButtonEvent(uint32_t button,
@@ -198,21 +629,22 @@ void ELinuxWindowX11::HandlePointerButtonEvent(uint32_t button,
   if (binding_handler_delegate_) {
     FlutterPointerMouseButtons flutter_button;
     switch (button) {
-      case Button1:
+      case XCB_BUTTON_INDEX_1:
         flutter_button = kFlutterPointerButtonMousePrimary;
         break;
-      case Button2:
+      case XCB_BUTTON_INDEX_2:
         flutter_button = kFlutterPointerButtonMouseMiddle;
         break;
-      case Button3:
+      case XCB_BUTTON_INDEX_3:
         flutter_button = kFlutterPointerButtonMouseSecondary;
         break;
-      case Button4:
-      case Button5:
+      case XCB_BUTTON_INDEX_4:
+      case XCB_BUTTON_INDEX_5:
       case kButton6:
       case kButton7: {
-        const bool vertical_scroll = (button == Button4 || button == Button5);
-        const double delta = button == Button5 ? 1 : -1;
+        const bool vertical_scroll =
+            (button == XCB_BUTTON_INDEX_4 || button == XCB_BUTTON_INDEX_5);
+        const double delta = button == XCB_BUTTON_INDEX_5 ? 1 : -1;
         constexpr int32_t kScrollOffsetMultiplier = 20;
         binding_handler_delegate_->OnScroll(x, y, vertical_scroll ? 0 : delta,
                                             vertical_scroll ? delta : 0,
@@ -5,11 +5,21 @@
 #ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_ELINUX_WINDOW_X11_H_
 #define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_ELINUX_WINDOW_X11_H_
 
+#include <X11/Xlib.h>
+#include <xcb/xcb.h>
+
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include "flutter/shell/platform/linux_embedded/surface/surface_gl.h"
+#include "flutter/shell/platform/linux_embedded/surface/surface_software.h"
+#if defined(ENABLE_VULKAN)
+#include "flutter/shell/platform/linux_embedded/surface/surface_vulkan.h"
+#endif
 #include "flutter/shell/platform/linux_embedded/window/elinux_window.h"
 #include "flutter/shell/platform/linux_embedded/window/native_window_x11.h"
+#include "flutter/shell/platform/linux_embedded/window/x11_display.h"
 #include "flutter/shell/platform/linux_embedded/window_binding_handler.h"
 
 namespace flutter {
@@ -25,6 +35,18 @@ class ELinuxWindowX11 : public ELinuxWindow, public WindowBindingHandler {
   // |FlutterWindowBindingHandler|
   bool DispatchEvent() override;
 
+  // |FlutterWindowBindingHandler|
+  int GetEventFd() const override;
+
+  // |FlutterWindowBindingHandler|
+  bool HasPendingEvents() override;
+
+  // |FlutterWindowBindingHandler|
+  bool IsVsyncRequestSupported() const override { return present_available_; }
+
+  // |FlutterWindowBindingHandler|
+  void RequestVsync() override;
+
   // |FlutterWindowBindingHandler|
   bool CreateRenderSurface(int32_t width,
                            int32_t height,
@@ -39,6 +61,14 @@ class ELinuxWindowX11 : public ELinuxWindow, public WindowBindingHandler {
   // |FlutterWindowBindingHandler|
   ELinuxRenderSurfaceTarget* GetRenderSurfaceTarget() const override;
 
+  // |FlutterWindowBindingHandler|
+  SurfaceSoftware* GetSoftwareSurfaceTarget() const override;
+
+#if defined(ENABLE_VULKAN)
+  // |FlutterWindowBindingHandler|
+  SurfaceVulkan* GetVulkanSurfaceTarget() const override;
+#endif
+
   // |FlutterWindowBindingHandler|
   uint16_t GetRotationDegree() const override;
 
@@ -58,23 +88,86 @@ class ELinuxWindowX11 : public ELinuxWindow, public WindowBindingHandler {
   void UpdateVirtualKeyboardStatus(const bool show) override;
 
   // |FlutterWindowBindingHandler|
-  std::string GetClipboardData() override;
+  void GetClipboardData(ClipboardCallback callback) override;
 
   // |FlutterWindowBindingHandler|
   void SetClipboardData(const std::string& data) override;
 
  private:
+  // Creates the window presenting the frames of the software renderer.
+  bool CreateSoftwareSurface(int32_t width, int32_t height);
+
+#if defined(ENABLE_VULKAN)
+  // Creates the window presenting the frames of the Vulkan renderer. Returns
+  // false if no Vulkan device can present to it.
+  bool CreateVulkanSurface(int32_t width, int32_t height);
+#endif
+
+  // Starts receiving the events of the window, and the Present events which
+  // drive the vsync.
+  void StartEvents();
+
   // Handles the events of the mouse button.
   void HandlePointerButtonEvent(uint32_t button,
                                 bool button_pressed,
                                 int16_t x,
                                 int16_t y);
 
+  // Completes the pending clipboard reads with the converted selection.
+  void HandleSelectionNotify(const xcb_selection_notify_event_t& event);
+
+  // Sends the clipboard data to another client requesting our selection.
+  void HandleSelectionRequest(const xcb_selection_request_event_t& event);
+
+  // Handles the events of the Present extension.
+  void HandlePresentEvent(const xcb_ge_generic_event_t& event);
+
+  // The connection shared with the other windows of the process, which
+  // outlives the surfaces.
+  std::shared_ptr<X11Display> x11_display_;
   Display* display_ = nullptr;
+  xcb_connection_t* connection_ = nullptr;
+  xcb_screen_t* screen_ = nullptr;
   std::unique_ptr<NativeWindowX11> native_window_;
   std::unique_ptr<SurfaceGl> render_surface_;
+  std::unique_ptr<SurfaceSoftware> software_surface_;
+#if defined(ENABLE_VULKAN)
+  std::unique_ptr<SurfaceVulkan> vulkan_surface_;
+#endif
 
   bool display_valid_;
+
+  // Atoms for the CLIPBOARD selection.
+  xcb_atom_t clipboard_atom_ = XCB_ATOM_NONE;
+  xcb_atom_t clipboard_property_atom_ = XCB_ATOM_NONE;
+  xcb_atom_t targets_atom_ = XCB_ATOM_NONE;
+  xcb_atom_t utf8_string_atom_ = XCB_ATOM_NONE;
+
+  // The Present extension is used as the vsync source. Its events are
+  // delivered as generic events of this major opcode.
+  bool present_available_ = false;
+  uint8_t present_opcode_ = 0;
+  uint32_t present_event_id_ = 0;
+
+  // The event taken from the queue of the window by HasPendingEvents(), which
+  // is dispatched first by DispatchEvent().
+  xcb_generic_event_t* queued_event_ = nullptr;
+
+  // The window whose events are dispatched, or XCB_WINDOW_NONE.
+  xcb_window_t event_window_ = XCB_WINDOW_NONE;
+
+  // The window whose vblanks are notified, or XCB_WINDOW_NONE. The engine
+  // requests the vsync on its UI thread.
+  std::atomic<xcb_window_t> present_window_{XCB_WINDOW_NONE};
+
+  // UST (in microseconds) and MSC of the last PresentCompleteNotify.
+  uint64_t last_ust_ = 0;
+  uint64_t last_msc_ = 0;
+
+  // The selection owned by another client is converted asynchronously and
+  // delivered with SelectionNotify. Reads requested while a conversion is
+  // running share its result.
+  std::vector<ClipboardCallback> clipboard_read_callbacks_;
 };
 
 }  // namespace flutter
@@ -0,0 +1,33 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_GBM_FORMAT_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_GBM_FORMAT_H_
+
+#include <gbm.h>
+
+#include <cstdint>
+
+#include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
+
+namespace flutter {
+
+// Returns the GBM format of the buffers matching |config_attributes|.
+inline uint32_t GetGbmFormat(const EglConfigAttributes& config_attributes) {
+  if (config_attributes.red_size == 5 && config_attributes.green_size == 6 &&
+      config_attributes.blue_size == 5) {
+    return GBM_FORMAT_RGB565;
+  }
+  if (config_attributes.red_size == 10 && config_attributes.green_size == 10 &&
+      config_attributes.blue_size == 10) {
+    return config_attributes.alpha_size > 0 ? GBM_FORMAT_ARGB2101010
+                                            : GBM_FORMAT_XRGB2101010;
+  }
+  return config_attributes.alpha_size > 0 ? GBM_FORMAT_ARGB8888
+                                          : GBM_FORMAT_XRGB8888;
+}
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_GBM_FORMAT_H_
@@ -6,11 +6,31 @@
 #define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_H_
 
 #include <EGL/egl.h>
+#if defined(ENABLE_VULKAN)
+#include <vulkan/vulkan.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/shell/platform/embedder/embedder.h"
 
 namespace flutter {
 
 class NativeWindow {
  public:
+  // A buffer of the window mapped into memory, which the frames of the
+  // software renderer are copied into. The pixels are 32-bit (A|X)RGB8888.
+  struct SoftwareBuffer {
+    uint8_t* pixels = nullptr;
+    size_t stride = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+    // Number of the frame last copied into the buffer, or 0 if the contents
+    // are undefined. Maintained by SurfaceSoftware.
+    uint64_t frame_number = 0;
+  };
+
   NativeWindow() = default;
   virtual ~NativeWindow() = default;
 
@@ -18,8 +38,15 @@ class NativeWindow {
 
   EGLNativeWindowType Window() const { return window_; }
 
-  // Gets a window (GBM surface) for offscreen resource.
-  EGLNativeWindowType WindowOffscreen() const { return window_offscreen_; }
+  // Gets a window (GBM surface) for offscreen resource. It's created on first
+  // use, i.e. only when the resource context can't be made current without a
+  // surface.
+  EGLNativeWindowType WindowOffscreen() {
+    if (!window_offscreen_) {
+      window_offscreen_ = CreateWindowOffscreen();
+    }
+    return window_offscreen_;
+  }
 
   // Get physical width of the window.
   int32_t Width() const {
@@ -58,9 +85,38 @@ class NativeWindow {
   // backend. It is prepared to make the interface common.
   virtual void SwapBuffers() { /* do nothing. */ };
 
+  // Called on the raster thread before swapping frame buffers, e.g. to set the
+  // state applied with the next commit of a Wayland surface.
+  virtual void PrepareSwapBuffers() { /* do nothing. */ };
+
+  // Returns a buffer which isn't used by the display for the next frame of the
+  // software renderer, or nullptr if the window presents with EGL. Called on
+  // the raster thread, and may block until a buffer is released.
+  virtual SoftwareBuffer* AcquireSoftwareBuffer() { return nullptr; }
+
+  // Presents |buffer| returned by AcquireSoftwareBuffer(). |damage| is the
+  // region which has changed since the previous frame.
+  virtual bool PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                                     const FlutterRect& damage) {
+    return false;
+  }
+
+#if defined(ENABLE_VULKAN)
+  // Creates the surface of the window for the Vulkan renderer, or returns
+  // VK_NULL_HANDLE if |physical_device| can't present to the window.
+  virtual VkSurfaceKHR CreateVulkanSurface(VkInstance instance,
+                                           VkPhysicalDevice physical_device) {
+    return VK_NULL_HANDLE;
+  }
+#endif
+
  protected:
+  // Creates the window returned by WindowOffscreen() for the backends that
+  // don't support pbuffer surfaces.
+  virtual EGLNativeWindowType CreateWindowOffscreen() { return {}; }
+
   EGLNativeWindowType window_;
-  EGLNativeWindowType window_offscreen_;
+  EGLNativeWindowType window_offscreen_ = {};
   bool enable_vsync_;
   // Physical width of the window.
   int32_t width_;
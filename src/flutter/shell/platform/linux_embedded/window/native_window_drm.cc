@@ -8,14 +8,16 @@
 #include <unistd.h>
 #include <xf86drm.h>
 
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
 
 #include "flutter/shell/platform/linux_embedded/logger.h"
 #include "flutter/shell/platform/linux_embedded/surface/cursor_data.h"
+#include "flutter/shell/platform/linux_embedded/window/drm_connector_utils.h"
 
 namespace flutter {
 namespace {
-constexpr char kFlutterDrmConnectorEnvironmentKey[] = "FLUTTER_DRM_CONNECTOR";
 static const std::unordered_map<uint32_t, std::string> connector_names = {
     {DRM_MODE_CONNECTOR_Unknown, "Unknown"},
     {DRM_MODE_CONNECTOR_VGA, "VGA"},
@@ -42,7 +44,9 @@ static const std::unordered_map<uint32_t, std::string> connector_names = {
 
 NativeWindowDrm::NativeWindowDrm(const char* device_filename,
                                  const uint16_t rotation,
-                                 bool enable_vsync) {
+                                 bool enable_vsync,
+                                 const EglConfigAttributes& config_attributes)
+    : config_attributes_(config_attributes) {
   if (!strcmp("drm-nvdc", device_filename)) {
     drm_device_ = drmOpen(device_filename, nullptr);
   } else {
@@ -53,6 +57,18 @@ NativeWindowDrm::NativeWindowDrm(const char* device_filename,
     return;
   }
 
+  // Exposes the primary planes, which have the rotation property.
+  if (drmSetClientCap(drm_device_, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1) != 0) {
+    ELINUX_LOG(WARNING) << "Couldn't set DRM_CLIENT_CAP_UNIVERSAL_PLANES";
+  }
+
+  // The connectors after the first one mirror it.
+  auto connector_names = GetConnectorNamesFromEnvironment();
+  if (connector_names.size() > 1) {
+    mirror_connector_names_.assign(connector_names.begin() + 1,
+                                   connector_names.end());
+  }
+
   if (!ConfigureDisplay(rotation)) {
     return;
   }
@@ -79,6 +95,9 @@ bool NativeWindowDrm::MoveCursor(double x, double y) {
 }
 
 bool NativeWindowDrm::ConfigureDisplay(const uint16_t rotation) {
+  // The CRTCs available to the mirror connectors may have changed.
+  need_configure_mirror_outputs_ = true;
+
   auto resources = drmModeGetResources(drm_device_);
   if (!resources) {
     ELINUX_LOG(ERROR) << "Couldn't get resources";
@@ -121,6 +140,7 @@ bool NativeWindowDrm::ConfigureDisplay(const uint16_t rotation) {
   if (!drm_crtc_) {
     ELINUX_LOG(WARNING) << "Couldn't find a suitable crtc";
   }
+  FindPlaneRotation(resources, rotation);
 
   drmModeFreeEncoder(encoder);
   drmModeFreeConnector(connector);
@@ -129,6 +149,277 @@ bool NativeWindowDrm::ConfigureDisplay(const uint16_t rotation) {
   return true;
 }
 
+void NativeWindowDrm::FindPlaneRotation(drmModeRes* resources,
+                                        const uint16_t rotation) {
+  drm_primary_plane_id_ = 0;
+  drm_rotation_property_id_ = 0;
+  drm_plane_rotation_ = 0;
+  drm_plane_rotation_none_ = 0;
+  if (!drm_crtc_) {
+    return;
+  }
+
+  drm_primary_plane_id_ = FindPrimaryPlane(resources, drm_crtc_->crtc_id);
+  if (!drm_primary_plane_id_) {
+    return;
+  }
+  auto properties = drmModeObjectGetProperties(
+      drm_device_, drm_primary_plane_id_, DRM_MODE_OBJECT_PLANE);
+  if (!properties) {
+    return;
+  }
+
+  // The view rotation is clockwise, while DRM rotates counter-clockwise.
+  const auto rotation_name = "rotate-" + std::to_string((360 - rotation) % 360);
+  for (uint32_t i = 0; i < properties->count_props; i++) {
+    auto property = drmModeGetProperty(drm_device_, properties->props[i]);
+    if (!property) {
+      continue;
+    }
+    if (std::strcmp(property->name, "rotation") == 0) {
+      // The values of a bitmask property are bit positions.
+      for (int k = 0; k < property->count_enums; k++) {
+        const auto& item = property->enums[k];
+        if (rotation_name == item.name) {
+          drm_plane_rotation_ = 1ULL << item.value;
+        }
+        if (std::strcmp(item.name, "rotate-0") == 0) {
+          drm_plane_rotation_none_ = 1ULL << item.value;
+        }
+      }
+      drm_rotation_property_id_ = property->prop_id;
+    }
+    drmModeFreeProperty(property);
+  }
+  drmModeFreeObjectProperties(properties);
+}
+
+uint32_t NativeWindowDrm::FindPrimaryPlane(drmModeRes* resources,
+                                           uint32_t crtc_id) {
+  int crtc_index = -1;
+  for (int i = 0; i < resources->count_crtcs; i++) {
+    if (resources->crtcs[i] == crtc_id) {
+      crtc_index = i;
+      break;
+    }
+  }
+  if (crtc_index == -1) {
+    return 0;
+  }
+  auto plane_resources = drmModeGetPlaneResources(drm_device_);
+  if (!plane_resources) {
+    return 0;
+  }
+
+  uint32_t primary_plane_id = 0;
+  for (uint32_t i = 0; i < plane_resources->count_planes && !primary_plane_id;
+       i++) {
+    auto plane_id = plane_resources->planes[i];
+    auto plane = drmModeGetPlane(drm_device_, plane_id);
+    if (!plane) {
+      continue;
+    }
+    const bool usable = plane->possible_crtcs & (1 << crtc_index);
+    drmModeFreePlane(plane);
+    if (!usable) {
+      continue;
+    }
+
+    auto properties = drmModeObjectGetProperties(drm_device_, plane_id,
+                                                 DRM_MODE_OBJECT_PLANE);
+    if (!properties) {
+      continue;
+    }
+    for (uint32_t j = 0; j < properties->count_props; j++) {
+      auto property = drmModeGetProperty(drm_device_, properties->props[j]);
+      if (!property) {
+        continue;
+      }
+      if (std::strcmp(property->name, "type") == 0 &&
+          properties->prop_values[j] == DRM_PLANE_TYPE_PRIMARY) {
+        primary_plane_id = plane_id;
+      }
+      drmModeFreeProperty(property);
+    }
+    drmModeFreeObjectProperties(properties);
+  }
+  drmModeFreePlaneResources(plane_resources);
+  return primary_plane_id;
+}
+
+bool NativeWindowDrm::EnablePlaneRotation() {
+  rotation_offloaded_ = false;
+  if (!drm_rotation_property_id_ || !drm_plane_rotation_ || !drm_crtc_) {
+    return false;
+  }
+  // The mirror connectors scan out the same framebuffers, which must be
+  // rotated when rendering.
+  if (!mirror_connector_names_.empty()) {
+    return false;
+  }
+
+  if (drmModeObjectSetProperty(drm_device_, drm_primary_plane_id_,
+                               DRM_MODE_OBJECT_PLANE, drm_rotation_property_id_,
+                               drm_plane_rotation_) != 0) {
+    // The framebuffer currently scanned out may not fit the rotated plane.
+    // Turn off the CRTC, which is set again with the first frame.
+    drmModeSetCrtc(drm_device_, drm_crtc_->crtc_id, 0, 0, 0, nullptr, 0,
+                   nullptr);
+    if (drmModeObjectSetProperty(
+            drm_device_, drm_primary_plane_id_, DRM_MODE_OBJECT_PLANE,
+            drm_rotation_property_id_, drm_plane_rotation_) != 0) {
+      return false;
+    }
+  }
+  rotation_offloaded_ = true;
+  return true;
+}
+
+void NativeWindowDrm::DisablePlaneRotation() {
+  if (!rotation_offloaded_ || !drm_plane_rotation_none_) {
+    return;
+  }
+
+  // Our framebuffer doesn't fit the plane without the rotation.
+  drmModeSetCrtc(drm_device_, drm_crtc_->crtc_id, 0, 0, 0, nullptr, 0,
+                 nullptr);
+  drmModeObjectSetProperty(drm_device_, drm_primary_plane_id_,
+                           DRM_MODE_OBJECT_PLANE, drm_rotation_property_id_,
+                           drm_plane_rotation_none_);
+  rotation_offloaded_ = false;
+}
+
+void NativeWindowDrm::ScanOutMirrorOutputs(uint32_t fb,
+                                           uint32_t width,
+                                           uint32_t height) {
+  if (need_configure_mirror_outputs_.exchange(false)) {
+    RestoreMirrorOutputs();
+    ConfigureMirrorOutputs();
+  }
+
+  for (auto& output : mirror_outputs_) {
+    const bool scaled = output.scaling_supported &&
+                        (output.mode.hdisplay != width ||
+                         output.mode.vdisplay != height);
+    // The plane is scaled once the CRTC is on. Otherwise the frames are
+    // cropped to the mode.
+    if (!output.active || !scaled) {
+      auto result =
+          drmModeSetCrtc(drm_device_, output.crtc->crtc_id, fb, 0, 0,
+                         &output.connector_id, 1, &output.mode);
+      if (result != 0) {
+        ELINUX_LOG(ERROR) << "Failed to set the crtc of a mirror connector. ("
+                          << result << ")";
+        continue;
+      }
+      output.active = true;
+    }
+    if (scaled &&
+        drmModeSetPlane(drm_device_, output.primary_plane_id,
+                        output.crtc->crtc_id, fb, 0, 0, 0,
+                        output.mode.hdisplay, output.mode.vdisplay, 0, 0,
+                        width << 16, height << 16) != 0) {
+      ELINUX_LOG(WARNING) << "The primary plane of a mirror connector can't "
+                             "scale the frames. They're cropped.";
+      output.scaling_supported = false;
+    }
+  }
+}
+
+void NativeWindowDrm::RestoreMirrorOutputs() {
+  for (auto& output : mirror_outputs_) {
+    auto* crtc = output.crtc;
+    if (output.active) {
+      if (crtc->mode_valid) {
+        drmModeSetCrtc(drm_device_, crtc->crtc_id, crtc->buffer_id, crtc->x,
+                       crtc->y, &output.connector_id, 1, &crtc->mode);
+      } else {
+        drmModeSetCrtc(drm_device_, crtc->crtc_id, 0, 0, 0, nullptr, 0,
+                       nullptr);
+      }
+    }
+    drmModeFreeCrtc(output.crtc);
+  }
+  mirror_outputs_.clear();
+}
+
+void NativeWindowDrm::ConfigureMirrorOutputs() {
+  if (mirror_connector_names_.empty() || !drm_crtc_) {
+    return;
+  }
+  auto resources = drmModeGetResources(drm_device_);
+  if (!resources) {
+    ELINUX_LOG(ERROR) << "Couldn't get resources";
+    return;
+  }
+
+  std::vector<uint32_t> used_crtcs = {drm_crtc_->crtc_id};
+  for (const auto& name : mirror_connector_names_) {
+    auto connector = GetConnectorByName(resources, name.c_str());
+    if (!connector || connector->connection != DRM_MODE_CONNECTED ||
+        connector->count_modes == 0) {
+      ELINUX_LOG(WARNING) << "Connector " << name
+                          << " is not connected. It doesn't mirror the view.";
+      if (connector) {
+        drmModeFreeConnector(connector);
+      }
+      continue;
+    }
+
+    auto crtc_id = FindUnusedCrtc(resources, connector, used_crtcs);
+    auto crtc = crtc_id ? drmModeGetCrtc(drm_device_, crtc_id) : nullptr;
+    if (!crtc) {
+      ELINUX_LOG(WARNING) << "Couldn't find a free crtc for connector " << name
+                          << ". It doesn't mirror the view.";
+      drmModeFreeConnector(connector);
+      continue;
+    }
+    used_crtcs.push_back(crtc_id);
+
+    std::vector<DrmModeSize> modes;
+    for (int i = 0; i < connector->count_modes; i++) {
+      modes.push_back({connector->modes[i].hdisplay,
+                       connector->modes[i].vdisplay});
+    }
+    const auto* mode = &connector->modes[SelectMirrorMode(
+        modes, BufferWidth(), BufferHeight())];
+    MirrorOutput output;
+    output.connector_id = connector->connector_id;
+    output.mode = *mode;
+    output.crtc = crtc;
+    output.primary_plane_id = FindPrimaryPlane(resources, crtc_id);
+    output.scaling_supported = output.primary_plane_id != 0;
+    mirror_outputs_.push_back(output);
+    ELINUX_LOG(INFO) << "Mirroring to " << name << ": " << mode->hdisplay
+                     << "x" << mode->vdisplay;
+    drmModeFreeConnector(connector);
+  }
+  drmModeFreeResources(resources);
+}
+
+uint32_t NativeWindowDrm::FindUnusedCrtc(
+    drmModeRes* resources,
+    drmModeConnector* connector,
+    const std::vector<uint32_t>& used_crtcs) {
+  for (int e = 0; e < connector->count_encoders; e++) {
+    auto encoder = drmModeGetEncoder(drm_device_, connector->encoders[e]);
+    if (!encoder) {
+      continue;
+    }
+    const auto possible_crtcs = encoder->possible_crtcs;
+    drmModeFreeEncoder(encoder);
+    for (int c = 0; c < resources->count_crtcs; c++) {
+      const auto crtc_id = resources->crtcs[c];
+      if ((possible_crtcs & (1 << c)) &&
+          std::find(used_crtcs.begin(), used_crtcs.end(), crtc_id) ==
+              used_crtcs.end()) {
+        return crtc_id;
+      }
+    }
+  }
+  return 0;
+}
+
 std::string NativeWindowDrm::GetConnectorName(uint32_t connector_type,
                                               uint32_t connector_type_id) {
   auto it = connector_names.find(connector_type);
@@ -155,8 +446,9 @@ drmModeConnectorPtr NativeWindowDrm::GetConnectorByName(
 }
 
 drmModeConnectorPtr NativeWindowDrm::FindConnector(drmModeResPtr resources) {
-  auto connector_name = std::getenv(kFlutterDrmConnectorEnvironmentKey);
-  if (connector_name && connector_name[0] != '\0') {
+  auto connector_names = GetConnectorNamesFromEnvironment();
+  if (!connector_names.empty()) {
+    const auto* connector_name = connector_names[0].c_str();
     auto connector = GetConnectorByName(resources, connector_name);
     if (!connector) {
       ELINUX_LOG(ERROR) << "Couldn't find connector with name "
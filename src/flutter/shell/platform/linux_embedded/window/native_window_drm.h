@@ -7,9 +7,11 @@
 
 #include <xf86drmMode.h>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "flutter/shell/platform/linux_embedded/surface/surface_gl.h"
 #include "flutter/shell/platform/linux_embedded/window/native_window.h"
@@ -20,11 +22,16 @@ class NativeWindowDrm : public NativeWindow {
  public:
   NativeWindowDrm(const char* device_filename,
                   const uint16_t rotation,
-                  bool enable_vsync);
+                  bool enable_vsync,
+                  const EglConfigAttributes& config_attributes);
   virtual ~NativeWindowDrm();
 
   bool ConfigureDisplay(const uint16_t rotation);
 
+  // Returns true if the primary plane rotates the frames, i.e. they are
+  // rendered without the rotation.
+  bool IsRotationOffloaded() const { return rotation_offloaded_; }
+
   bool MoveCursor(double x, double y);
 
   virtual bool ShowCursor(double x, double y) = 0;
@@ -48,16 +55,88 @@ class NativeWindowDrm : public NativeWindow {
   drmModeEncoder* FindEncoder(drmModeRes* resources,
                               drmModeConnector* connector);
 
+  // Returns the primary plane of |crtc_id|, or 0 if not found.
+  uint32_t FindPrimaryPlane(drmModeRes* resources, uint32_t crtc_id);
+
+  // Finds the "rotation" property of the primary plane of the CRTC and its
+  // values for |rotation| and for no rotation.
+  void FindPlaneRotation(drmModeRes* resources, const uint16_t rotation);
+
+  // Lets the primary plane rotate the frames if supported. The CRTC may be
+  // turned off until the next modeset. Returns false if not supported.
+  bool EnablePlaneRotation();
+
+  // Resets the rotation of the primary plane, e.g. to restore the CRTC.
+  void DisablePlaneRotation();
+
+  // Size of the buffers to scan out. They have the size of the window when the
+  // plane rotates them, or the size of the mode otherwise.
+  uint32_t BufferWidth() const {
+    return rotation_offloaded_ ? width_ : drm_mode_info_.hdisplay;
+  }
+  uint32_t BufferHeight() const {
+    return rotation_offloaded_ ? height_ : drm_mode_info_.vdisplay;
+  }
+
+  // Scans out |fb| of |width|x|height| on the connectors mirroring the main
+  // one. Called after |fb| is set to the main CRTC, on the raster thread.
+  void ScanOutMirrorOutputs(uint32_t fb, uint32_t width, uint32_t height);
+
+  // Restores the CRTCs of the mirror connectors, e.g. before the framebuffers
+  // they scan out are removed. They're configured again with the next frame.
+  void RestoreMirrorOutputs();
+
   // Convert Flutter's cursor value to cursor data.
   const uint32_t* GetCursorData(const std::string& cursor_name);
 
+  // EGL config of the render surface.
+  EglConfigAttributes config_attributes_;
+
   int drm_device_;
   uint32_t drm_connector_id_;
   drmModeCrtc* drm_crtc_ = nullptr;
   drmModeModeInfo drm_mode_info_;
 
+  uint32_t drm_primary_plane_id_ = 0;
+  uint32_t drm_rotation_property_id_ = 0;
+  // Values of the "rotation" property, or 0 if not supported.
+  uint64_t drm_plane_rotation_ = 0;
+  uint64_t drm_plane_rotation_none_ = 0;
+  bool rotation_offloaded_ = false;
+
+  // Connectors listed after the main one in FLUTTER_DRM_CONNECTOR.
+  std::vector<std::string> mirror_connector_names_;
+  // Set when the mirror connectors need to be (re)configured, e.g. after
+  // hotplug.
+  std::atomic<bool> need_configure_mirror_outputs_ = true;
+
   std::string cursor_name_ = "";
   std::pair<int32_t, int32_t> cursor_hotspot_ = {0, 0};
+
+ private:
+  // A connector which shows the same frames as the main connector.
+  struct MirrorOutput {
+    uint32_t connector_id;
+    drmModeModeInfo mode;
+    // CRTC driving the connector, with its state to restore.
+    drmModeCrtc* crtc;
+    uint32_t primary_plane_id;
+    // True once the CRTC has been set with our framebuffers.
+    bool active = false;
+    // False if the primary plane can't scale the frames to |mode|.
+    bool scaling_supported = true;
+  };
+
+  // Assigns the mirror connectors the CRTCs not used by the other connectors.
+  void ConfigureMirrorOutputs();
+
+  // Returns a CRTC which can drive |connector| and isn't in |used_crtcs|, or
+  // 0 if not found.
+  uint32_t FindUnusedCrtc(drmModeRes* resources,
+                          drmModeConnector* connector,
+                          const std::vector<uint32_t>& used_crtcs);
+
+  std::vector<MirrorOutput> mirror_outputs_;
 };
 
 }  // namespace flutter
@@ -0,0 +1,362 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_drm_dumb.h"
+
+#include <drm_fourcc.h>
+#include <poll.h>
+#include <sys/mman.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/cursor_data.h"
+
+namespace flutter {
+
+namespace {
+constexpr char kCursorNameNone[] = "none";
+
+// Buffer size for cursor image. The size must be at least 64x64 due to the
+// restrictions of drmModeSetCursor API.
+constexpr uint32_t kCursorBufferWidth = 64;
+constexpr uint32_t kCursorBufferHeight = 64;
+
+constexpr uint32_t kBitsPerPixel = 32;
+
+// Gives up waiting for a page flip, e.g. when the display has been turned
+// off, after this timeout.
+constexpr int kPageFlipTimeoutMs = 1000;
+}  // namespace
+
+NativeWindowDrmDumb::NativeWindowDrmDumb(
+    const char* device_filename,
+    const uint16_t rotation,
+    bool enable_vsync,
+    const EglConfigAttributes& config_attributes)
+    : NativeWindowDrm(device_filename, rotation, enable_vsync,
+                      config_attributes) {
+  if (!valid_) {
+    return;
+  }
+
+  if (!drmIsMaster(drm_device_)) {
+    ELINUX_LOG(ERROR)
+        << "Couldn't become the DRM master. Please confirm if another display "
+           "backend such as X11 and Wayland is not running.";
+    valid_ = false;
+    return;
+  }
+
+  uint64_t has_dumb = 0;
+  if (drmGetCap(drm_device_, DRM_CAP_DUMB_BUFFER, &has_dumb) != 0 ||
+      !has_dumb) {
+    ELINUX_LOG(ERROR) << "The DRM device doesn't support dumb buffers.";
+    valid_ = false;
+    return;
+  }
+
+  // The software renderer can't rotate the frames.
+  if (rotation != 0 && !EnablePlaneRotation()) {
+    ELINUX_LOG(WARNING) << "The primary plane can't rotate the frames. The "
+                           "view rotation is ignored.";
+    ConfigureDisplay(0);
+  }
+
+  if (!CreateFrameBuffers()) {
+    valid_ = false;
+  }
+}
+
+NativeWindowDrmDumb::~NativeWindowDrmDumb() {
+  if (drm_device_ == -1) {
+    return;
+  }
+
+  if (drm_crtc_) {
+    WaitForPageFlip();
+    DisablePlaneRotation();
+    drmModeSetCrtc(drm_device_, drm_crtc_->crtc_id, drm_crtc_->buffer_id,
+                   drm_crtc_->x, drm_crtc_->y, &drm_connector_id_, 1,
+                   &drm_crtc_->mode);
+    // Our framebuffers are no longer scanned out.
+    scanout_fb_ = 0;
+  }
+
+  DestroyFrameBuffers();
+  DestroyDumbBuffer(cursor_buffer_);
+
+  if (drm_crtc_) {
+    drmModeFreeCrtc(drm_crtc_);
+  }
+}
+
+bool NativeWindowDrmDumb::ShowCursor(double x, double y) {
+  if (!cursor_buffer_.handle && !CreateCursorBuffer(cursor_name_)) {
+    return false;
+  }
+
+  MoveCursor(x, y);
+  auto result =
+      drmModeSetCursor(drm_device_, drm_crtc_->crtc_id, cursor_buffer_.handle,
+                       kCursorBufferWidth, kCursorBufferHeight);
+  if (result != 0) {
+    ELINUX_LOG(ERROR) << "Failed to set cursor buffer. (" << result << ")";
+    return false;
+  }
+  return true;
+}
+
+bool NativeWindowDrmDumb::UpdateCursor(const std::string& cursor_name,
+                                       double x,
+                                       double y) {
+  if (cursor_name.compare(cursor_name_) == 0) {
+    return true;
+  }
+  cursor_name_ = cursor_name;
+
+  if (cursor_name.compare(kCursorNameNone) == 0) {
+    return DismissCursor();
+  }
+
+  if (!CreateCursorBuffer(cursor_name)) {
+    return false;
+  }
+
+  MoveCursor(x, y);
+  auto result =
+      drmModeSetCursor(drm_device_, drm_crtc_->crtc_id, cursor_buffer_.handle,
+                       kCursorBufferWidth, kCursorBufferHeight);
+  if (result != 0) {
+    ELINUX_LOG(ERROR) << "Failed to set cursor buffer. (" << result << ")";
+    return false;
+  }
+  return true;
+}
+
+bool NativeWindowDrmDumb::DismissCursor() {
+  auto result = drmModeSetCursor(drm_device_, drm_crtc_->crtc_id, 0, 0, 0);
+  if (result != 0) {
+    ELINUX_LOG(ERROR) << "Failed to set cursor buffer. (" << result << ")";
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<SurfaceGl> NativeWindowDrmDumb::CreateRenderSurface(
+    bool enable_impeller) {
+  // The frames are presented by SurfaceSoftware.
+  return nullptr;
+}
+
+bool NativeWindowDrmDumb::Resize(const size_t width, const size_t height) {
+  if (!valid_) {
+    ELINUX_LOG(ERROR) << "Failed to resize the window.";
+    return false;
+  }
+
+  if (IsRotationOffloaded() && !EnablePlaneRotation()) {
+    ELINUX_LOG(WARNING) << "The new CRTC can't rotate the frames.";
+  }
+
+  // The buffers always have the size of the buffers to scan out, so they only
+  // need to be reallocated when the display mode has changed.
+  if (buffers_[0].buffer.width != static_cast<int32_t>(BufferWidth()) ||
+      buffers_[0].buffer.height != static_cast<int32_t>(BufferHeight())) {
+    ELINUX_LOG(INFO) << "resize: " << width << "x" << height;
+    need_recreate_buffers_ = true;
+  }
+  return true;
+}
+
+NativeWindow::SoftwareBuffer* NativeWindowDrmDumb::AcquireSoftwareBuffer() {
+  // The back buffer is scanned out until the flip away from it completes.
+  WaitForPageFlip();
+  if (need_recreate_buffers_.exchange(false)) {
+    DestroyFrameBuffers();
+    if (!CreateFrameBuffers()) {
+      return nullptr;
+    }
+  }
+  if (!buffers_[back_buffer_].buffer.pixels) {
+    return nullptr;
+  }
+  return &buffers_[back_buffer_].buffer;
+}
+
+bool NativeWindowDrmDumb::PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                                                const FlutterRect& damage) {
+  auto& dumb_buffer = buffers_[back_buffer_];
+  if (!drm_crtc_) {
+    ELINUX_LOG(ERROR) << "crtc is null, cannot set mode.";
+    return false;
+  }
+
+  if (damage.bottom <= damage.top && scanout_fb_) {
+    // Nothing has changed. Keep scanning out the front buffer.
+    return true;
+  }
+
+  // Only the first frame needs a modeset. The following ones are flipped to,
+  // unless the driver can't flip.
+  WaitForPageFlip();
+  if (scanout_fb_ &&
+      drmModePageFlip(drm_device_, drm_crtc_->crtc_id, dumb_buffer.fb,
+                      DRM_MODE_PAGE_FLIP_EVENT, this) == 0) {
+    page_flip_pending_ = true;
+  } else {
+    auto result =
+        drmModeSetCrtc(drm_device_, drm_crtc_->crtc_id, dumb_buffer.fb, 0, 0,
+                       &drm_connector_id_, 1, &drm_mode_info_);
+    if (result != 0) {
+      ELINUX_LOG(ERROR) << "Failed to set crct mode. (" << result << ")";
+      return false;
+    }
+  }
+  scanout_fb_ = dumb_buffer.fb;
+  ScanOutMirrorOutputs(dumb_buffer.fb, dumb_buffer.buffer.width,
+                       dumb_buffer.buffer.height);
+
+  // Some drivers only update the display for the dirty regions. Not
+  // supported (-ENOSYS) by the drivers which scan out continuously.
+  drmModeClip clip;
+  clip.x1 = static_cast<uint16_t>(damage.left);
+  clip.y1 = static_cast<uint16_t>(damage.top);
+  clip.x2 = static_cast<uint16_t>(damage.right);
+  clip.y2 = static_cast<uint16_t>(damage.bottom);
+  drmModeDirtyFB(drm_device_, dumb_buffer.fb, &clip, 1);
+
+  back_buffer_ = (back_buffer_ + 1) % buffers_.size();
+  return true;
+}
+
+bool NativeWindowDrmDumb::CreateDumbBuffer(DumbBuffer& buffer,
+                                           uint32_t width,
+                                           uint32_t height) {
+  uint32_t stride;
+  uint64_t size;
+  if (drmModeCreateDumbBuffer(drm_device_, width, height, kBitsPerPixel, 0,
+                              &buffer.handle, &stride, &size) != 0) {
+    ELINUX_LOG(ERROR) << "Failed to create a dumb buffer.";
+    return false;
+  }
+
+  uint64_t offset;
+  if (drmModeMapDumbBuffer(drm_device_, buffer.handle, &offset) != 0) {
+    ELINUX_LOG(ERROR) << "Failed to map a dumb buffer.";
+    DestroyDumbBuffer(buffer);
+    return false;
+  }
+  auto* pixels = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      drm_device_, offset);
+  if (pixels == MAP_FAILED) {
+    ELINUX_LOG(ERROR) << "Failed to mmap a dumb buffer.";
+    DestroyDumbBuffer(buffer);
+    return false;
+  }
+  std::memset(pixels, 0, size);
+
+  buffer.size = size;
+  buffer.buffer.pixels = static_cast<uint8_t*>(pixels);
+  buffer.buffer.stride = stride;
+  buffer.buffer.width = width;
+  buffer.buffer.height = height;
+  buffer.buffer.frame_number = 0;
+  return true;
+}
+
+void NativeWindowDrmDumb::DestroyDumbBuffer(DumbBuffer& buffer) {
+  if (buffer.fb) {
+    drmModeRmFB(drm_device_, buffer.fb);
+  }
+  if (buffer.buffer.pixels) {
+    munmap(buffer.buffer.pixels, buffer.size);
+  }
+  if (buffer.handle) {
+    drmModeDestroyDumbBuffer(drm_device_, buffer.handle);
+  }
+  buffer = DumbBuffer();
+}
+
+bool NativeWindowDrmDumb::CreateFrameBuffers() {
+  for (auto& buffer : buffers_) {
+    if (!CreateDumbBuffer(buffer, BufferWidth(), BufferHeight())) {
+      DestroyFrameBuffers();
+      return false;
+    }
+
+    // Flutter renders kN32_SkColorType, i.e. BGRA in memory on little-endian
+    // devices.
+    const uint32_t handles[4] = {buffer.handle};
+    const uint32_t strides[4] = {static_cast<uint32_t>(buffer.buffer.stride)};
+    const uint32_t offsets[4] = {0};
+    auto result = drmModeAddFB2(drm_device_, BufferWidth(), BufferHeight(),
+                                DRM_FORMAT_XRGB8888, handles, strides, offsets,
+                                &buffer.fb, 0);
+    if (result != 0) {
+      ELINUX_LOG(ERROR) << "Failed to add a framebuffer. (" << result << ")";
+      DestroyFrameBuffers();
+      return false;
+    }
+  }
+  back_buffer_ = 0;
+  return true;
+}
+
+void NativeWindowDrmDumb::DestroyFrameBuffers() {
+  WaitForPageFlip();
+  RestoreMirrorOutputs();
+  need_configure_mirror_outputs_ = true;
+  if (scanout_fb_ && drm_crtc_) {
+    // The framebuffer can't be removed while it's scanned out.
+    drmModeSetCrtc(drm_device_, drm_crtc_->crtc_id, 0, 0, 0, nullptr, 0,
+                   nullptr);
+  }
+  scanout_fb_ = 0;
+  for (auto& buffer : buffers_) {
+    DestroyDumbBuffer(buffer);
+  }
+}
+
+bool NativeWindowDrmDumb::CreateCursorBuffer(const std::string& cursor_name) {
+  if (!cursor_buffer_.handle &&
+      !CreateDumbBuffer(cursor_buffer_, kCursorBufferWidth,
+                        kCursorBufferHeight)) {
+    ELINUX_LOG(ERROR) << "Failed to create cursor buffer";
+    return false;
+  }
+
+  auto cursor_data = GetCursorData(cursor_name);
+  auto* pixels = cursor_buffer_.buffer.pixels;
+  std::memset(pixels, 0, cursor_buffer_.size);
+  for (int i = 0; i < kCursorHeight; i++) {
+    memcpy(pixels + i * cursor_buffer_.buffer.stride,
+           cursor_data + i * kCursorWidth, kCursorWidth * sizeof(uint32_t));
+  }
+  return true;
+}
+
+void NativeWindowDrmDumb::WaitForPageFlip() {
+  drmEventContext context = {};
+  context.version = DRM_EVENT_CONTEXT_VERSION;
+  context.page_flip_handler = [](int fd, unsigned int frame, unsigned int sec,
+                                 unsigned int usec, void* data) {
+    static_cast<NativeWindowDrmDumb*>(data)->page_flip_pending_ = false;
+  };
+
+  while (page_flip_pending_) {
+    pollfd fd = {drm_device_, POLLIN, 0};
+    const auto result = poll(&fd, 1, kPageFlipTimeoutMs);
+    if (result == -1 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0 || drmHandleEvent(drm_device_, &context) != 0) {
+      ELINUX_LOG(WARNING) << "Failed to wait for the page flip.";
+      page_flip_pending_ = false;
+    }
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,100 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_DRM_DUMB_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_DRM_DUMB_H_
+
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+
+#include <array>
+#include <atomic>
+#include <string>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_drm.h"
+
+namespace flutter {
+
+// A DRM window for the software renderer, which scans out dumb buffers (i.e.
+// buffers mapped into memory) and doesn't need a GPU.
+//
+// The frames are copied into two buffers in turn. Only the region which has
+// changed is copied, and reported to the driver with drmModeDirtyFB() for the
+// displays which need to be flushed explicitly (e.g. SPI and USB displays).
+//
+// The first frame sets the mode of the CRTC. The following ones are flipped
+// to at the next v-blank with drmModePageFlip(), and the buffer flipped away
+// from isn't reused until the flip has completed.
+class NativeWindowDrmDumb : public NativeWindowDrm {
+ public:
+  NativeWindowDrmDumb(const char* device_filename,
+                      const uint16_t rotation,
+                      bool enable_vsync,
+                      const EglConfigAttributes& config_attributes);
+  ~NativeWindowDrmDumb();
+
+  // |NativeWindowDrm|
+  bool ShowCursor(double x, double y) override;
+
+  // |NativeWindowDrm|
+  bool UpdateCursor(const std::string& cursor_name,
+                    double x,
+                    double y) override;
+
+  // |NativeWindowDrm|
+  bool DismissCursor() override;
+
+  // |NativeWindowDrm|
+  std::unique_ptr<SurfaceGl> CreateRenderSurface(bool enable_impeller) override;
+
+  // |NativeWindow|
+  bool Resize(const size_t width, const size_t height) override;
+
+  // |NativeWindow|
+  SoftwareBuffer* AcquireSoftwareBuffer() override;
+
+  // |NativeWindow|
+  bool PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                             const FlutterRect& damage) override;
+
+ private:
+  struct DumbBuffer {
+    SoftwareBuffer buffer;
+    uint32_t handle = 0;
+    uint32_t fb = 0;
+    size_t size = 0;
+  };
+
+  bool CreateDumbBuffer(DumbBuffer& buffer, uint32_t width, uint32_t height);
+
+  void DestroyDumbBuffer(DumbBuffer& buffer);
+
+  bool CreateFrameBuffers();
+
+  void DestroyFrameBuffers();
+
+  bool CreateCursorBuffer(const std::string& cursor_name);
+
+  // Blocks until the pending page flip, if any, has completed.
+  void WaitForPageFlip();
+
+  std::array<DumbBuffer, 2> buffers_;
+  size_t back_buffer_ = 0;
+
+  // Framebuffer currently set to the CRTC, or 0 before the first frame.
+  uint32_t scanout_fb_ = 0;
+
+  // Set while waiting for the event of the page flip to |scanout_fb_|.
+  bool page_flip_pending_ = false;
+
+  // Set by Resize() when the display mode has changed. The buffers are
+  // reallocated on the raster thread before the next frame.
+  std::atomic<bool> need_recreate_buffers_ = false;
+
+  DumbBuffer cursor_buffer_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_DRM_DUMB_H_
@@ -18,15 +18,24 @@ namespace {
 constexpr char kCursorNameNone[] = "none";
 }  // namespace
 
-NativeWindowDrmEglstream::NativeWindowDrmEglstream(const char* device_filename,
-                                                   const uint16_t rotation,
-                                                   bool enable_vsync)
-    : NativeWindowDrm(device_filename, rotation, enable_vsync) {
+NativeWindowDrmEglstream::NativeWindowDrmEglstream(
+    const char* device_filename,
+    const uint16_t rotation,
+    bool enable_vsync,
+    const EglConfigAttributes& config_attributes)
+    : NativeWindowDrm(device_filename, rotation, enable_vsync,
+                      config_attributes) {
   if (!valid_) {
     return;
   }
 
   enable_vsync_ = enable_vsync;
+
+  // Saves rotating the whole frame on the GPU.
+  if (rotation != 0 && !EnablePlaneRotation()) {
+    ELINUX_LOG(INFO) << "The primary plane can't rotate the frames. They are "
+                        "rotated when rendering.";
+  }
   valid_ = ConfigureDisplayAdditional();
 
   // drmIsMaster() is a relatively new API, and the main target of EGLStream is
@@ -45,6 +54,7 @@ NativeWindowDrmEglstream::~NativeWindowDrmEglstream() {
   }
 
   if (drm_crtc_) {
+    DisablePlaneRotation();
     drmModeSetCrtc(drm_device_, drm_crtc_->crtc_id, drm_crtc_->buffer_id,
                    drm_crtc_->x, drm_crtc_->y, &drm_connector_id_, 1,
                    &drm_crtc_->mode);
@@ -96,7 +106,7 @@ bool NativeWindowDrmEglstream::DismissCursor() {
 std::unique_ptr<SurfaceGl> NativeWindowDrmEglstream::CreateRenderSurface(
     bool enable_impeller) {
   return std::make_unique<SurfaceGl>(std::make_unique<ContextEglStream>(
-      std::make_unique<EnvironmentEglStream>()));
+      std::make_unique<EnvironmentEglStream>(), config_attributes_));
 }
 
 bool NativeWindowDrmEglstream::ConfigureDisplayAdditional() {
@@ -221,8 +231,8 @@ bool NativeWindowDrmEglstream::AssignAtomicRequest(drmModeAtomicReqPtr atomic) {
   NativeWindowDrmEglstream::DrmProperty plane_table[] = {
       {"SRC_X", 0},
       {"SRC_Y", 0},
-      {"SRC_W", static_cast<uint64_t>(drm_mode_info_.hdisplay << 16)},
-      {"SRC_H", static_cast<uint64_t>(drm_mode_info_.vdisplay << 16)},
+      {"SRC_W", static_cast<uint64_t>(BufferWidth()) << 16},
+      {"SRC_H", static_cast<uint64_t>(BufferHeight()) << 16},
       {"CRTC_X", 0},
       {"CRTC_Y", 0},
       {"CRTC_W", static_cast<uint64_t>(drm_mode_info_.hdisplay)},
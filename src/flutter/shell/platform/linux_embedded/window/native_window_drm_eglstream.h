@@ -18,7 +18,8 @@ class NativeWindowDrmEglstream : public NativeWindowDrm {
  public:
   NativeWindowDrmEglstream(const char* device_filename,
                            const uint16_t rotation,
-                           bool enable_vsync);
+                           bool enable_vsync,
+                           const EglConfigAttributes& config_attributes);
   ~NativeWindowDrmEglstream();
 
   // |NativeWindowDrm|
@@ -7,6 +7,7 @@
 #include "flutter/shell/platform/linux_embedded/logger.h"
 #include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
 #include "flutter/shell/platform/linux_embedded/surface/cursor_data.h"
+#include "flutter/shell/platform/linux_embedded/window/gbm_format.h"
 
 namespace flutter {
 
@@ -19,10 +20,13 @@ constexpr uint32_t kCursorBufferWidth = 64;
 constexpr uint32_t kCursorBufferHeight = 64;
 }  // namespace
 
-NativeWindowDrmGbm::NativeWindowDrmGbm(const char* device_filename,
-                                       const uint16_t rotation,
-                                       bool enable_vsync)
-    : NativeWindowDrm(device_filename, rotation, enable_vsync) {
+NativeWindowDrmGbm::NativeWindowDrmGbm(
+    const char* device_filename,
+    const uint16_t rotation,
+    bool enable_vsync,
+    const EglConfigAttributes& config_attributes)
+    : NativeWindowDrm(device_filename, rotation, enable_vsync,
+                      config_attributes) {
   if (!valid_) {
     return;
   }
@@ -43,6 +47,12 @@ NativeWindowDrmGbm::NativeWindowDrmGbm(const char* device_filename,
     return;
   }
 
+  // Saves rotating the whole frame on the GPU.
+  if (rotation != 0 && !EnablePlaneRotation()) {
+    ELINUX_LOG(INFO) << "The primary plane can't rotate the frames. They are "
+                        "rotated when rendering.";
+  }
+
   CreateGbmSurface();
 }
 
@@ -56,7 +66,9 @@ NativeWindowDrmGbm::~NativeWindowDrmGbm() {
     gbm_cursor_bo_ = nullptr;
   }
 
+  RestoreMirrorOutputs();
   if (drm_crtc_) {
+    DisablePlaneRotation();
     drmModeSetCrtc(drm_device_, drm_crtc_->crtc_id, drm_crtc_->buffer_id,
                    drm_crtc_->x, drm_crtc_->y, &drm_connector_id_, 1,
                    &drm_crtc_->mode);
@@ -69,7 +81,9 @@ NativeWindowDrmGbm::~NativeWindowDrmGbm() {
                                gbm_previous_bo_);
     gbm_surface_destroy(static_cast<gbm_surface*>(window_));
     window_ = nullptr;
+  }
 
+  if (window_offscreen_) {
     gbm_surface_destroy(static_cast<gbm_surface*>(window_offscreen_));
     window_offscreen_ = nullptr;
   }
@@ -133,12 +147,16 @@ bool NativeWindowDrmGbm::DismissCursor() {
 
 std::unique_ptr<SurfaceGl> NativeWindowDrmGbm::CreateRenderSurface(
     bool enable_impeller) {
+  // The EGL config must render to the format of the GBM surface.
+  auto config_attributes = config_attributes_;
+  config_attributes.native_visual_id = format_;
   return std::make_unique<SurfaceGl>(std::make_unique<ContextEgl>(
-      std::make_unique<EnvironmentEgl>(gbm_device_), enable_impeller));
+      std::make_unique<EnvironmentEgl>(gbm_device_), enable_impeller,
+      EGL_WINDOW_BIT, config_attributes));
 }
 
 bool NativeWindowDrmGbm::IsNeedRecreateSurfaceAfterResize() const {
-  return true;
+  return need_recreate_surface_;
 }
 
 bool NativeWindowDrmGbm::Resize(const size_t width, const size_t height) {
@@ -153,7 +171,23 @@ bool NativeWindowDrmGbm::Resize(const size_t width, const size_t height) {
     return false;
   }
 
+  if (IsRotationOffloaded()) {
+    // The CRTC may have changed. Falls back to rotating when rendering if the
+    // new one can't rotate the frames.
+    EnablePlaneRotation();
+  }
+
+  // The GBM surface always has the size of the buffers to scan out, so it only
+  // needs to be reallocated when the display mode has changed.
+  need_recreate_surface_ = surface_width_ != BufferWidth() ||
+                           surface_height_ != BufferHeight();
+  if (!need_recreate_surface_) {
+    return true;
+  }
+
   ELINUX_LOG(INFO) << "resize: " << width << "x" << height;
+  // The mirror connectors are turned off with the framebuffer they scan out.
+  need_configure_mirror_outputs_ = true;
   drmModeRmFB(drm_device_, gbm_previous_fb_);
   gbm_surface_release_buffer(static_cast<gbm_surface*>(window_),
                              gbm_previous_bo_);
@@ -172,9 +206,12 @@ void NativeWindowDrmGbm::SwapBuffers() {
   auto height = gbm_bo_get_height(bo);
   auto handle = gbm_bo_get_handle(bo).u32;
   auto stride = gbm_bo_get_stride(bo);
+  const uint32_t handles[4] = {handle};
+  const uint32_t strides[4] = {stride};
+  const uint32_t offsets[4] = {0};
   uint32_t fb;
-  int result =
-      drmModeAddFB(drm_device_, width, height, 24, 32, stride, handle, &fb);
+  int result = drmModeAddFB2(drm_device_, width, height, gbm_bo_get_format(bo),
+                             handles, strides, offsets, &fb, 0);
   if (result != 0) {
     ELINUX_LOG(ERROR) << "Failed to add a framebuffer. (" << result << ")";
   }
@@ -187,6 +224,7 @@ void NativeWindowDrmGbm::SwapBuffers() {
       ELINUX_LOG(ERROR) << "Failed to set crct mode. (" << result << ")";
     }
   }
+  ScanOutMirrorOutputs(fb, width, height);
 
   if (gbm_previous_bo_) {
     drmModeRmFB(drm_device_, gbm_previous_fb_);
@@ -198,23 +236,37 @@ void NativeWindowDrmGbm::SwapBuffers() {
 }
 
 bool NativeWindowDrmGbm::CreateGbmSurface() {
-  window_ = gbm_surface_create(gbm_device_, drm_mode_info_.hdisplay,
-                               drm_mode_info_.vdisplay, GBM_FORMAT_ARGB8888,
+  if (!format_) {
+    format_ = GetGbmFormat(config_attributes_);
+  }
+  window_ = gbm_surface_create(gbm_device_, BufferWidth(), BufferHeight(),
+                               format_,
                                GBM_BO_USE_SCANOUT | GBM_BO_USE_RENDERING);
+  if (!window_ && format_ != GBM_FORMAT_ARGB8888) {
+    ELINUX_LOG(WARNING) << "The GPU can't scan out the requested format. "
+                           "Falls back to ARGB8888.";
+    format_ = GBM_FORMAT_ARGB8888;
+    window_ = gbm_surface_create(gbm_device_, BufferWidth(), BufferHeight(),
+                                 format_,
+                                 GBM_BO_USE_SCANOUT | GBM_BO_USE_RENDERING);
+  }
   if (!window_) {
     ELINUX_LOG(ERROR) << "Failed to create the gbm surface.";
     valid_ = false;
     return false;
   }
+  surface_width_ = BufferWidth();
+  surface_height_ = BufferHeight();
+  return true;
+}
 
-  window_offscreen_ = gbm_surface_create(gbm_device_, 1, 1, GBM_FORMAT_ARGB8888,
-                                         GBM_BO_USE_RENDERING);
-  if (!window_offscreen_) {
+EGLNativeWindowType NativeWindowDrmGbm::CreateWindowOffscreen() {
+  auto* surface =
+      gbm_surface_create(gbm_device_, 1, 1, format_, GBM_BO_USE_RENDERING);
+  if (!surface) {
     ELINUX_LOG(ERROR) << "Failed to create the gbm surface for offscreen.";
-    return false;
   }
-
-  return true;
+  return surface;
 }
 
 bool NativeWindowDrmGbm::CreateCursorBuffer(const std::string& cursor_name) {
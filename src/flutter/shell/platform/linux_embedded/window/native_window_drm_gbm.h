@@ -19,7 +19,8 @@ class NativeWindowDrmGbm : public NativeWindowDrm {
  public:
   NativeWindowDrmGbm(const char* device_filename,
                      const uint16_t rotation,
-                     bool enable_vsync);
+                     bool enable_vsync,
+                     const EglConfigAttributes& config_attributes);
   ~NativeWindowDrmGbm();
 
   // |NativeWindowDrm|
@@ -45,6 +46,10 @@ class NativeWindowDrmGbm : public NativeWindowDrm {
   // |NativeWindow|
   void SwapBuffers() override;
 
+ protected:
+  // |NativeWindow|
+  EGLNativeWindowType CreateWindowOffscreen() override;
+
  private:
   bool CreateGbmSurface();
 
@@ -54,6 +59,15 @@ class NativeWindowDrmGbm : public NativeWindowDrm {
   uint32_t gbm_previous_fb_;
   gbm_device* gbm_device_ = nullptr;
   gbm_bo* gbm_cursor_bo_ = nullptr;
+
+  // Format of the GBM surface, which follows the color sizes of the EGL
+  // config. It is kept when the surface is recreated by Resize().
+  uint32_t format_ = 0;
+
+  // Size of the current GBM surface. See BufferWidth() and BufferHeight().
+  uint32_t surface_width_ = 0;
+  uint32_t surface_height_ = 0;
+  bool need_recreate_surface_ = false;
 };
 
 }  // namespace flutter
@@ -0,0 +1,217 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_drm_vulkan.h"
+
+#include <xf86drm.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+NativeWindowDrmVulkan::NativeWindowDrmVulkan(
+    const char* device_filename,
+    const uint16_t rotation,
+    bool enable_vsync,
+    const EglConfigAttributes& config_attributes)
+    : NativeWindowDrm(device_filename, rotation, enable_vsync,
+                      config_attributes) {
+  if (!valid_) {
+    return;
+  }
+
+  // The Vulkan driver needs the DRM master to set the modes.
+  if (!drmIsMaster(drm_device_)) {
+    ELINUX_LOG(ERROR)
+        << "Couldn't become the DRM master. Please confirm if another display "
+           "backend such as X11 and Wayland is not running.";
+    valid_ = false;
+  }
+}
+
+NativeWindowDrmVulkan::~NativeWindowDrmVulkan() {
+  if (drm_device_ == -1) {
+    return;
+  }
+
+  // The display has been released with the Vulkan instance.
+  if (drm_crtc_) {
+    drmModeSetCrtc(drm_device_, drm_crtc_->crtc_id, drm_crtc_->buffer_id,
+                   drm_crtc_->x, drm_crtc_->y, &drm_connector_id_, 1,
+                   &drm_crtc_->mode);
+    drmModeFreeCrtc(drm_crtc_);
+  }
+}
+
+bool NativeWindowDrmVulkan::ShowCursor(double x, double y) {
+  // The mouse cursor isn't supported.
+  return true;
+}
+
+bool NativeWindowDrmVulkan::UpdateCursor(const std::string& cursor_name,
+                                         double x,
+                                         double y) {
+  // The mouse cursor isn't supported.
+  return true;
+}
+
+bool NativeWindowDrmVulkan::DismissCursor() {
+  // The mouse cursor isn't supported.
+  return true;
+}
+
+std::unique_ptr<SurfaceGl> NativeWindowDrmVulkan::CreateRenderSurface(
+    bool enable_impeller) {
+  // The frames are presented by SurfaceVulkan.
+  return nullptr;
+}
+
+bool NativeWindowDrmVulkan::Resize(const size_t width, const size_t height) {
+  // The window always has the size of the mode.
+  return true;
+}
+
+VkSurfaceKHR NativeWindowDrmVulkan::CreateVulkanSurface(
+    VkInstance instance,
+    VkPhysicalDevice physical_device) {
+  auto get_drm_display = reinterpret_cast<PFN_vkGetDrmDisplayEXT>(
+      vkGetInstanceProcAddr(instance, "vkGetDrmDisplayEXT"));
+  auto acquire_drm_display = reinterpret_cast<PFN_vkAcquireDrmDisplayEXT>(
+      vkGetInstanceProcAddr(instance, "vkAcquireDrmDisplayEXT"));
+  if (!get_drm_display || !acquire_drm_display) {
+    ELINUX_LOG(ERROR) << VK_EXT_ACQUIRE_DRM_DISPLAY_EXTENSION_NAME
+                      << " isn't supported.";
+    return VK_NULL_HANDLE;
+  }
+
+  // Fails if the physical device isn't the DRM device.
+  VkDisplayKHR display = VK_NULL_HANDLE;
+  if (get_drm_display(physical_device, drm_device_, drm_connector_id_,
+                      &display) != VK_SUCCESS ||
+      display == VK_NULL_HANDLE) {
+    return VK_NULL_HANDLE;
+  }
+  auto result = acquire_drm_display(physical_device, drm_device_, display);
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to acquire the display: " << result;
+    return VK_NULL_HANDLE;
+  }
+
+  VkExtent2D extent;
+  auto mode = FindDisplayMode(physical_device, display, extent);
+  if (mode == VK_NULL_HANDLE) {
+    ELINUX_LOG(ERROR) << "The display has no modes.";
+    return VK_NULL_HANDLE;
+  }
+
+  uint32_t plane_index;
+  uint32_t plane_stack_index;
+  if (!FindDisplayPlane(physical_device, display, plane_index,
+                        plane_stack_index)) {
+    ELINUX_LOG(ERROR) << "No plane can show the display.";
+    return VK_NULL_HANDLE;
+  }
+
+  VkDisplayPlaneCapabilitiesKHR capabilities;
+  vkGetDisplayPlaneCapabilitiesKHR(physical_device, mode, plane_index,
+                                   &capabilities);
+  auto alpha_mode = VK_DISPLAY_PLANE_ALPHA_OPAQUE_BIT_KHR;
+  if (!(capabilities.supportedAlpha & alpha_mode)) {
+    alpha_mode = VK_DISPLAY_PLANE_ALPHA_GLOBAL_BIT_KHR;
+  }
+
+  VkDisplaySurfaceCreateInfoKHR create_info = {};
+  create_info.sType = VK_STRUCTURE_TYPE_DISPLAY_SURFACE_CREATE_INFO_KHR;
+  create_info.displayMode = mode;
+  create_info.planeIndex = plane_index;
+  create_info.planeStackIndex = plane_stack_index;
+  create_info.transform = VK_SURFACE_TRANSFORM_IDENTITY_BIT_KHR;
+  create_info.globalAlpha = 1.0f;
+  create_info.alphaMode = alpha_mode;
+  create_info.imageExtent = extent;
+
+  VkSurfaceKHR surface = VK_NULL_HANDLE;
+  result = vkCreateDisplayPlaneSurfaceKHR(instance, &create_info, nullptr,
+                                          &surface);
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create the Vulkan surface: " << result;
+    return VK_NULL_HANDLE;
+  }
+  return surface;
+}
+
+VkDisplayModeKHR NativeWindowDrmVulkan::FindDisplayMode(
+    VkPhysicalDevice physical_device,
+    VkDisplayKHR display,
+    VkExtent2D& extent) {
+  uint32_t count = 0;
+  vkGetDisplayModePropertiesKHR(physical_device, display, &count, nullptr);
+  std::vector<VkDisplayModePropertiesKHR> modes(count);
+  vkGetDisplayModePropertiesKHR(physical_device, display, &count,
+                                modes.data());
+  if (modes.empty()) {
+    return VK_NULL_HANDLE;
+  }
+
+  // The refresh rate of Vulkan is in mHz.
+  const uint32_t refresh_rate = drm_mode_info_.vrefresh * 1000;
+  auto found = std::min_element(
+      modes.begin(), modes.end(),
+      [this, refresh_rate](const VkDisplayModePropertiesKHR& a,
+                           const VkDisplayModePropertiesKHR& b) {
+        auto matches = [this](const VkDisplayModePropertiesKHR& mode) {
+          return mode.parameters.visibleRegion.width ==
+                     drm_mode_info_.hdisplay &&
+                 mode.parameters.visibleRegion.height ==
+                     drm_mode_info_.vdisplay;
+        };
+        if (matches(a) != matches(b)) {
+          return matches(a);
+        }
+        return std::abs(static_cast<int64_t>(a.parameters.refreshRate) -
+                        refresh_rate) <
+               std::abs(static_cast<int64_t>(b.parameters.refreshRate) -
+                        refresh_rate);
+      });
+  extent = found->parameters.visibleRegion;
+  return found->displayMode;
+}
+
+bool NativeWindowDrmVulkan::FindDisplayPlane(VkPhysicalDevice physical_device,
+                                             VkDisplayKHR display,
+                                             uint32_t& plane_index,
+                                             uint32_t& plane_stack_index) {
+  uint32_t count = 0;
+  vkGetPhysicalDeviceDisplayPlanePropertiesKHR(physical_device, &count,
+                                               nullptr);
+  std::vector<VkDisplayPlanePropertiesKHR> planes(count);
+  vkGetPhysicalDeviceDisplayPlanePropertiesKHR(physical_device, &count,
+                                               planes.data());
+  for (uint32_t i = 0; i < count; i++) {
+    if (planes[i].currentDisplay != VK_NULL_HANDLE &&
+        planes[i].currentDisplay != display) {
+      continue;
+    }
+
+    uint32_t display_count = 0;
+    vkGetDisplayPlaneSupportedDisplaysKHR(physical_device, i, &display_count,
+                                          nullptr);
+    std::vector<VkDisplayKHR> displays(display_count);
+    vkGetDisplayPlaneSupportedDisplaysKHR(physical_device, i, &display_count,
+                                          displays.data());
+    if (std::find(displays.begin(), displays.end(), display) !=
+        displays.end()) {
+      plane_index = i;
+      plane_stack_index = planes[i].currentStackIndex;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace flutter
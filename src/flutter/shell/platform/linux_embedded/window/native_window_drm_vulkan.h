@@ -0,0 +1,64 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_DRM_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_DRM_VULKAN_H_
+
+#include <string>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_drm.h"
+
+namespace flutter {
+
+// A DRM window for the Vulkan renderer. The connector is acquired by the
+// Vulkan driver (VK_EXT_acquire_drm_display), which scans out the swapchain
+// images on a display plane surface (VK_KHR_display).
+//
+// The mouse cursor isn't supported, because the planes are owned by the
+// Vulkan driver.
+class NativeWindowDrmVulkan : public NativeWindowDrm {
+ public:
+  NativeWindowDrmVulkan(const char* device_filename,
+                        const uint16_t rotation,
+                        bool enable_vsync,
+                        const EglConfigAttributes& config_attributes);
+  ~NativeWindowDrmVulkan();
+
+  // |NativeWindowDrm|
+  bool ShowCursor(double x, double y) override;
+
+  // |NativeWindowDrm|
+  bool UpdateCursor(const std::string& cursor_name,
+                    double x,
+                    double y) override;
+
+  // |NativeWindowDrm|
+  bool DismissCursor() override;
+
+  // |NativeWindowDrm|
+  std::unique_ptr<SurfaceGl> CreateRenderSurface(bool enable_impeller) override;
+
+  // |NativeWindow|
+  bool Resize(const size_t width, const size_t height) override;
+
+  // |NativeWindow|
+  VkSurfaceKHR CreateVulkanSurface(VkInstance instance,
+                                   VkPhysicalDevice physical_device) override;
+
+ private:
+  // Finds the mode of |display| matching |drm_mode_info_|.
+  VkDisplayModeKHR FindDisplayMode(VkPhysicalDevice physical_device,
+                                   VkDisplayKHR display,
+                                   VkExtent2D& extent);
+
+  // Finds a plane which can show |display|, or returns false.
+  bool FindDisplayPlane(VkPhysicalDevice physical_device,
+                        VkDisplayKHR display,
+                        uint32_t& plane_index,
+                        uint32_t& plane_stack_index);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_DRM_VULKAN_H_
@@ -0,0 +1,94 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_headless.h"
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+constexpr int32_t kBytesPerPixel = 4;
+}  // namespace
+
+NativeWindowHeadless::NativeWindowHeadless(const size_t width_px,
+                                           const size_t height_px,
+                                           bool enable_vsync) {
+  window_ = {};
+  enable_vsync_ = enable_vsync;
+  width_ = width_px;
+  height_ = height_px;
+  x_ = 0;
+  y_ = 0;
+  valid_ = true;
+}
+
+bool NativeWindowHeadless::Resize(const size_t width_px,
+                                  const size_t height_px) {
+  if (!valid_) {
+    ELINUX_LOG(ERROR) << "Failed to resize the window.";
+    return false;
+  }
+
+  // The software buffer is reallocated on the raster thread.
+  std::lock_guard<std::mutex> lock(mutex_);
+  width_ = width_px;
+  height_ = height_px;
+  return true;
+}
+
+NativeWindow::SoftwareBuffer* NativeWindowHeadless::AcquireSoftwareBuffer() {
+  int32_t width;
+  int32_t height;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    width = width_;
+    height = height_;
+  }
+  if (buffer_.width != width || buffer_.height != height) {
+    const size_t stride = width * kBytesPerPixel;
+    pixels_.assign(stride * height, 0);
+    buffer_.pixels = pixels_.data();
+    buffer_.stride = stride;
+    buffer_.width = width;
+    buffer_.height = height;
+    buffer_.frame_number = 0;
+  }
+  return &buffer_;
+}
+
+bool NativeWindowHeadless::PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                                                 const FlutterRect& damage) {
+  // There's no display to present to.
+  return buffer == &buffer_;
+}
+
+#if defined(ENABLE_VULKAN)
+VkSurfaceKHR NativeWindowHeadless::CreateVulkanSurface(
+    VkInstance instance,
+    VkPhysicalDevice physical_device) {
+  auto create_headless_surface =
+      reinterpret_cast<PFN_vkCreateHeadlessSurfaceEXT>(
+          vkGetInstanceProcAddr(instance, "vkCreateHeadlessSurfaceEXT"));
+  if (!create_headless_surface) {
+    ELINUX_LOG(ERROR) << VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME
+                      << " isn't supported.";
+    return VK_NULL_HANDLE;
+  }
+
+  VkHeadlessSurfaceCreateInfoEXT create_info = {};
+  create_info.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+
+  VkSurfaceKHR surface = VK_NULL_HANDLE;
+  auto result =
+      create_headless_surface(instance, &create_info, nullptr, &surface);
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create the Vulkan surface: " << result;
+    return VK_NULL_HANDLE;
+  }
+  return surface;
+}
+#endif
+
+}  // namespace flutter
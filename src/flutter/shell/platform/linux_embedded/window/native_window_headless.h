@@ -0,0 +1,63 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_HEADLESS_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_HEADLESS_H_
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window.h"
+
+namespace flutter {
+
+// A window without any display. The frames are rendered into a pbuffer
+// surface with OpenGL ES, into a buffer in memory with the software renderer,
+// or into a headless swapchain (VK_EXT_headless_surface) with Vulkan, and
+// never shown.
+class NativeWindowHeadless : public NativeWindow {
+ public:
+  // @param[in] width_px       Physical width of the window.
+  // @param[in] height_px      Physical height of the window.
+  NativeWindowHeadless(const size_t width_px,
+                       const size_t height_px,
+                       bool enable_vsync);
+  ~NativeWindowHeadless() = default;
+
+  // |NativeWindow|
+  bool IsNeedRecreateSurfaceAfterResize() const override {
+    // pbuffer surfaces can't be resized.
+    return true;
+  }
+
+  // |NativeWindow|
+  bool Resize(const size_t width_px, const size_t height_px) override;
+
+  // |NativeWindow|
+  SoftwareBuffer* AcquireSoftwareBuffer() override;
+
+  // |NativeWindow|
+  bool PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                             const FlutterRect& damage) override;
+
+#if defined(ENABLE_VULKAN)
+  // |NativeWindow|
+  VkSurfaceKHR CreateVulkanSurface(VkInstance instance,
+                                   VkPhysicalDevice physical_device) override;
+#endif
+
+ private:
+  // The frames of the software renderer stay in this buffer, so only the rows
+  // which have changed are copied into it.
+  std::vector<uint8_t> pixels_;
+  SoftwareBuffer buffer_;
+
+  // Guards the size requested by Resize() on the platform thread.
+  std::mutex mutex_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_HEADLESS_H_
@@ -5,16 +5,19 @@
 #include "flutter/shell/platform/linux_embedded/window/native_window_wayland.h"
 
 #include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
 
 namespace flutter {
 
-NativeWindowWayland::NativeWindowWayland(wl_compositor* compositor,
-                                         const size_t width_px,
-                                         const size_t height_px,
-                                         bool enable_vsync) {
-  surface_ = wl_compositor_create_surface(compositor);
+NativeWindowWayland::NativeWindowWayland(
+    wl_display* display,
+    wl_compositor* compositor,
+    const size_t width_px,
+    const size_t height_px,
+    bool enable_vsync,
+    const EglConfigAttributes& config_attributes)
+    : NativeWindowWayland(display, compositor) {
   if (!surface_) {
-    ELINUX_LOG(ERROR) << "Failed to create the compositor surface.";
     return;
   }
 
@@ -24,30 +27,38 @@ NativeWindowWayland::NativeWindowWayland(wl_compositor* compositor,
     return;
   }
 
-  // The offscreen (resource) surface will not be mapped, but needs to be a
-  // wl_surface because ONLY window EGL surfaces are supported on Wayland.
-  {
-    surface_offscreen_ = wl_compositor_create_surface(compositor);
-    if (!surface_offscreen_) {
-      ELINUX_LOG(ERROR)
-          << "Failed to create the compositor surface for off-screen.";
-      return;
-    }
-
-    window_offscreen_ = wl_egl_window_create(surface_offscreen_, 1, 1);
-    if (!window_offscreen_) {
-      ELINUX_LOG(ERROR) << "Failed to create the EGL window for offscreen.";
-      return;
-    }
-  }
-
   enable_vsync_ = enable_vsync;
+  config_attributes_ = config_attributes;
   width_ = width_px;
   height_ = height_px;
   valid_ = true;
 }
 
+NativeWindowWayland::NativeWindowWayland(wl_display* display,
+                                         wl_compositor* compositor)
+    : display_(display), compositor_(compositor) {
+  window_ = nullptr;
+  window_offscreen_ = nullptr;
+
+  surface_ = wl_compositor_create_surface(compositor);
+  if (!surface_) {
+    ELINUX_LOG(ERROR) << "Failed to create the compositor surface.";
+  }
+}
+
 NativeWindowWayland::~NativeWindowWayland() {
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+  if (wp_commit_timer_v1_) {
+    wp_commit_timer_v1_destroy(wp_commit_timer_v1_);
+    wp_commit_timer_v1_ = nullptr;
+  }
+
+  if (wp_fifo_v1_) {
+    wp_fifo_v1_destroy(wp_fifo_v1_);
+    wp_fifo_v1_ = nullptr;
+  }
+#endif
+
   if (window_) {
     wl_egl_window_destroy(window_);
     window_ = nullptr;
@@ -69,6 +80,30 @@ NativeWindowWayland::~NativeWindowWayland() {
   }
 }
 
+std::unique_ptr<SurfaceGl> NativeWindowWayland::CreateRenderSurface(
+    bool enable_impeller) {
+  return std::make_unique<SurfaceGl>(std::make_unique<ContextEgl>(
+      std::make_unique<EnvironmentEgl>(display_), enable_impeller,
+      EGL_WINDOW_BIT, config_attributes_));
+}
+
+EGLNativeWindowType NativeWindowWayland::CreateWindowOffscreen() {
+  // The offscreen (resource) surface will not be mapped, but needs to be a
+  // wl_surface because ONLY window EGL surfaces are supported on Wayland.
+  surface_offscreen_ = wl_compositor_create_surface(compositor_);
+  if (!surface_offscreen_) {
+    ELINUX_LOG(ERROR)
+        << "Failed to create the compositor surface for off-screen.";
+    return nullptr;
+  }
+
+  auto* window = wl_egl_window_create(surface_offscreen_, 1, 1);
+  if (!window) {
+    ELINUX_LOG(ERROR) << "Failed to create the EGL window for offscreen.";
+  }
+  return window;
+}
+
 bool NativeWindowWayland::Resize(const size_t width_px,
                                  const size_t height_px) {
   if (!valid_) {
@@ -82,4 +117,49 @@ bool NativeWindowWayland::Resize(const size_t width_px,
   return true;
 }
 
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+void NativeWindowWayland::EnableFramePacing(
+    wp_fifo_manager_v1* fifo_manager,
+    wp_commit_timing_manager_v1* commit_timing_manager,
+    TargetPresentationTimeCallback target_time_callback) {
+  if (!surface_ || wp_fifo_v1_) {
+    return;
+  }
+
+  wp_fifo_v1_ = wp_fifo_manager_v1_get_fifo(fifo_manager, surface_);
+  if (commit_timing_manager) {
+    wp_commit_timer_v1_ =
+        wp_commit_timing_manager_v1_get_timer(commit_timing_manager, surface_);
+    target_time_callback_ = std::move(target_time_callback);
+  }
+
+  // The compositor holds back the commits instead.
+  enable_vsync_ = false;
+}
+
+void NativeWindowWayland::PrepareSwapBuffers() {
+  if (!wp_fifo_v1_) {
+    return;
+  }
+
+  // The next commit isn't applied until the previous one has been presented,
+  // and the barrier set here holds back the commit after it in turn. So every
+  // frame is presented and the rendering never runs ahead of the display.
+  wp_fifo_v1_set_barrier(wp_fifo_v1_);
+  wp_fifo_v1_wait_barrier(wp_fifo_v1_);
+
+  if (wp_commit_timer_v1_ && target_time_callback_) {
+    const uint64_t target_time_nanos = target_time_callback_();
+    if (target_time_nanos != 0) {
+      constexpr uint64_t kNanosPerSecond = 1000000000;
+      const uint64_t seconds = target_time_nanos / kNanosPerSecond;
+      wp_commit_timer_v1_set_timestamp(
+          wp_commit_timer_v1_, static_cast<uint32_t>(seconds >> 32),
+          static_cast<uint32_t>(seconds & 0xffffffff),
+          static_cast<uint32_t>(target_time_nanos % kNanosPerSecond));
+    }
+  }
+}
+#endif
+
 }  // namespace flutter
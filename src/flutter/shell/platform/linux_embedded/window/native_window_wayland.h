@@ -7,28 +7,83 @@
 
 #include <wayland-egl.h>
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "flutter/shell/platform/linux_embedded/surface/surface_gl.h"
 #include "flutter/shell/platform/linux_embedded/window/native_window.h"
 
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+// These header files are automatically generated by the
+// wayland-scanner.
+extern "C" {
+#include "wayland/protocols/commit-timing-v1-client-protocol.h"
+#include "wayland/protocols/fifo-v1-client-protocol.h"
+}
+#endif
+
 namespace flutter {
 
 class NativeWindowWayland : public NativeWindow {
  public:
   // @param[in] width_px       Physical width of the window.
   // @param[in] height_px      Physical height of the window.
-  NativeWindowWayland(wl_compositor* compositor,
+  // @param[in] config_attributes  EGL config of the render surface.
+  NativeWindowWayland(wl_display* display,
+                      wl_compositor* compositor,
                       const size_t width_px,
                       const size_t height_px,
-                      bool enable_vsync);
-  ~NativeWindowWayland();
+                      bool enable_vsync,
+                      const EglConfigAttributes& config_attributes);
+  virtual ~NativeWindowWayland();
+
+  // Creates the render surface whose EGL display matches the native windows.
+  virtual std::unique_ptr<SurfaceGl> CreateRenderSurface(bool enable_impeller);
 
   // |NativeWindow|
   bool Resize(const size_t width_px, const size_t height_px) override;
 
   wl_surface* Surface() const { return surface_; }
 
- private:
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+  // Returns the earliest time (CLOCK_MONOTONIC) in nanoseconds at which the
+  // next frame may be presented, or 0 if it's unknown.
+  using TargetPresentationTimeCallback = std::function<uint64_t()>;
+
+  // Paces the commits with the fifo protocol instead of blocking the raster
+  // thread in eglSwapBuffers, so the swap interval is set to 0. If
+  // |commit_timing_manager| is given, each commit also carries its target
+  // presentation time. Must be called before the render surface is created.
+  void EnableFramePacing(wp_fifo_manager_v1* fifo_manager,
+                         wp_commit_timing_manager_v1* commit_timing_manager,
+                         TargetPresentationTimeCallback target_time_callback);
+
+  // |NativeWindow|
+  void PrepareSwapBuffers() override;
+#endif
+
+ protected:
+  // Creates only the wl_surface. Subclasses are responsible for the native
+  // windows (|window_| and |window_offscreen_|) and their destruction.
+  NativeWindowWayland(wl_display* display, wl_compositor* compositor);
+
+  // |NativeWindow|
+  EGLNativeWindowType CreateWindowOffscreen() override;
+
+  wl_display* display_ = nullptr;
+  wl_compositor* compositor_ = nullptr;
   wl_surface* surface_ = nullptr;
+  EglConfigAttributes config_attributes_;
+
+ private:
   wl_surface* surface_offscreen_ = nullptr;
+
+#if defined(USE_WAYLAND_FRAME_PACING_PROTOCOLS)
+  wp_fifo_v1* wp_fifo_v1_ = nullptr;
+  wp_commit_timer_v1* wp_commit_timer_v1_ = nullptr;
+  TargetPresentationTimeCallback target_time_callback_;
+#endif
 };
 
 }  // namespace flutter
@@ -0,0 +1,544 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland_gbm.h"
+
+#include <drm_fourcc.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <xf86drm.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+#include "flutter/shell/platform/linux_embedded/surface/context_egl.h"
+#include "flutter/shell/platform/linux_embedded/window/gbm_format.h"
+
+namespace flutter {
+
+namespace {
+// Returns the formats in order of preference. The format matching
+// |config_attributes| comes first, then the 8-bit RGB formats that every
+// compositor supports as a fallback.
+std::vector<uint32_t> GetPreferredFormats(
+    const EglConfigAttributes& config_attributes) {
+  std::vector<uint32_t> formats = {GetGbmFormat(config_attributes)};
+  const uint32_t fallback_formats[] = {
+      config_attributes.alpha_size > 0 ? GBM_FORMAT_ARGB8888
+                                       : GBM_FORMAT_XRGB8888,
+      config_attributes.alpha_size > 0 ? GBM_FORMAT_XRGB8888
+                                       : GBM_FORMAT_ARGB8888,
+  };
+  for (const auto format : fallback_formats) {
+    if (std::find(formats.begin(), formats.end(), format) == formats.end()) {
+      formats.push_back(format);
+    }
+  }
+  return formats;
+}
+
+// An entry of the format table of zwp_linux_dmabuf_feedback_v1.
+struct FormatTableEntry {
+  uint32_t format;
+  uint32_t padding;
+  uint64_t modifier;
+};
+
+dev_t ToDevId(const wl_array* device) {
+  dev_t dev_id = 0;
+  if (device->size == sizeof(dev_t)) {
+    std::memcpy(&dev_id, device->data, sizeof(dev_t));
+  }
+  return dev_id;
+}
+}  // namespace
+
+const zwp_linux_dmabuf_feedback_v1_listener
+    NativeWindowWaylandGbm::kZwpLinuxDmabufFeedbackV1Listener = {
+        .done =
+            [](void* data,
+               struct zwp_linux_dmabuf_feedback_v1* feedback) -> void {
+          ELINUX_LOG(TRACE) << "zwp_linux_dmabuf_feedback_v1_listener.done";
+
+          auto self = reinterpret_cast<NativeWindowWaylandGbm*>(data);
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          self->feedback_current_ = std::move(self->feedback_pending_);
+          self->feedback_pending_ = Feedback();
+          self->feedback_received_ = true;
+        },
+        .format_table =
+            [](void* data,
+               struct zwp_linux_dmabuf_feedback_v1* feedback,
+               int32_t fd,
+               uint32_t size) -> void {
+          ELINUX_LOG(TRACE)
+              << "zwp_linux_dmabuf_feedback_v1_listener.format_table";
+
+          auto self = reinterpret_cast<NativeWindowWaylandGbm*>(data);
+          auto* table = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+          close(fd);
+          if (table == MAP_FAILED) {
+            ELINUX_LOG(ERROR) << "Failed to map the format table.";
+            return;
+          }
+
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          const auto* entries = static_cast<const FormatTableEntry*>(table);
+          const size_t count = size / sizeof(FormatTableEntry);
+          self->format_table_.clear();
+          self->format_table_.reserve(count);
+          for (size_t i = 0; i < count; i++) {
+            self->format_table_.push_back(
+                {entries[i].format, entries[i].modifier});
+          }
+          munmap(table, size);
+        },
+        .main_device =
+            [](void* data,
+               struct zwp_linux_dmabuf_feedback_v1* feedback,
+               struct wl_array* device) -> void {
+          ELINUX_LOG(TRACE)
+              << "zwp_linux_dmabuf_feedback_v1_listener.main_device";
+
+          auto self = reinterpret_cast<NativeWindowWaylandGbm*>(data);
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          self->feedback_pending_.main_device = ToDevId(device);
+        },
+        .tranche_done =
+            [](void* data,
+               struct zwp_linux_dmabuf_feedback_v1* feedback) -> void {
+          ELINUX_LOG(TRACE)
+              << "zwp_linux_dmabuf_feedback_v1_listener.tranche_done";
+
+          auto self = reinterpret_cast<NativeWindowWaylandGbm*>(data);
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          self->feedback_pending_.tranches.push_back(
+              std::move(self->tranche_pending_));
+          self->tranche_pending_ = Tranche();
+        },
+        .tranche_target_device =
+            [](void* data,
+               struct zwp_linux_dmabuf_feedback_v1* feedback,
+               struct wl_array* device) -> void {
+          ELINUX_LOG(TRACE)
+              << "zwp_linux_dmabuf_feedback_v1_listener.tranche_target_device";
+
+          auto self = reinterpret_cast<NativeWindowWaylandGbm*>(data);
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          self->tranche_pending_.target_device = ToDevId(device);
+        },
+        .tranche_formats =
+            [](void* data,
+               struct zwp_linux_dmabuf_feedback_v1* feedback,
+               struct wl_array* indices) -> void {
+          ELINUX_LOG(TRACE)
+              << "zwp_linux_dmabuf_feedback_v1_listener.tranche_formats";
+
+          auto self = reinterpret_cast<NativeWindowWaylandGbm*>(data);
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          const auto* index = static_cast<const uint16_t*>(indices->data);
+          const size_t count = indices->size / sizeof(uint16_t);
+          for (size_t i = 0; i < count; i++) {
+            if (index[i] < self->format_table_.size()) {
+              self->tranche_pending_.format_modifiers.push_back(
+                  self->format_table_[index[i]]);
+            }
+          }
+        },
+        .tranche_flags =
+            [](void* data,
+               struct zwp_linux_dmabuf_feedback_v1* feedback,
+               uint32_t flags) -> void {
+          ELINUX_LOG(TRACE)
+              << "zwp_linux_dmabuf_feedback_v1_listener.tranche_flags";
+
+          auto self = reinterpret_cast<NativeWindowWaylandGbm*>(data);
+          std::lock_guard<std::mutex> lock(self->mutex_);
+          self->tranche_pending_.flags = flags;
+        },
+};
+
+const wl_buffer_listener NativeWindowWaylandGbm::kWlBufferListener = {
+    .release =
+        [](void* data, wl_buffer* buffer) {
+          auto info = reinterpret_cast<BufferInfo*>(data);
+          gbm_surface_release_buffer(info->surface, info->bo);
+        },
+};
+
+const wl_callback_listener NativeWindowWaylandGbm::kWlCallbackListener = {
+    .done =
+        [](void* data, wl_callback* callback, uint32_t time) {
+          auto self = static_cast<NativeWindowWaylandGbm*>(data);
+          wl_callback_destroy(callback);
+          self->frame_callback_ = nullptr;
+        },
+};
+
+NativeWindowWaylandGbm::NativeWindowWaylandGbm(
+    wl_display* display,
+    wl_compositor* compositor,
+    zwp_linux_dmabuf_v1* linux_dmabuf,
+    const size_t width_px,
+    const size_t height_px,
+    bool enable_vsync,
+    const EglConfigAttributes& config_attributes)
+    : NativeWindowWayland(display, compositor) {
+  if (!surface_) {
+    return;
+  }
+  config_attributes_ = config_attributes;
+
+  if (zwp_linux_dmabuf_v1_get_version(linux_dmabuf) <
+      ZWP_LINUX_DMABUF_V1_GET_SURFACE_FEEDBACK_SINCE_VERSION) {
+    ELINUX_LOG(WARNING) << "linux-dmabuf feedback is not supported.";
+    return;
+  }
+
+  queue_ = wl_display_create_queue(display_);
+  linux_dmabuf_wrapper_ = static_cast<zwp_linux_dmabuf_v1*>(
+      wl_proxy_create_wrapper(linux_dmabuf));
+  wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(linux_dmabuf_wrapper_),
+                     queue_);
+  surface_wrapper_ =
+      static_cast<wl_surface*>(wl_proxy_create_wrapper(surface_));
+  wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(surface_wrapper_), queue_);
+
+  feedback_ = zwp_linux_dmabuf_v1_get_surface_feedback(linux_dmabuf_wrapper_,
+                                                       surface_);
+  zwp_linux_dmabuf_feedback_v1_add_listener(
+      feedback_, &kZwpLinuxDmabufFeedbackV1Listener, this);
+
+  // The compositor sends the initial feedback right after the request.
+  if (wl_display_roundtrip_queue(display_, queue_) == -1 ||
+      !feedback_received_) {
+    ELINUX_LOG(ERROR) << "Failed to receive linux-dmabuf feedback.";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!CreateGbmDevice(feedback_current_.main_device) ||
+      !CreateGbmSurface(width_px, height_px)) {
+    return;
+  }
+
+  enable_vsync_ = enable_vsync;
+  width_ = width_px;
+  height_ = height_px;
+  valid_ = true;
+}
+
+NativeWindowWaylandGbm::~NativeWindowWaylandGbm() {
+  // The EGL surfaces, and with them the buffer objects and their wl_buffers,
+  // have already been destroyed along with the render surface.
+  for (auto* surface : retired_surfaces_) {
+    gbm_surface_destroy(surface);
+  }
+  retired_surfaces_.clear();
+
+  if (window_) {
+    gbm_surface_destroy(reinterpret_cast<gbm_surface*>(window_));
+    window_ = nullptr;
+  }
+
+  if (window_offscreen_) {
+    gbm_surface_destroy(reinterpret_cast<gbm_surface*>(window_offscreen_));
+    window_offscreen_ = nullptr;
+  }
+
+  if (gbm_device_) {
+    gbm_device_destroy(gbm_device_);
+    gbm_device_ = nullptr;
+  }
+
+  if (drm_device_ != -1) {
+    close(drm_device_);
+    drm_device_ = -1;
+  }
+
+  if (frame_callback_) {
+    wl_callback_destroy(frame_callback_);
+    frame_callback_ = nullptr;
+  }
+
+  if (feedback_) {
+    zwp_linux_dmabuf_feedback_v1_destroy(feedback_);
+    feedback_ = nullptr;
+  }
+
+  if (surface_wrapper_) {
+    wl_proxy_wrapper_destroy(surface_wrapper_);
+    surface_wrapper_ = nullptr;
+  }
+
+  if (linux_dmabuf_wrapper_) {
+    wl_proxy_wrapper_destroy(linux_dmabuf_wrapper_);
+    linux_dmabuf_wrapper_ = nullptr;
+  }
+
+  if (queue_) {
+    wl_event_queue_destroy(queue_);
+    queue_ = nullptr;
+  }
+}
+
+std::unique_ptr<SurfaceGl> NativeWindowWaylandGbm::CreateRenderSurface(
+    bool enable_impeller) {
+  // The EGL config must render to the format of the GBM surface.
+  auto config_attributes = config_attributes_;
+  config_attributes.native_visual_id = format_;
+  return std::make_unique<SurfaceGl>(std::make_unique<ContextEgl>(
+      std::make_unique<EnvironmentEgl>(
+          reinterpret_cast<EGLNativeDisplayType>(gbm_device_)),
+      enable_impeller, EGL_WINDOW_BIT, config_attributes));
+}
+
+EGLNativeWindowType NativeWindowWaylandGbm::CreateWindowOffscreen() {
+  auto* surface =
+      gbm_surface_create(gbm_device_, 1, 1, format_, GBM_BO_USE_RENDERING);
+  if (!surface) {
+    ELINUX_LOG(ERROR) << "Failed to create the gbm surface for offscreen.";
+  }
+  return reinterpret_cast<EGLNativeWindowType>(surface);
+}
+
+bool NativeWindowWaylandGbm::IsNeedRecreateSurfaceAfterResize() const {
+  return true;
+}
+
+bool NativeWindowWaylandGbm::Resize(const size_t width_px,
+                                    const size_t height_px) {
+  if (!valid_) {
+    ELINUX_LOG(ERROR) << "Failed to resize the window.";
+    return false;
+  }
+
+  // The buffers are reallocated with the latest feedback, e.g. the scanout
+  // tranche offered after the surface became fullscreen.
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto* previous_surface = window_;
+  if (!CreateGbmSurface(width_px, height_px)) {
+    return false;
+  }
+  retired_surfaces_.push_back(reinterpret_cast<gbm_surface*>(previous_surface));
+
+  width_ = width_px;
+  height_ = height_px;
+  return true;
+}
+
+void NativeWindowWaylandGbm::SwapBuffers() {
+  gbm_surface* surface;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto* retired_surface : retired_surfaces_) {
+      gbm_surface_destroy(retired_surface);
+    }
+    retired_surfaces_.clear();
+    surface = reinterpret_cast<gbm_surface*>(window_);
+  }
+
+  auto* bo = gbm_surface_lock_front_buffer(surface);
+  if (!bo) {
+    ELINUX_LOG(ERROR) << "Failed to lock the front buffer.";
+    return;
+  }
+
+  auto* buffer = GetWlBuffer(surface, bo);
+  if (!buffer) {
+    gbm_surface_release_buffer(surface, bo);
+    return;
+  }
+
+  WaitForFrameCallback();
+
+  wl_surface_attach(surface_wrapper_, buffer, 0, 0);
+  if (wl_proxy_get_version(reinterpret_cast<wl_proxy*>(surface_)) >=
+      WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
+    wl_surface_damage_buffer(surface_wrapper_, 0, 0, INT32_MAX, INT32_MAX);
+  } else {
+    wl_surface_damage(surface_wrapper_, 0, 0, INT32_MAX, INT32_MAX);
+  }
+  if (enable_vsync_) {
+    frame_callback_ = wl_surface_frame(surface_wrapper_);
+    wl_callback_add_listener(frame_callback_, &kWlCallbackListener, this);
+  }
+  wl_surface_commit(surface_wrapper_);
+  wl_display_flush(display_);
+
+  WaitForFreeBuffer(surface);
+}
+
+bool NativeWindowWaylandGbm::CreateGbmDevice(dev_t main_device) {
+  drmDevicePtr device = nullptr;
+  if (drmGetDeviceFromDevId(main_device, 0, &device) != 0) {
+    ELINUX_LOG(ERROR) << "Failed to get the main DRM device.";
+    return false;
+  }
+
+  // Prefer the render node, which doesn't require DRM master.
+  const char* path = nullptr;
+  if (device->available_nodes & (1 << DRM_NODE_RENDER)) {
+    path = device->nodes[DRM_NODE_RENDER];
+  } else if (device->available_nodes & (1 << DRM_NODE_PRIMARY)) {
+    path = device->nodes[DRM_NODE_PRIMARY];
+  }
+  if (path) {
+    drm_device_ = open(path, O_RDWR | O_CLOEXEC);
+  }
+  drmFreeDevice(&device);
+
+  if (drm_device_ == -1) {
+    ELINUX_LOG(ERROR) << "Failed to open the main DRM device.";
+    return false;
+  }
+
+  gbm_device_ = gbm_create_device(drm_device_);
+  if (!gbm_device_) {
+    ELINUX_LOG(ERROR) << "Couldn't create the GBM device.";
+    return false;
+  }
+  return true;
+}
+
+bool NativeWindowWaylandGbm::CreateGbmSurface(const size_t width_px,
+                                              const size_t height_px) {
+  // Tranches are sent in order of preference, so the scanout tranche, if
+  // any, comes first. The buffers are always allocated on the main device,
+  // which the display device of a scanout tranche can import from. Other
+  // tranches targeting another device are of no use.
+  const auto preferred_formats = GetPreferredFormats(config_attributes_);
+  const Tranche* selected_tranche = nullptr;
+  uint32_t format = 0;
+  std::vector<uint64_t> modifiers;
+  bool implicit_modifier = false;
+  for (const auto& tranche : feedback_current_.tranches) {
+    if (tranche.target_device != feedback_current_.main_device &&
+        !(tranche.flags & ZWP_LINUX_DMABUF_FEEDBACK_V1_TRANCHE_FLAGS_SCANOUT)) {
+      continue;
+    }
+    for (const auto preferred_format : preferred_formats) {
+      for (const auto& format_modifier : tranche.format_modifiers) {
+        if (format_modifier.format != preferred_format) {
+          continue;
+        }
+        if (format_modifier.modifier == DRM_FORMAT_MOD_INVALID) {
+          implicit_modifier = true;
+        } else {
+          modifiers.push_back(format_modifier.modifier);
+        }
+      }
+      if (!modifiers.empty() || implicit_modifier) {
+        format = preferred_format;
+        break;
+      }
+    }
+    if (format) {
+      selected_tranche = &tranche;
+      break;
+    }
+  }
+
+  if (!selected_tranche) {
+    ELINUX_LOG(ERROR) << "No supported format in linux-dmabuf feedback.";
+    return false;
+  }
+
+  const bool scanout = selected_tranche->flags &
+                       ZWP_LINUX_DMABUF_FEEDBACK_V1_TRANCHE_FLAGS_SCANOUT;
+  ELINUX_LOG(INFO) << "Allocate buffers from the "
+                   << (scanout ? "scanout" : "rendering")
+                   << " tranche: format = 0x" << std::hex << format << std::dec
+                   << ", modifiers = " << modifiers.size();
+
+  uint32_t flags = GBM_BO_USE_RENDERING;
+  if (scanout) {
+    flags |= GBM_BO_USE_SCANOUT;
+  }
+  gbm_surface* surface = nullptr;
+  if (!modifiers.empty()) {
+    surface = gbm_surface_create_with_modifiers2(
+        gbm_device_, width_px, height_px, format, modifiers.data(),
+        modifiers.size(), flags);
+  }
+  if (!surface && implicit_modifier) {
+    surface = gbm_surface_create(gbm_device_, width_px, height_px, format,
+                                 flags);
+  }
+  if (!surface) {
+    ELINUX_LOG(ERROR) << "Failed to create the gbm surface.";
+    return false;
+  }
+
+  window_ = reinterpret_cast<EGLNativeWindowType>(surface);
+  format_ = format;
+  return true;
+}
+
+wl_buffer* NativeWindowWaylandGbm::GetWlBuffer(gbm_surface* surface,
+                                               gbm_bo* bo) {
+  auto* info = static_cast<BufferInfo*>(gbm_bo_get_user_data(bo));
+  if (info) {
+    return info->buffer;
+  }
+
+  auto* params = zwp_linux_dmabuf_v1_create_params(linux_dmabuf_wrapper_);
+  const uint64_t modifier = gbm_bo_get_modifier(bo);
+  const int plane_count = gbm_bo_get_plane_count(bo);
+  for (int i = 0; i < plane_count; i++) {
+    int fd = gbm_bo_get_fd_for_plane(bo, i);
+    if (fd < 0) {
+      ELINUX_LOG(ERROR) << "Failed to export the buffer object.";
+      zwp_linux_buffer_params_v1_destroy(params);
+      return nullptr;
+    }
+    zwp_linux_buffer_params_v1_add(params, fd, i, gbm_bo_get_offset(bo, i),
+                                   gbm_bo_get_stride_for_plane(bo, i),
+                                   modifier >> 32, modifier & 0xffffffff);
+    close(fd);
+  }
+
+  auto* buffer = zwp_linux_buffer_params_v1_create_immed(
+      params, gbm_bo_get_width(bo), gbm_bo_get_height(bo),
+      gbm_bo_get_format(bo), 0);
+  zwp_linux_buffer_params_v1_destroy(params);
+
+  info = new BufferInfo{surface, bo, buffer};
+  wl_buffer_add_listener(buffer, &kWlBufferListener, info);
+  gbm_bo_set_user_data(bo, info, [](gbm_bo* bo, void* data) {
+    auto info = static_cast<BufferInfo*>(data);
+    wl_buffer_destroy(info->buffer);
+    delete info;
+  });
+  return buffer;
+}
+
+void NativeWindowWaylandGbm::WaitForFreeBuffer(gbm_surface* surface) {
+  // Pick up the buffers which have already been released by the compositor.
+  if (wl_display_dispatch_queue_pending(display_, queue_) == -1) {
+    ELINUX_LOG(ERROR) << "Failed to dispatch the buffer events.";
+    return;
+  }
+
+  while (!gbm_surface_has_free_buffers(surface)) {
+    if (wl_display_dispatch_queue(display_, queue_) == -1) {
+      ELINUX_LOG(ERROR) << "Failed to dispatch the buffer events.";
+      return;
+    }
+  }
+}
+
+void NativeWindowWaylandGbm::WaitForFrameCallback() {
+  // Like eglSwapInterval(1), don't commit faster than the compositor repaints.
+  while (frame_callback_) {
+    if (wl_display_dispatch_queue(display_, queue_) == -1) {
+      ELINUX_LOG(ERROR) << "Failed to dispatch the frame events.";
+      return;
+    }
+  }
+}
+
+}  // namespace flutter
@@ -0,0 +1,146 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_GBM_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_GBM_H_
+
+#include <gbm.h>
+#include <sys/types.h>
+#include <wayland-client.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland.h"
+
+extern "C" {
+#include "wayland/protocols/linux-dmabuf-unstable-v1-client-protocol.h"
+}
+
+namespace flutter {
+
+// A Wayland window whose buffers are allocated with GBM and attached to the
+// surface as linux-dmabuf wl_buffers, instead of letting the EGL Wayland
+// platform pick the buffer format and modifiers.
+//
+// The format and modifiers follow the per-surface linux-dmabuf feedback
+// (zwp_linux_dmabuf_v1 version 4). When the compositor offers a scanout
+// tranche, e.g. for a fullscreen surface, the buffers are allocated from it
+// so that the compositor can put the surface directly on a display plane.
+//
+// With vsync, the commits are paced with the frame callbacks of the surface
+// (or the fifo protocol when it's enabled), as eglSwapInterval(1) is a no-op
+// for the buffers of a GBM surface.
+class NativeWindowWaylandGbm : public NativeWindowWayland {
+ public:
+  // @param[in] width_px       Physical width of the window.
+  // @param[in] height_px      Physical height of the window.
+  // @param[in] config_attributes  EGL config of the render surface. The
+  //                               buffer format follows its color sizes.
+  NativeWindowWaylandGbm(wl_display* display,
+                         wl_compositor* compositor,
+                         zwp_linux_dmabuf_v1* linux_dmabuf,
+                         const size_t width_px,
+                         const size_t height_px,
+                         bool enable_vsync,
+                         const EglConfigAttributes& config_attributes);
+  ~NativeWindowWaylandGbm();
+
+  // |NativeWindowWayland|
+  std::unique_ptr<SurfaceGl> CreateRenderSurface(bool enable_impeller) override;
+
+  // |NativeWindow|
+  bool IsNeedRecreateSurfaceAfterResize() const override;
+
+  // |NativeWindow|
+  bool Resize(const size_t width_px, const size_t height_px) override;
+
+  // |NativeWindow|
+  void SwapBuffers() override;
+
+ protected:
+  // |NativeWindow|
+  EGLNativeWindowType CreateWindowOffscreen() override;
+
+ private:
+  // Ties a wl_buffer to the GBM buffer object it wraps. Owned by the buffer
+  // object as its user data.
+  struct BufferInfo {
+    gbm_surface* surface;
+    gbm_bo* bo;
+    wl_buffer* buffer;
+  };
+
+  struct FormatModifier {
+    uint32_t format;
+    uint64_t modifier;
+  };
+
+  struct Tranche {
+    dev_t target_device = 0;
+    uint32_t flags = 0;
+    std::vector<FormatModifier> format_modifiers;
+  };
+
+  struct Feedback {
+    dev_t main_device = 0;
+    std::vector<Tranche> tranches;
+  };
+
+  static const zwp_linux_dmabuf_feedback_v1_listener
+      kZwpLinuxDmabufFeedbackV1Listener;
+  static const wl_buffer_listener kWlBufferListener;
+  static const wl_callback_listener kWlCallbackListener;
+
+  // Opens the render node of the main device of the feedback and creates the
+  // GBM device on it.
+  bool CreateGbmDevice(dev_t main_device);
+
+  bool CreateGbmSurface(const size_t width_px, const size_t height_px);
+
+  // Returns the wl_buffer wrapping |bo|, creating it on first use.
+  wl_buffer* GetWlBuffer(gbm_surface* surface, gbm_bo* bo);
+
+  // Waits until |surface| has a free buffer for the next frame.
+  void WaitForFreeBuffer(gbm_surface* surface);
+
+  // Waits for the frame callback of the previous commit, if any.
+  void WaitForFrameCallback();
+
+  // Event queue for the feedback, the buffer release and the frame events.
+  // These are dispatched on the thread calling SwapBuffers() (i.e. the raster
+  // thread).
+  wl_event_queue* queue_ = nullptr;
+  zwp_linux_dmabuf_v1* linux_dmabuf_wrapper_ = nullptr;
+  wl_surface* surface_wrapper_ = nullptr;
+  zwp_linux_dmabuf_feedback_v1* feedback_ = nullptr;
+
+  // Set while waiting for the frame callback of the previous commit.
+  wl_callback* frame_callback_ = nullptr;
+
+  int drm_device_ = -1;
+  gbm_device* gbm_device_ = nullptr;
+  uint32_t format_ = 0;
+
+  // GBM surfaces replaced by Resize(). Their EGL surfaces are recreated after
+  // Resize() returns, so they are destroyed on the next SwapBuffers().
+  std::vector<gbm_surface*> retired_surfaces_;
+
+  // Guards the feedback and the GBM surfaces, which are updated on the raster
+  // thread and read on the platform thread by Resize().
+  std::mutex mutex_;
+
+  // Format table received with zwp_linux_dmabuf_feedback_v1.format_table.
+  std::vector<FormatModifier> format_table_;
+  Feedback feedback_current_;
+  Feedback feedback_pending_;
+  Tranche tranche_pending_;
+  bool feedback_received_ = false;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_GBM_H_
@@ -0,0 +1,262 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland_shm.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+constexpr int32_t kBytesPerPixel = 4;
+}  // namespace
+
+const wl_buffer_listener NativeWindowWaylandShm::kWlBufferListener = {
+    .release =
+        [](void* data, wl_buffer* wl_buffer) {
+          auto buffer = static_cast<ShmBuffer*>(data);
+          buffer->busy = false;
+        },
+};
+
+const wl_callback_listener NativeWindowWaylandShm::kWlCallbackListener = {
+    .done =
+        [](void* data, wl_callback* callback, uint32_t time) {
+          auto self = static_cast<NativeWindowWaylandShm*>(data);
+          wl_callback_destroy(callback);
+          self->frame_callback_ = nullptr;
+        },
+};
+
+NativeWindowWaylandShm::NativeWindowWaylandShm(wl_display* display,
+                                               wl_compositor* compositor,
+                                               wl_shm* shm,
+                                               const size_t width_px,
+                                               const size_t height_px,
+                                               bool enable_vsync,
+                                               bool opaque)
+    : NativeWindowWayland(display, compositor) {
+  if (!surface_) {
+    return;
+  }
+  if (!shm) {
+    ELINUX_LOG(ERROR) << "wl_shm is not supported.";
+    return;
+  }
+
+  queue_ = wl_display_create_queue(display_);
+  shm_wrapper_ = static_cast<wl_shm*>(wl_proxy_create_wrapper(shm));
+  wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(shm_wrapper_), queue_);
+  surface_wrapper_ =
+      static_cast<wl_surface*>(wl_proxy_create_wrapper(surface_));
+  wl_proxy_set_queue(reinterpret_cast<wl_proxy*>(surface_wrapper_), queue_);
+
+  // Flutter renders kN32_SkColorType, i.e. BGRA in memory on little-endian
+  // devices. Both formats are always supported by the compositors.
+  format_ = opaque ? WL_SHM_FORMAT_XRGB8888 : WL_SHM_FORMAT_ARGB8888;
+
+  enable_vsync_ = enable_vsync;
+  width_ = width_px;
+  height_ = height_px;
+  valid_ = true;
+}
+
+NativeWindowWaylandShm::~NativeWindowWaylandShm() {
+  for (auto& buffer : buffers_) {
+    DestroyShmBuffer(buffer);
+  }
+
+  if (frame_callback_) {
+    wl_callback_destroy(frame_callback_);
+    frame_callback_ = nullptr;
+  }
+
+  if (surface_wrapper_) {
+    wl_proxy_wrapper_destroy(surface_wrapper_);
+    surface_wrapper_ = nullptr;
+  }
+
+  if (shm_wrapper_) {
+    wl_proxy_wrapper_destroy(shm_wrapper_);
+    shm_wrapper_ = nullptr;
+  }
+
+  if (queue_) {
+    wl_event_queue_destroy(queue_);
+    queue_ = nullptr;
+  }
+}
+
+std::unique_ptr<SurfaceGl> NativeWindowWaylandShm::CreateRenderSurface(
+    bool enable_impeller) {
+  // The frames are presented by SurfaceSoftware.
+  return nullptr;
+}
+
+bool NativeWindowWaylandShm::Resize(const size_t width_px,
+                                    const size_t height_px) {
+  if (!valid_) {
+    ELINUX_LOG(ERROR) << "Failed to resize the window.";
+    return false;
+  }
+
+  // The buffers are reallocated on the raster thread when they are free.
+  std::lock_guard<std::mutex> lock(mutex_);
+  width_ = width_px;
+  height_ = height_px;
+  return true;
+}
+
+NativeWindow::SoftwareBuffer* NativeWindowWaylandShm::AcquireSoftwareBuffer() {
+  // Pick up the buffers which have already been released by the compositor.
+  if (wl_display_dispatch_queue_pending(display_, queue_) == -1) {
+    ELINUX_LOG(ERROR) << "Failed to dispatch the buffer events.";
+    return nullptr;
+  }
+
+  // Like eglSwapInterval(1), don't commit faster than the compositor repaints.
+  while (enable_vsync_ && frame_callback_) {
+    if (!DispatchQueue()) {
+      return nullptr;
+    }
+  }
+
+  ShmBuffer* free_buffer = nullptr;
+  while (!free_buffer) {
+    for (auto& buffer : buffers_) {
+      if (!buffer.busy) {
+        free_buffer = &buffer;
+        break;
+      }
+    }
+    if (!free_buffer && !DispatchQueue()) {
+      return nullptr;
+    }
+  }
+
+  int32_t width;
+  int32_t height;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    width = width_;
+    height = height_;
+  }
+  if (free_buffer->buffer.width != width ||
+      free_buffer->buffer.height != height) {
+    DestroyShmBuffer(*free_buffer);
+    if (!CreateShmBuffer(*free_buffer, width, height)) {
+      return nullptr;
+    }
+  }
+  return &free_buffer->buffer;
+}
+
+bool NativeWindowWaylandShm::PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                                                   const FlutterRect& damage) {
+  ShmBuffer* shm_buffer = nullptr;
+  for (auto& candidate : buffers_) {
+    if (&candidate.buffer == buffer) {
+      shm_buffer = &candidate;
+      break;
+    }
+  }
+  if (!shm_buffer || !shm_buffer->wayland_buffer) {
+    return false;
+  }
+
+  if (damage.bottom <= damage.top) {
+    // Nothing has changed. Keep the buffer attached to the surface.
+    return true;
+  }
+
+  PrepareSwapBuffers();
+  wl_surface_attach(surface_wrapper_, shm_buffer->wayland_buffer, 0, 0);
+  const int32_t x = damage.left;
+  const int32_t y = damage.top;
+  const int32_t width = damage.right - damage.left;
+  const int32_t height = damage.bottom - damage.top;
+  if (wl_proxy_get_version(reinterpret_cast<wl_proxy*>(surface_)) >=
+      WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
+    wl_surface_damage_buffer(surface_wrapper_, x, y, width, height);
+  } else {
+    // The surface coordinates differ from the buffer ones when the buffer is
+    // scaled or transformed.
+    wl_surface_damage(surface_wrapper_, 0, 0, INT32_MAX, INT32_MAX);
+  }
+  if (enable_vsync_) {
+    frame_callback_ = wl_surface_frame(surface_wrapper_);
+    wl_callback_add_listener(frame_callback_, &kWlCallbackListener, this);
+  }
+  wl_surface_commit(surface_wrapper_);
+  wl_display_flush(display_);
+
+  shm_buffer->busy = true;
+  return true;
+}
+
+bool NativeWindowWaylandShm::CreateShmBuffer(ShmBuffer& buffer,
+                                             int32_t width,
+                                             int32_t height) {
+  const int32_t stride = width * kBytesPerPixel;
+  const size_t size = static_cast<size_t>(stride) * height;
+
+  auto fd = memfd_create("flutter-elinux-shm", MFD_CLOEXEC);
+  if (fd == -1) {
+    ELINUX_LOG(ERROR) << "Failed to create a shared memory file.";
+    return false;
+  }
+  if (ftruncate(fd, size) == -1) {
+    ELINUX_LOG(ERROR) << "Failed to allocate a shared memory buffer.";
+    close(fd);
+    return false;
+  }
+  auto* pixels =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (pixels == MAP_FAILED) {
+    ELINUX_LOG(ERROR) << "Failed to mmap a shared memory buffer.";
+    close(fd);
+    return false;
+  }
+
+  auto* pool = wl_shm_create_pool(shm_wrapper_, fd, size);
+  buffer.wayland_buffer =
+      wl_shm_pool_create_buffer(pool, 0, width, height, stride, format_);
+  wl_shm_pool_destroy(pool);
+  close(fd);
+  wl_buffer_add_listener(buffer.wayland_buffer, &kWlBufferListener, &buffer);
+
+  buffer.size = size;
+  buffer.busy = false;
+  buffer.buffer.pixels = static_cast<uint8_t*>(pixels);
+  buffer.buffer.stride = stride;
+  buffer.buffer.width = width;
+  buffer.buffer.height = height;
+  buffer.buffer.frame_number = 0;
+  return true;
+}
+
+void NativeWindowWaylandShm::DestroyShmBuffer(ShmBuffer& buffer) {
+  if (buffer.wayland_buffer) {
+    wl_buffer_destroy(buffer.wayland_buffer);
+  }
+  if (buffer.buffer.pixels) {
+    munmap(buffer.buffer.pixels, buffer.size);
+  }
+  buffer = ShmBuffer();
+}
+
+bool NativeWindowWaylandShm::DispatchQueue() {
+  if (wl_display_dispatch_queue(display_, queue_) == -1) {
+    ELINUX_LOG(ERROR) << "Failed to dispatch the buffer events.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace flutter
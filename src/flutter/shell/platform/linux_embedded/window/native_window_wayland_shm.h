@@ -0,0 +1,90 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_SHM_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_SHM_H_
+
+#include <wayland-client.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland.h"
+
+namespace flutter {
+
+// A Wayland window for the software renderer, whose buffers are shared memory
+// (wl_shm) and don't need a GPU.
+//
+// The frames are copied into two buffers in turn. Only the region which has
+// changed is copied, and reported to the compositor as the surface damage.
+class NativeWindowWaylandShm : public NativeWindowWayland {
+ public:
+  // @param[in] width_px       Physical width of the window.
+  // @param[in] height_px      Physical height of the window.
+  // @param[in] opaque         Whether the alpha channel of the frames is
+  //                           ignored by the compositor.
+  NativeWindowWaylandShm(wl_display* display,
+                         wl_compositor* compositor,
+                         wl_shm* shm,
+                         const size_t width_px,
+                         const size_t height_px,
+                         bool enable_vsync,
+                         bool opaque);
+  ~NativeWindowWaylandShm();
+
+  // |NativeWindowWayland|
+  std::unique_ptr<SurfaceGl> CreateRenderSurface(bool enable_impeller) override;
+
+  // |NativeWindow|
+  bool Resize(const size_t width_px, const size_t height_px) override;
+
+  // |NativeWindow|
+  SoftwareBuffer* AcquireSoftwareBuffer() override;
+
+  // |NativeWindow|
+  bool PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                             const FlutterRect& damage) override;
+
+ private:
+  struct ShmBuffer {
+    SoftwareBuffer buffer;
+    wl_buffer* wayland_buffer = nullptr;
+    size_t size = 0;
+    // Set while the compositor may read the buffer.
+    bool busy = false;
+  };
+
+  static const wl_buffer_listener kWlBufferListener;
+  static const wl_callback_listener kWlCallbackListener;
+
+  bool CreateShmBuffer(ShmBuffer& buffer, int32_t width, int32_t height);
+
+  void DestroyShmBuffer(ShmBuffer& buffer);
+
+  // Blocks until the buffer release or the frame events are dispatched.
+  // Returns false on error.
+  bool DispatchQueue();
+
+  // Event queue for the buffer release and the frame events. These are
+  // dispatched on the thread presenting the frames (i.e. the raster thread).
+  wl_event_queue* queue_ = nullptr;
+  wl_shm* shm_wrapper_ = nullptr;
+  wl_surface* surface_wrapper_ = nullptr;
+
+  uint32_t format_;
+  std::array<ShmBuffer, 2> buffers_;
+
+  // Set while waiting for the frame callback of the previous commit.
+  wl_callback* frame_callback_ = nullptr;
+
+  // Guards the size requested by Resize() on the platform thread.
+  std::mutex mutex_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_SHM_H_
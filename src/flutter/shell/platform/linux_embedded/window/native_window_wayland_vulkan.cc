@@ -0,0 +1,66 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland_vulkan.h"
+
+#include <vulkan/vulkan_wayland.h>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+NativeWindowWaylandVulkan::NativeWindowWaylandVulkan(wl_display* display,
+                                                     wl_compositor* compositor,
+                                                     const size_t width_px,
+                                                     const size_t height_px,
+                                                     bool enable_vsync)
+    : NativeWindowWayland(display, compositor) {
+  if (!surface_) {
+    return;
+  }
+
+  enable_vsync_ = enable_vsync;
+  width_ = width_px;
+  height_ = height_px;
+  valid_ = true;
+}
+
+std::unique_ptr<SurfaceGl> NativeWindowWaylandVulkan::CreateRenderSurface(
+    bool enable_impeller) {
+  // The frames are presented by SurfaceVulkan.
+  return nullptr;
+}
+
+bool NativeWindowWaylandVulkan::Resize(const size_t width_px,
+                                       const size_t height_px) {
+  if (!valid_) {
+    ELINUX_LOG(ERROR) << "Failed to resize the window.";
+    return false;
+  }
+
+  // The swapchain is recreated in the new size by SurfaceVulkan.
+  width_ = width_px;
+  height_ = height_px;
+  return true;
+}
+
+VkSurfaceKHR NativeWindowWaylandVulkan::CreateVulkanSurface(
+    VkInstance instance,
+    VkPhysicalDevice physical_device) {
+  VkWaylandSurfaceCreateInfoKHR create_info = {};
+  create_info.sType = VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR;
+  create_info.display = display_;
+  create_info.surface = surface_;
+
+  VkSurfaceKHR surface = VK_NULL_HANDLE;
+  auto result =
+      vkCreateWaylandSurfaceKHR(instance, &create_info, nullptr, &surface);
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create the Vulkan surface: " << result;
+    return VK_NULL_HANDLE;
+  }
+  return surface;
+}
+
+}  // namespace flutter
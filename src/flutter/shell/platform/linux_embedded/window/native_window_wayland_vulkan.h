@@ -0,0 +1,43 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_VULKAN_H_
+
+#include <wayland-client.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_wayland.h"
+
+namespace flutter {
+
+// A Wayland window for the Vulkan renderer. The buffers of the surface are
+// managed by the Vulkan swapchain (VK_KHR_wayland_surface).
+class NativeWindowWaylandVulkan : public NativeWindowWayland {
+ public:
+  // @param[in] width_px       Physical width of the window.
+  // @param[in] height_px      Physical height of the window.
+  NativeWindowWaylandVulkan(wl_display* display,
+                            wl_compositor* compositor,
+                            const size_t width_px,
+                            const size_t height_px,
+                            bool enable_vsync);
+  ~NativeWindowWaylandVulkan() = default;
+
+  // |NativeWindowWayland|
+  std::unique_ptr<SurfaceGl> CreateRenderSurface(bool enable_impeller) override;
+
+  // |NativeWindow|
+  bool Resize(const size_t width_px, const size_t height_px) override;
+
+  // |NativeWindow|
+  VkSurfaceKHR CreateVulkanSurface(VkInstance instance,
+                                   VkPhysicalDevice physical_device) override;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_WAYLAND_VULKAN_H_
@@ -4,10 +4,7 @@
 
 #include "flutter/shell/platform/linux_embedded/window/native_window_x11.h"
 
-#include <X11/Xatom.h>
-#include <X11/Xlib.h>
-#include <X11/Xutil.h>
-
+#include <cstdlib>
 #include <cstring>
 
 #include "flutter/shell/platform/linux_embedded/logger.h"
@@ -15,70 +12,98 @@
 namespace flutter {
 
 namespace {
+static constexpr char kWmProtocols[] = "WM_PROTOCOLS";
 static constexpr char kWmDeleteWindow[] = "WM_DELETE_WINDOW";
+
+xcb_atom_t InternAtom(xcb_connection_t* connection, const char* name) {
+  auto reply = xcb_intern_atom_reply(
+      connection, xcb_intern_atom(connection, false, std::strlen(name), name),
+      nullptr);
+  if (!reply) {
+    return XCB_ATOM_NONE;
+  }
+  auto atom = reply->atom;
+  free(reply);
+  return atom;
+}
 }  // namespace
 
-NativeWindowX11::NativeWindowX11(Display* display,
-                                 VisualID visual_id,
+NativeWindowX11::NativeWindowX11(xcb_connection_t* connection,
+                                 xcb_screen_t* screen,
+                                 xcb_visualid_t visual_id,
                                  const char* title,
                                  const size_t width,
                                  const size_t height,
                                  bool enable_vsync,
                                  bool fullscreen) {
-  XVisualInfo visualTemplate;
-  visualTemplate.visualid = visual_id;
-
-  int visualsCount;
-  auto* visual =
-      XGetVisualInfo(display, VisualIDMask, &visualTemplate, &visualsCount);
-  if (!visual) {
+  uint8_t depth = 0;
+  for (auto depth_iter = xcb_screen_allowed_depths_iterator(screen);
+       depth_iter.rem && !depth; xcb_depth_next(&depth_iter)) {
+    for (auto visual_iter = xcb_depth_visuals_iterator(depth_iter.data);
+         visual_iter.rem; xcb_visualtype_next(&visual_iter)) {
+      if (visual_iter.data->visual_id == visual_id) {
+        depth = depth_iter.data->depth;
+        break;
+      }
+    }
+  }
+  if (!depth) {
     ELINUX_LOG(ERROR) << "Failed to get Visual info.";
     return;
   }
 
-  XSetWindowAttributes windowAttribs;
-  windowAttribs.colormap = XCreateColormap(
-      display, RootWindow(display, visual->screen), visual->visual, AllocNone);
-  windowAttribs.border_pixel = 0;
-  windowAttribs.event_mask =
-      ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask |
-      ButtonReleaseMask | PointerMotionMask | EnterWindowMask |
-      LeaveWindowMask | FocusChangeMask | StructureNotifyMask;
+  auto colormap = xcb_generate_id(connection);
+  xcb_create_colormap(connection, XCB_COLORMAP_ALLOC_NONE, colormap,
+                      screen->root, visual_id);
+
+  // The values must be in the order of the bits of the value mask.
+  const uint32_t value_mask =
+      XCB_CW_BORDER_PIXEL | XCB_CW_EVENT_MASK | XCB_CW_COLORMAP;
+  const uint32_t values[] = {
+      0,
+      XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_KEY_PRESS |
+          XCB_EVENT_MASK_KEY_RELEASE | XCB_EVENT_MASK_BUTTON_PRESS |
+          XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_POINTER_MOTION |
+          XCB_EVENT_MASK_ENTER_WINDOW | XCB_EVENT_MASK_LEAVE_WINDOW |
+          XCB_EVENT_MASK_FOCUS_CHANGE | XCB_EVENT_MASK_STRUCTURE_NOTIFY,
+      colormap,
+  };
 
   auto window_width = width;
   auto window_height = height;
   if (fullscreen) {
-    XWindowAttributes attr;
-    XGetWindowAttributes(display, RootWindow(display, visual->screen), &attr);
-    window_width = attr.width;
-    window_height = attr.height;
-    windowAttribs.override_redirect = True;
+    window_width = screen->width_in_pixels;
+    window_height = screen->height_in_pixels;
   }
 
-  window_ = XCreateWindow(
-      display, RootWindow(display, visual->screen), 0, 0, window_width,
-      window_height, 0, visual->depth, InputOutput, visual->visual,
-      CWBorderPixel | CWColormap | CWEventMask, &windowAttribs);
-  if (!window_) {
+  auto window = xcb_generate_id(connection);
+  auto error = xcb_request_check(
+      connection,
+      xcb_create_window_checked(connection, depth, window, screen->root, 0, 0,
+                                window_width, window_height, 0,
+                                XCB_WINDOW_CLASS_INPUT_OUTPUT, visual_id,
+                                value_mask, values));
+  xcb_free_colormap(connection, colormap);
+  if (error) {
     ELINUX_LOG(ERROR) << "Failed to the create window.";
+    free(error);
     return;
   }
+  window_ = window;
 
   // Receive only WM_DELETE_WINDOW message in the ClientMessage.
-  auto wm_delete_window = XInternAtom(display, kWmDeleteWindow, false);
-  XSetWMProtocols(display, window_, &wm_delete_window, 1);
+  auto wm_protocols = InternAtom(connection, kWmProtocols);
+  auto wm_delete_window = InternAtom(connection, kWmDeleteWindow);
+  xcb_change_property(connection, XCB_PROP_MODE_REPLACE, window, wm_protocols,
+                      XCB_ATOM_ATOM, 32, 1, &wm_delete_window);
 
   // Set the window title.
-  {
-    XTextProperty property;
-    property.value = reinterpret_cast<unsigned char*>(const_cast<char*>(title));
-    property.encoding = XA_STRING;
-    property.format = 8;
-    property.nitems = std::strlen(title);
-    XSetWMName(display, window_, &property);
-  }
+  xcb_change_property(connection, XCB_PROP_MODE_REPLACE, window,
+                      XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8, std::strlen(title),
+                      title);
 
-  XMapWindow(display, window_);
+  xcb_map_window(connection, window);
+  xcb_flush(connection);
 
   enable_vsync_ = enable_vsync;
   width_ = width;
@@ -92,9 +117,11 @@ bool NativeWindowX11::Resize(const size_t width, const size_t height) {
   return true;
 }
 
-void NativeWindowX11::Destroy(Display* display) {
-  if (window_) {
-    XDestroyWindow(display, window_);
+void NativeWindowX11::Destroy(xcb_connection_t* connection) {
+  if (window_ && !destroyed_) {
+    xcb_destroy_window(connection, window_);
+    xcb_flush(connection);
+    destroyed_ = true;
   }
 }
 
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_X11_H_
 
 #include <X11/Xlib.h>
+#include <xcb/xcb.h>
 
 #include "flutter/shell/platform/linux_embedded/window/native_window.h"
 
@@ -13,8 +14,9 @@ namespace flutter {
 
 class NativeWindowX11 : public NativeWindow {
  public:
-  NativeWindowX11(Display* display,
-                  VisualID visual_id,
+  NativeWindowX11(xcb_connection_t* connection,
+                  xcb_screen_t* screen,
+                  xcb_visualid_t visual_id,
                   const char* title,
                   const size_t width,
                   const size_t height,
@@ -25,9 +27,11 @@ class NativeWindowX11 : public NativeWindow {
   // |NativeWindow|
   bool Resize(const size_t width, const size_t height) override;
 
-  void Destroy(Display* display);
+  // Destroys the window unless it's already destroyed.
+  void Destroy(xcb_connection_t* connection);
 
  private:
+  bool destroyed_ = false;
 };
 
 }  // namespace flutter
@@ -0,0 +1,223 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_x11_shm.h"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+constexpr int32_t kBytesPerPixel = 4;
+
+// Size of the PutImage request without the image data.
+constexpr size_t kPutImageRequestSize = 24;
+}  // namespace
+
+NativeWindowX11Shm::NativeWindowX11Shm(xcb_connection_t* connection,
+                                       xcb_screen_t* screen,
+                                       const char* title,
+                                       const size_t width,
+                                       const size_t height,
+                                       bool enable_vsync,
+                                       bool fullscreen)
+    : NativeWindowX11(connection, screen, screen->root_visual, title, width,
+                      height, enable_vsync, fullscreen),
+      connection_(connection),
+      depth_(screen->root_depth) {
+  if (!valid_) {
+    return;
+  }
+
+  // Flutter renders kN32_SkColorType, i.e. BGRA in memory on little-endian
+  // devices, which matches the 32-bit pixels of the usual TrueColor visuals.
+  if (depth_ != 24 && depth_ != 32) {
+    ELINUX_LOG(ERROR) << "The root visual isn't supported (depth " << +depth_
+                      << ").";
+    valid_ = false;
+    return;
+  }
+
+  gc_ = xcb_generate_id(connection_);
+  xcb_create_gc(connection_, gc_, window_, 0, nullptr);
+
+  auto shm = xcb_get_extension_data(connection_, &xcb_shm_id);
+  if (shm && shm->present) {
+    auto reply = xcb_shm_query_version_reply(
+        connection_, xcb_shm_query_version(connection_), nullptr);
+    if (reply) {
+      shm_available_ = true;
+      free(reply);
+    }
+  }
+  if (!shm_available_) {
+    ELINUX_LOG(WARNING) << "The MIT-SHM extension isn't supported. The frames "
+                           "are sent with PutImage.";
+  }
+}
+
+NativeWindowX11Shm::~NativeWindowX11Shm() {
+  for (auto& buffer : buffers_) {
+    DestroyShmBuffer(buffer);
+  }
+  if (gc_) {
+    xcb_free_gc(connection_, gc_);
+    xcb_flush(connection_);
+  }
+}
+
+bool NativeWindowX11Shm::Resize(const size_t width, const size_t height) {
+  // The buffers are reallocated on the raster thread before they are reused.
+  std::lock_guard<std::mutex> lock(mutex_);
+  width_ = width;
+  height_ = height;
+  return true;
+}
+
+NativeWindow::SoftwareBuffer* NativeWindowX11Shm::AcquireSoftwareBuffer() {
+  auto& buffer = buffers_[back_buffer_];
+
+  // Wait until the X server has finished reading the buffer.
+  if (buffer.pending_request) {
+    auto error = xcb_request_check(connection_, *buffer.pending_request);
+    buffer.pending_request.reset();
+    if (error) {
+      ELINUX_LOG(ERROR) << "Failed to put the image. (" << +error->error_code
+                        << ")";
+      free(error);
+    }
+  }
+
+  int32_t width;
+  int32_t height;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    width = width_;
+    height = height_;
+  }
+  if (buffer.buffer.width != width || buffer.buffer.height != height) {
+    DestroyShmBuffer(buffer);
+    if (!CreateShmBuffer(buffer, width, height)) {
+      return nullptr;
+    }
+  }
+  return &buffer.buffer;
+}
+
+bool NativeWindowX11Shm::PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                                               const FlutterRect& damage) {
+  auto& shm_buffer = buffers_[back_buffer_];
+  if (buffer != &shm_buffer.buffer) {
+    return false;
+  }
+
+  const int32_t top = std::max<int32_t>(damage.top, 0);
+  const int32_t bottom = std::min<int32_t>(damage.bottom, buffer->height);
+  if (bottom <= top) {
+    // Nothing has changed.
+    return true;
+  }
+
+  if (shm_available_) {
+    shm_buffer.pending_request = xcb_shm_put_image_checked(
+        connection_, window_, gc_, buffer->width, buffer->height, 0, top,
+        buffer->width, bottom - top, 0, top, depth_, XCB_IMAGE_FORMAT_Z_PIXMAP,
+        0, shm_buffer.shm_seg, 0);
+  } else {
+    // Split the rows into requests which fit the maximum request length.
+    const size_t max_request_bytes =
+        xcb_get_maximum_request_length(connection_) * 4;
+    const int32_t max_rows = std::max<int32_t>(
+        (max_request_bytes - kPutImageRequestSize) / buffer->stride, 1);
+    for (int32_t y = top; y < bottom; y += max_rows) {
+      const int32_t rows = std::min(max_rows, bottom - y);
+      xcb_put_image(connection_, XCB_IMAGE_FORMAT_Z_PIXMAP, window_, gc_,
+                    buffer->width, rows, 0, y, 0, depth_,
+                    rows * buffer->stride, buffer->pixels + y * buffer->stride);
+    }
+  }
+  xcb_flush(connection_);
+
+  back_buffer_ = (back_buffer_ + 1) % buffers_.size();
+  return true;
+}
+
+bool NativeWindowX11Shm::CreateShmBuffer(ShmBuffer& buffer,
+                                         int32_t width,
+                                         int32_t height) {
+  const size_t stride = width * kBytesPerPixel;
+  const size_t size = stride * height;
+
+  void* pixels = nullptr;
+  if (shm_available_) {
+    buffer.shm_id = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if (buffer.shm_id == -1) {
+      ELINUX_LOG(ERROR) << "Failed to create a shared memory segment.";
+      return false;
+    }
+    pixels = shmat(buffer.shm_id, nullptr, 0);
+    if (pixels == reinterpret_cast<void*>(-1)) {
+      ELINUX_LOG(ERROR) << "Failed to attach a shared memory segment.";
+      shmctl(buffer.shm_id, IPC_RMID, nullptr);
+      buffer.shm_id = -1;
+      return false;
+    }
+
+    buffer.shm_seg = xcb_generate_id(connection_);
+    auto error = xcb_request_check(
+        connection_, xcb_shm_attach_checked(connection_, buffer.shm_seg,
+                                            buffer.shm_id, true));
+    // The segment is destroyed once both of us have detached it.
+    shmctl(buffer.shm_id, IPC_RMID, nullptr);
+    if (error) {
+      ELINUX_LOG(ERROR) << "The X server failed to attach a shared memory "
+                           "segment.";
+      free(error);
+      shmdt(pixels);
+      buffer = ShmBuffer();
+      return false;
+    }
+  } else {
+    pixels = std::calloc(size, 1);
+    if (!pixels) {
+      ELINUX_LOG(ERROR) << "Failed to allocate a buffer.";
+      return false;
+    }
+  }
+
+  buffer.size = size;
+  buffer.buffer.pixels = static_cast<uint8_t*>(pixels);
+  buffer.buffer.stride = stride;
+  buffer.buffer.width = width;
+  buffer.buffer.height = height;
+  buffer.buffer.frame_number = 0;
+  return true;
+}
+
+void NativeWindowX11Shm::DestroyShmBuffer(ShmBuffer& buffer) {
+  if (buffer.pending_request) {
+    auto error = xcb_request_check(connection_, *buffer.pending_request);
+    free(error);
+  }
+  if (buffer.shm_seg) {
+    xcb_shm_detach(connection_, buffer.shm_seg);
+    xcb_flush(connection_);
+  }
+  if (buffer.buffer.pixels) {
+    if (buffer.shm_id != -1) {
+      shmdt(buffer.buffer.pixels);
+    } else {
+      std::free(buffer.buffer.pixels);
+    }
+  }
+  buffer = ShmBuffer();
+}
+
+}  // namespace flutter
@@ -0,0 +1,77 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_X11_SHM_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_X11_SHM_H_
+
+#include <xcb/shm.h>
+#include <xcb/xcb.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_x11.h"
+
+namespace flutter {
+
+// An X11 window for the software renderer, which presents the frames with the
+// MIT-SHM extension (or with PutImage if it isn't available) and doesn't need
+// a GPU.
+//
+// The frames are copied into two buffers in turn. Only the rows which have
+// changed are copied and sent to the X server.
+class NativeWindowX11Shm : public NativeWindowX11 {
+ public:
+  NativeWindowX11Shm(xcb_connection_t* connection,
+                     xcb_screen_t* screen,
+                     const char* title,
+                     const size_t width,
+                     const size_t height,
+                     bool enable_vsync,
+                     bool fullscreen);
+  ~NativeWindowX11Shm();
+
+  // |NativeWindow|
+  bool Resize(const size_t width, const size_t height) override;
+
+  // |NativeWindow|
+  SoftwareBuffer* AcquireSoftwareBuffer() override;
+
+  // |NativeWindow|
+  bool PresentSoftwareBuffer(SoftwareBuffer* buffer,
+                             const FlutterRect& damage) override;
+
+ private:
+  struct ShmBuffer {
+    SoftwareBuffer buffer;
+    size_t size = 0;
+    // Shared memory segment, or 0 if the buffer is in the client memory.
+    int shm_id = -1;
+    xcb_shm_seg_t shm_seg = 0;
+    // The last request reading the buffer. The X server has finished reading
+    // once it's checked.
+    std::optional<xcb_void_cookie_t> pending_request;
+  };
+
+  bool CreateShmBuffer(ShmBuffer& buffer, int32_t width, int32_t height);
+
+  void DestroyShmBuffer(ShmBuffer& buffer);
+
+  xcb_connection_t* connection_;
+  uint8_t depth_;
+  xcb_gcontext_t gc_ = 0;
+  bool shm_available_ = false;
+
+  std::array<ShmBuffer, 2> buffers_;
+  size_t back_buffer_ = 0;
+
+  // Guards the size requested by Resize() on the platform thread.
+  std::mutex mutex_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_X11_SHM_H_
@@ -0,0 +1,42 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_x11_vulkan.h"
+
+#include <vulkan/vulkan_xcb.h>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+NativeWindowX11Vulkan::NativeWindowX11Vulkan(xcb_connection_t* connection,
+                                             xcb_screen_t* screen,
+                                             const char* title,
+                                             const size_t width,
+                                             const size_t height,
+                                             bool enable_vsync,
+                                             bool fullscreen)
+    : NativeWindowX11(connection, screen, screen->root_visual, title, width,
+                      height, enable_vsync, fullscreen),
+      connection_(connection) {}
+
+VkSurfaceKHR NativeWindowX11Vulkan::CreateVulkanSurface(
+    VkInstance instance,
+    VkPhysicalDevice physical_device) {
+  VkXcbSurfaceCreateInfoKHR create_info = {};
+  create_info.sType = VK_STRUCTURE_TYPE_XCB_SURFACE_CREATE_INFO_KHR;
+  create_info.connection = connection_;
+  create_info.window = static_cast<xcb_window_t>(window_);
+
+  VkSurfaceKHR surface = VK_NULL_HANDLE;
+  auto result =
+      vkCreateXcbSurfaceKHR(instance, &create_info, nullptr, &surface);
+  if (result != VK_SUCCESS) {
+    ELINUX_LOG(ERROR) << "Failed to create the Vulkan surface: " << result;
+    return VK_NULL_HANDLE;
+  }
+  return surface;
+}
+
+}  // namespace flutter
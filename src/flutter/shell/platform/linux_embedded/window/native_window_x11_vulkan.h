@@ -0,0 +1,37 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_X11_VULKAN_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_X11_VULKAN_H_
+
+#include <xcb/xcb.h>
+
+#include "flutter/shell/platform/linux_embedded/window/native_window_x11.h"
+
+namespace flutter {
+
+// An X11 window for the Vulkan renderer, which presents the frames with a
+// Vulkan swapchain (VK_KHR_xcb_surface).
+class NativeWindowX11Vulkan : public NativeWindowX11 {
+ public:
+  NativeWindowX11Vulkan(xcb_connection_t* connection,
+                        xcb_screen_t* screen,
+                        const char* title,
+                        const size_t width,
+                        const size_t height,
+                        bool enable_vsync,
+                        bool fullscreen);
+  ~NativeWindowX11Vulkan() = default;
+
+  // |NativeWindow|
+  VkSurfaceKHR CreateVulkanSurface(VkInstance instance,
+                                   VkPhysicalDevice physical_device) override;
+
+ private:
+  xcb_connection_t* connection_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_NATIVE_WINDOW_X11_VULKAN_H_
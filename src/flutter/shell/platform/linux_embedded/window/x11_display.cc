@@ -0,0 +1,162 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/platform/linux_embedded/window/x11_display.h"
+
+#include <X11/Xlib-xcb.h>
+#include <xcb/present.h>
+
+#include <cstdlib>
+
+#include "flutter/shell/platform/linux_embedded/logger.h"
+
+namespace flutter {
+
+namespace {
+std::mutex g_display_mutex;
+std::weak_ptr<X11Display> g_display;
+}  // namespace
+
+std::shared_ptr<X11Display> X11Display::Get() {
+  std::lock_guard<std::mutex> lock(g_display_mutex);
+  auto display = g_display.lock();
+  if (display) {
+    return display;
+  }
+
+  display.reset(new X11Display());
+  if (!display->Open()) {
+    return nullptr;
+  }
+  g_display = display;
+  return display;
+}
+
+X11Display::~X11Display() {
+  for (auto& [window, events] : events_) {
+    for (auto* event : events) {
+      free(event);
+    }
+  }
+  if (display_) {
+    XSetCloseDownMode(display_, DestroyAll);
+    XCloseDisplay(display_);
+  }
+}
+
+bool X11Display::Open() {
+  // The windows and EGL use the display on the platform thread and the raster
+  // thread.
+  static const bool threads_initialized = XInitThreads();
+  if (!threads_initialized) {
+    ELINUX_LOG(WARNING) << "Failed to initialize the Xlib threads.";
+  }
+
+  display_ = XOpenDisplay(NULL);
+  if (!display_) {
+    ELINUX_LOG(ERROR) << "Failed to open display.";
+    return false;
+  }
+  connection_ = XGetXCBConnection(display_);
+  XSetEventQueueOwner(display_, XCBOwnsEventQueue);
+
+  auto screen_iter = xcb_setup_roots_iterator(xcb_get_setup(connection_));
+  for (auto i = DefaultScreen(display_); i > 0 && screen_iter.rem; i--) {
+    xcb_screen_next(&screen_iter);
+  }
+  screen_ = screen_iter.data;
+
+  auto present = xcb_get_extension_data(connection_, &xcb_present_id);
+  if (present && present->present) {
+    present_opcode_ = present->major_opcode;
+  }
+  return true;
+}
+
+void X11Display::AddWindow(xcb_window_t window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_[window];
+}
+
+xcb_generic_event_t* X11Display::PollForEvent(xcb_window_t window,
+                                              bool queued_only) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = events_.find(window);
+  if (it != events_.end() && !it->second.empty()) {
+    auto* event = it->second.front();
+    it->second.pop_front();
+    return event;
+  }
+
+  while (auto* event = queued_only ? xcb_poll_for_queued_event(connection_)
+                                   : xcb_poll_for_event(connection_)) {
+    const auto event_window = GetEventWindow(event);
+    if (event_window == window && window != XCB_WINDOW_NONE) {
+      return event;
+    }
+    auto other = events_.find(event_window);
+    if (other != events_.end()) {
+      other->second.push_back(event);
+    } else {
+      free(event);
+    }
+  }
+  return nullptr;
+}
+
+void X11Display::RemoveWindow(xcb_window_t window) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = events_.find(window);
+  if (it == events_.end()) {
+    return;
+  }
+  for (auto* event : it->second) {
+    free(event);
+  }
+  events_.erase(it);
+}
+
+xcb_window_t X11Display::GetEventWindow(
+    const xcb_generic_event_t* event) const {
+  switch (event->response_type & ~0x80) {
+    case XCB_KEY_PRESS:
+    case XCB_KEY_RELEASE:
+    case XCB_BUTTON_PRESS:
+    case XCB_BUTTON_RELEASE:
+    case XCB_MOTION_NOTIFY:
+    case XCB_ENTER_NOTIFY:
+    case XCB_LEAVE_NOTIFY:
+      // The input events share the layout of KeyPress.
+      return reinterpret_cast<const xcb_key_press_event_t*>(event)->event;
+    case XCB_CONFIGURE_NOTIFY:
+      return reinterpret_cast<const xcb_configure_notify_event_t*>(event)
+          ->window;
+    case XCB_DESTROY_NOTIFY:
+      return reinterpret_cast<const xcb_destroy_notify_event_t*>(event)
+          ->window;
+    case XCB_CLIENT_MESSAGE:
+      return reinterpret_cast<const xcb_client_message_event_t*>(event)
+          ->window;
+    case XCB_SELECTION_NOTIFY:
+      return reinterpret_cast<const xcb_selection_notify_event_t*>(event)
+          ->requestor;
+    case XCB_SELECTION_REQUEST:
+      return reinterpret_cast<const xcb_selection_request_event_t*>(event)
+          ->owner;
+    case XCB_GE_GENERIC: {
+      auto* generic = reinterpret_cast<const xcb_ge_generic_event_t*>(event);
+      if (present_opcode_ && generic->extension == present_opcode_ &&
+          generic->event_type == XCB_PRESENT_EVENT_COMPLETE_NOTIFY) {
+        return reinterpret_cast<const xcb_present_complete_notify_event_t*>(
+                   event)
+            ->window;
+      }
+      return XCB_WINDOW_NONE;
+    }
+    default:
+      return XCB_WINDOW_NONE;
+  }
+}
+
+}  // namespace flutter
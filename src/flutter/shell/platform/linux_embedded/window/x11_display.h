@@ -0,0 +1,83 @@
+// Copyright 2023 Sony Corporation. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_X11_DISPLAY_H_
+#define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_X11_DISPLAY_H_
+
+#include <X11/Xlib.h>
+#include <xcb/xcb.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace flutter {
+
+// The connection to the X server shared by the windows of the process.
+//
+// EGL displays are per native display, so the windows must share the
+// connection for their contexts to join one share group (see EglShareGroup).
+// The events read from the connection are queued for the window they're
+// delivered to, which dispatches them from its own queue.
+//
+// All the functions are thread-safe.
+class X11Display {
+ public:
+  // Returns the connection of the process, which is opened by the first
+  // window and closed when the last one releases it. Returns a null pointer
+  // if the display can't be opened.
+  static std::shared_ptr<X11Display> Get();
+
+  ~X11Display();
+
+  // Prevent copying.
+  X11Display(X11Display const&) = delete;
+  X11Display& operator=(X11Display const&) = delete;
+
+  // The Xlib display is only used for EGL. The events are handled with XCB,
+  // which owns the event queue of the connection.
+  Display* display() const { return display_; }
+  xcb_connection_t* connection() const { return connection_; }
+  xcb_screen_t* screen() const { return screen_; }
+
+  // Starts queuing the events delivered to |window|.
+  void AddWindow(xcb_window_t window);
+
+  // Returns the next event of |window|, or nullptr if there's none. The caller
+  // must free the event. The events of the other added windows read meanwhile
+  // are queued for them, and the others are discarded. If |queued_only|, only
+  // the events already read from the connection (e.g. by EGL on another
+  // thread) are returned, and the socket isn't read.
+  xcb_generic_event_t* PollForEvent(xcb_window_t window, bool queued_only);
+
+  // Stops queuing the events delivered to |window|, which is destroyed, and
+  // discards those already queued.
+  void RemoveWindow(xcb_window_t window);
+
+ private:
+  X11Display() = default;
+
+  // Opens the connection. Returns false if the display can't be opened.
+  bool Open();
+
+  // Returns the window |event| is delivered to, or XCB_WINDOW_NONE if it's
+  // not of a window.
+  xcb_window_t GetEventWindow(const xcb_generic_event_t* event) const;
+
+  Display* display_ = nullptr;
+  xcb_connection_t* connection_ = nullptr;
+  xcb_screen_t* screen_ = nullptr;
+
+  // The major opcode of the Present extension, whose events are generic
+  // events, or 0 if it isn't supported.
+  uint8_t present_opcode_ = 0;
+
+  std::mutex mutex_;
+  std::unordered_map<xcb_window_t, std::deque<xcb_generic_event_t*>> events_;
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_X11_DISPLAY_H_
@@ -5,11 +5,16 @@
 #ifndef FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_BINDING_HANDLER_H_
 #define FLUTTER_SHELL_PLATFORM_LINUX_EMBEDDED_WINDOW_BINDING_HANDLER_H_
 
+#include <functional>
 #include <string>
 #include <variant>
 
 #include "flutter/shell/platform/linux_embedded/public/flutter_elinux.h"
 #include "flutter/shell/platform/linux_embedded/surface/surface_gl.h"
+#include "flutter/shell/platform/linux_embedded/surface/surface_software.h"
+#if defined(ENABLE_VULKAN)
+#include "flutter/shell/platform/linux_embedded/surface/surface_vulkan.h"
+#endif
 #include "flutter/shell/platform/linux_embedded/window_binding_handler_delegate.h"
 
 namespace flutter {
@@ -27,12 +32,31 @@ using ELinuxRenderSurfaceTarget = SurfaceGl;
 // Abstract class for binding Linux embedded platform windows to Flutter views.
 class WindowBindingHandler {
  public:
+  using ClipboardCallback = std::function<void(const std::string& data)>;
+
   virtual ~WindowBindingHandler() = default;
 
   // Dispatches window events such as mouse and keyboard inputs. For Wayland,
   // you have to call this every time in the main loop.
   virtual bool DispatchEvent() = 0;
 
+  // Returns a file descriptor which becomes readable when there are events to
+  // be dispatched by DispatchEvent(), or -1 if the backend has none.
+  virtual int GetEventFd() const { return -1; }
+
+  // Returns true if events were already read from the event fd, e.g. by
+  // another thread sharing the display connection. They don't make the fd
+  // readable, so DispatchEvent() has to be called before polling it.
+  virtual bool HasPendingEvents() { return false; }
+
+  // Returns true if the window calls WindowBindingHandlerDelegate::OnVsync()
+  // at the next vblank after each RequestVsync().
+  virtual bool IsVsyncRequestSupported() const { return false; }
+
+  // Requests a WindowBindingHandlerDelegate::OnVsync() at the next vblank.
+  // Can be called on any thread.
+  virtual void RequestVsync() {}
+
   // Create a surface.
   // @param[in] width_px         Physical width of the surface.
   // @param[in] height_px        Physical height of the surface.
@@ -48,6 +72,16 @@ class WindowBindingHandler {
   // window.
   virtual ELinuxRenderSurfaceTarget* GetRenderSurfaceTarget() const = 0;
 
+  // Returns the surface presenting the frames of the software renderer, or
+  // nullptr if the window renders with OpenGL ES.
+  virtual SurfaceSoftware* GetSoftwareSurfaceTarget() const { return nullptr; }
+
+#if defined(ENABLE_VULKAN)
+  // Returns the surface presenting the frames of the Vulkan renderer, or
+  // nullptr if the window renders with another renderer.
+  virtual SurfaceVulkan* GetVulkanSurfaceTarget() const { return nullptr; }
+#endif
+
   // Sets the delegate used to communicate state changes from window to view
   // such as key presses, mouse position updates etc.
   virtual void SetView(WindowBindingHandlerDelegate* view) = 0;
@@ -55,6 +89,10 @@ class WindowBindingHandler {
   // Returns the rotation(degree) for the backing window.
   virtual uint16_t GetRotationDegree() const = 0;
 
+  // Returns true if the display (e.g. a DRM plane or the Wayland compositor)
+  // rotates the frames. Otherwise, the frames are rotated when rendering.
+  virtual bool IsRotationOffloaded() const { return false; }
+
   // Returns the scale factor for the backing window.
   virtual double GetDpiScale() = 0;
 
@@ -72,8 +110,10 @@ class WindowBindingHandler {
   // shown by Flutter events.
   virtual void UpdateVirtualKeyboardStatus(const bool show) = 0;
 
-  // Returns the clipboard data.
-  virtual std::string GetClipboardData() = 0;
+  // Reads the clipboard data. |callback| is called with the data on the
+  // platform thread, either before returning or later from DispatchEvent()
+  // when the data has to be transferred from another client.
+  virtual void GetClipboardData(ClipboardCallback callback) = 0;
 
   // Sets the clipboard data.
   virtual void SetClipboardData(const std::string& data) = 0;
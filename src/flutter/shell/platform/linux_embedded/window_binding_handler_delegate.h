@@ -100,6 +100,11 @@ class WindowBindingHandlerDelegate {
                         double delta_y,
                         int scroll_offset_multiplier) = 0;
 
+  // Notifies delegate that backing window has been hidden (e.g. minimized or
+  // fully occluded) or shown again. Typically called by currently configured
+  // WindowBindingHandler
+  virtual void OnWindowVisibilityChanged(bool visible) = 0;
+
   // Notifies delegate that backing window vsync has happened.
   // Typically called by currently configured WindowBindingHandler
   virtual void OnVsync(uint64_t last_frame_time_nanos,